@@ -52,10 +52,15 @@ int main()
 
 #include "reducers/reducers_common.h"
 #include "reducers/reduce.h"
+#include "reducers/fold.h"
+#include "reducers/fold_async.h"
+#include "reducers/reduced.h"
 
 #include "reducers/transformers/collect.h"
 #include "reducers/transformers/filter.h"
 #include "reducers/transformers/map.h"
+#include "reducers/transformers/take.h"
+#include "reducers/transformers/take_while.h"
 
 #include "reducers/into.h"
 
@@ -65,5 +70,11 @@ int main()
 
 #include "reducers/monoid/monoid.h"
 #include "reducers/monoid/monoid_reduce.h"
+#include "reducers/monoid/monoid_fold.h"
+
+#include "reducers/executors/thread_pool.h"
+#include "reducers/executors/inline_executor.h"
+#include "reducers/executors/submit_executor.h"
+#include "reducers/executors/partitioners.h"
 
 #endif // WENDA_REDUCERS_H_INCLUDED
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef WENDA_REDUCERS_DETAIL_ACCUMULATE_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_ACCUMULATE_H_INCLUDED
+
+/**
+* @file accumulate.h
+* This file implements the detection of in-place reducing functions.
+* A reducing function is in-place when it takes the seed by reference, mutates it, and returns void,
+* such as [](std::string& s, char c) { s += c; }. Reducibles accumulate into the seed with such functions,
+* so that heavy seeds are neither moved nor copied for every element.
+*/
+
+#include "../reducers_common.h"
+
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Trait to determine whether the given function reduces values of the given type in place,
+    * that is, whether it can be invoked with an l-value seed and a value, and returns void.
+	*/
+	template<typename Function, typename Seed, typename Value>
+	class is_in_place_reducer
+	{
+		template<typename U> static typename std::is_void<decltype(std::declval<U&>()(std::declval<Seed&>(), std::declval<Value>()))>::type test(std::nullptr_t);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<Function>(nullptr)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Accumulates the given value into the seed, either in place, or by assigning the seed the result of the function.
+	*/
+	template<typename Function, typename Seed, typename Value>
+	typename std::enable_if<is_in_place_reducer<Function, Seed, Value&&>::value>::type
+	accumulate_into(Function& function, Seed& seed, Value&& value)
+	{
+		function(seed, std::forward<Value>(value));
+	}
+
+	template<typename Function, typename Seed, typename Value>
+	typename std::enable_if<!is_in_place_reducer<Function, Seed, Value&&>::value>::type
+	accumulate_into(Function& function, Seed& seed, Value&& value)
+	{
+		seed = function(std::move(seed), std::forward<Value>(value));
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_ACCUMULATE_H_INCLUDED
@@ -0,0 +1,381 @@
+#ifndef WENDA_REDUCERS_DETAIL_BLOCK_REDUCE_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_BLOCK_REDUCE_H_INCLUDED
+
+/**
+* @file block_reduce.h
+* This file contains the block protocol, which lets contiguous sources push whole blocks of elements through a chain of transformers.
+* A reducing function supports blocks if it provides a member function reduce_block(seed, first, last),
+* taking a seed and a pair of pointers to the elements, and returning the new seed, which must be the same as reducing
+* the elements one by one. Reducing functions that do not provide it receive the elements one by one.
+* The map() and filter() transformers support blocks when the function they transform does, filter() also supports them
+* when it transforms a built-in operation with a known unit, and the operations of monoids consume blocks when the reduction is over a monoid,
+* with the kernels in simd_reduce.h for the built-in monoids, and with several accumulators otherwise.
+*/
+
+#include "../reducers_common.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "../reduced.h"
+#include "../monoid/monoid.h"
+#include "parallel_reduce.h"
+#include "simd_reduce.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * The number of elements that transformers buffer at a time when they transform a block.
+	*/
+	const std::size_t block_size = 256;
+
+	template<typename Function, typename Seed, typename T>
+	class has_reduce_block_member_function
+	{
+		template<typename U> static std::true_type test(
+			typename std::add_pointer<decltype(std::declval<U const&>().reduce_block(
+			    std::declval<Seed>(),
+			    std::declval<T const*>(),
+			    std::declval<T const*>()))>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<typename std::decay<Function>::type>(nullptr)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Reduces the elements of [first, last) into the given seed, as a block if the function supports it,
+    * and one by one otherwise.
+	*/
+	template<typename Function, typename Seed, typename T>
+	typename std::enable_if<has_reduce_block_member_function<Function, Seed, T>::value, Seed>::type
+	reduce_block(Function const& function, Seed seed, T const* first, T const* last)
+	{
+		return function.reduce_block(std::move(seed), first, last);
+	}
+
+	template<typename Function, typename Seed, typename T>
+	typename std::enable_if<!has_reduce_block_member_function<Function, Seed, T>::value, Seed>::type
+	reduce_block(Function const& function, Seed seed, T const* first, T const* last)
+	{
+		return reduce_iterators(first, last, std::move(seed), function);
+	}
+
+	/**
+    * @internal
+    * Reduces the elements of [first, last) into the given seed.
+    * Pointers delimit contiguous elements, which are reduced as a block if the function supports it.
+	*/
+	template<typename Iterator, typename Seed, typename Function>
+	Seed reduce_elements(Iterator first, Iterator last, Seed seed, Function& function)
+	{
+		return reduce_iterators(std::move(first), std::move(last), std::move(seed), function);
+	}
+
+	template<typename T, typename Seed, typename Function>
+	Seed reduce_pointers(T* first, T* last, Seed seed, Function& function, std::true_type)
+	{
+		return function.reduce_block(std::move(seed), static_cast<T const*>(first), static_cast<T const*>(last));
+	}
+
+	template<typename T, typename Seed, typename Function>
+	Seed reduce_pointers(T* first, T* last, Seed seed, Function& function, std::false_type)
+	{
+		return reduce_iterators(first, last, std::move(seed), function);
+	}
+
+	template<typename T, typename Seed, typename Function>
+	Seed reduce_elements(T* first, T* last, Seed seed, Function& function)
+	{
+		typedef typename has_reduce_block_member_function<Function, Seed, typename std::remove_const<T>::type>::type has_block_t;
+		return reduce_pointers(first, last, std::move(seed), function, has_block_t());
+	}
+
+	/**
+    * @internal
+    * Trait to determine the decayed type returned by a function when it is invoked with a constant element of type T,
+    * which is void if it cannot be invoked that way.
+	*/
+	template<typename Function, typename T>
+	class block_result
+	{
+		template<typename U> static decltype(std::declval<U const&>()(std::declval<T const&>())) test(int);
+		template<typename U> static void test(...);
+	public:
+		typedef typename std::decay<decltype(test<Function>(0))>::type type;
+	};
+
+	/**
+    * @internal
+    * Reduces the elements of [first, last) into the given seed by blocks of at most @ref block_size elements,
+    * where @p transform writes the transformed elements of a piece into a buffer and returns their number.
+    * The blocks are reduced by the given function, and the reduction stops between blocks if it terminates.
+	*/
+	template<typename Buffered, typename T, typename Seed, typename Transform, typename Function>
+	Seed reduce_buffered_blocks(T const* first, T const* last, Seed seed, Transform const& transform, Function const& function)
+	{
+		Buffered buffer[block_size];
+
+		while (first != last)
+		{
+			std::size_t count = (std::min)(block_size, static_cast<std::size_t>(last - first));
+			std::size_t buffered = transform(first, count, buffer);
+			seed = reduce_block(function, std::move(seed), static_cast<Buffered const*>(buffer), static_cast<Buffered const*>(buffer + buffered));
+			first += count;
+
+			if (is_reduced(seed))
+			{
+				break;
+			}
+		}
+
+		return seed;
+	}
+
+	/**
+    * @internal
+    * Wraps the operation of a built-in monoid, so that it consumes blocks of elements with the given kernels in simd_reduce.h.
+    * It is only used for reductions over monoids, as the kernels reorder the operations.
+	*/
+	template<typename Operation, typename Kernels = native_kernels>
+	struct block_operation
+	{
+		typedef typename simd_operation_traits<Operation>::element_t element_t;
+
+		Operation operation;
+
+		element_t operator()(element_t const& left, element_t const& right) const
+		{
+			return operation(left, right);
+		}
+
+		template<typename T>
+		typename std::enable_if<std::is_same<T, element_t>::value, T>::type
+		reduce_block(T seed, T const* first, T const* last) const
+		{
+			return reduce_contiguous(first, last, seed, operation, Kernels());
+		}
+	};
+
+	template<typename Operation, typename Kernels>
+	struct simd_operation_traits<block_operation<Operation, Kernels>>
+		: simd_operation_traits<Operation>
+	{};
+
+	template<typename T, typename Operation, typename Kernels>
+	T reduce_contiguous(T const* first, T const* last, T seed, block_operation<Operation, Kernels> const& op)
+	{
+		return reduce_contiguous(first, last, seed, op.operation, Kernels());
+	}
+
+	/**
+    * @internal
+    * The kernels with which folds on the given executor reduce contiguous blocks.
+    * Folds with a @ref deterministic_partitioner use the portable kernels, so that their results do not depend on the processor.
+	*/
+	template<typename Executor>
+	struct executor_kernels
+	{
+		typedef typename std::conditional<
+			is_deterministic_executor<Executor>::value,
+			portable_kernels,
+			native_kernels
+		>::type type;
+	};
+
+	/**
+    * @internal
+    * The built-in monoid whose operation is the given operation.
+	*/
+	template<typename Operation> struct operation_monoid;
+	template<typename T> struct operation_monoid<std::plus<T>> { typedef additive_monoid<T> type; };
+	template<typename T> struct operation_monoid<min_operation<T>> { typedef min_monoid<T> type; };
+	template<typename T> struct operation_monoid<max_operation<T>> { typedef max_monoid<T> type; };
+	template<typename T> struct operation_monoid<std::bit_and<T>> { typedef bitwise_and_monoid<T> type; };
+	template<typename T> struct operation_monoid<std::bit_or<T>> { typedef bitwise_or_monoid<T> type; };
+	template<typename T> struct operation_monoid<std::bit_xor<T>> { typedef bitwise_xor_monoid<T> type; };
+
+	/**
+    * @internal
+    * Trait to determine whether a reducing function is a built-in operation that may reduce a block where some elements
+    * are masked out, by replacing them with the unit of the operation instead of skipping them.
+    * Plain operations only qualify over integral types, for which the kernels give the exact sequential result,
+    * while the operations wrapped by @ref block_operation qualify for any type, as they already reduce over a monoid.
+    * The masked blocks are reduced by @p block_t.
+	*/
+	template<typename Function>
+	struct masked_operation
+	{
+		typedef Function operation_t;
+		typedef block_operation<Function> block_t;
+		static const bool value =
+			simd_operation_traits<Function>::value &&
+			std::is_integral<typename simd_operation_traits<Function>::element_t>::value;
+	};
+
+	template<typename Operation, typename Kernels>
+	struct masked_operation<block_operation<Operation, Kernels>>
+	{
+		typedef Operation operation_t;
+		typedef block_operation<Operation, Kernels> block_t;
+		static const bool value = simd_operation_traits<Operation>::value;
+	};
+
+	/**
+    * @internal
+    * Returns the unit of the given built-in operation.
+	*/
+	template<typename Operation>
+	typename simd_operation_traits<Operation>::element_t operation_unit()
+	{
+		return monoid_traits<typename operation_monoid<Operation>::type>::unit();
+	}
+
+	/**
+    * @internal
+    * Reduces the elements of the random access range [first, last) into the given seed over a monoid,
+    * with four independent accumulators, which breaks the dependency of every step on the previous one.
+    * The range is split into four quarters that are reduced in the same loop, and whose accumulators are combined in order,
+    * so that this only relies on the associativity of the operation.
+	*/
+	template<typename Iterator, typename T, typename Operation>
+	T reduce_accumulators(Iterator first, Iterator last, T seed, T const& unit, Operation const& op)
+	{
+		typedef typename std::iterator_traits<Iterator>::difference_type difference_t;
+		difference_t quarter = (last - first) / 4;
+
+		if (quarter < 2)
+		{
+			return reduce_iterators(first, last, std::move(seed), op);
+		}
+
+		Iterator first1 = first + quarter;
+		Iterator first2 = first1 + quarter;
+		Iterator first3 = first2 + quarter;
+
+		T acc0 = unit;
+		T acc1 = unit;
+		T acc2 = unit;
+		T acc3 = unit;
+
+		for (difference_t i = 0; i < quarter; ++i)
+		{
+			acc0 = op(std::move(acc0), first[i]);
+			acc1 = op(std::move(acc1), first1[i]);
+			acc2 = op(std::move(acc2), first2[i]);
+			acc3 = op(std::move(acc3), first3[i]);
+		}
+
+		// the last quarter also takes the elements left over by the division.
+		acc3 = reduce_iterators(first3 + quarter, last, std::move(acc3), op);
+
+		return op(std::move(seed), op(op(std::move(acc0), std::move(acc1)), op(std::move(acc2), std::move(acc3))));
+	}
+
+	/**
+    * @internal
+    * Wraps the operation of a monoid that the kernels do not implement, so that it consumes blocks of elements
+    * with its own reduce_block() member function if it has one, and with several accumulators otherwise.
+	*/
+	template<typename Monoid>
+	struct monoid_block_operation
+		: monoid_traits<Monoid>::operation_t
+	{
+		typedef typename monoid_traits<Monoid>::operation_t operation_t;
+		typedef typename monoid_traits<Monoid>::element_t element_t;
+
+		using operation_t::operator();
+
+		template<typename T>
+		element_t reduce_block(element_t seed, T const* first, T const* last) const
+		{
+			typedef typename has_reduce_block_member_function<operation_t, element_t, T>::type has_block_t;
+			return reduce_monoid_block(std::move(seed), first, last, has_block_t());
+		}
+
+	private:
+		template<typename T>
+		element_t reduce_monoid_block(element_t seed, T const* first, T const* last, std::true_type) const
+		{
+			return operation_t::reduce_block(std::move(seed), first, last);
+		}
+
+		template<typename T>
+		element_t reduce_monoid_block(element_t seed, T const* first, T const* last, std::false_type) const
+		{
+			return reduce_accumulators(first, last, std::move(seed), monoid_traits<Monoid>::unit(), static_cast<operation_t const&>(*this));
+		}
+	};
+
+	/**
+    * @internal
+    * The reducing function of @ref kahan_monoid, which adds blocks of values with the given compensated summation kernels.
+	*/
+	template<typename T, typename Kernels = native_kernels>
+	struct kahan_block_operation
+		: monoid_block_operation<kahan_monoid<T>>
+	{
+		using monoid_block_operation<kahan_monoid<T>>::reduce_block;
+
+		kahan_sum<T> reduce_block(kahan_sum<T> seed, T const* first, T const* last) const
+		{
+			return reduce_compensated(first, last, std::move(seed), Kernels());
+		}
+	};
+
+	/**
+    * @internal
+    * The reducing function of @ref pairwise_sum_monoid, which sums blocks of values pairwise with the given kernels.
+	*/
+	template<typename T, typename Kernels = native_kernels>
+	struct pairwise_sum_block_operation
+		: monoid_block_operation<pairwise_sum_monoid<T>>
+	{
+		using monoid_block_operation<pairwise_sum_monoid<T>>::reduce_block;
+
+		T reduce_block(T seed, T const* first, T const* last) const
+		{
+			return seed + pairwise_sum(first, last, Kernels());
+		}
+	};
+
+	/**
+    * @internal
+    * The reducing function used for reductions over the given monoid, which consumes blocks
+    * with the given kernels if the operation of the monoid is one of the built-in operations, and with several accumulators otherwise.
+	*/
+	template<typename Monoid, typename Kernels = native_kernels>
+	struct monoid_operation
+	{
+		typedef typename monoid_traits<Monoid>::operation_t operation_t;
+		typedef typename std::conditional<
+			simd_operation_traits<operation_t>::value,
+			block_operation<operation_t, Kernels>,
+			monoid_block_operation<Monoid>
+		>::type type;
+	};
+
+	template<typename T, typename Kernels>
+	struct monoid_operation<kahan_monoid<T>, Kernels>
+	{
+		typedef kahan_block_operation<T, Kernels> type;
+	};
+
+	template<typename T, typename Kernels>
+	struct monoid_operation<pairwise_sum_monoid<T>, Kernels>
+	{
+		typedef pairwise_sum_block_operation<T, Kernels> type;
+	};
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_BLOCK_REDUCE_H_INCLUDED
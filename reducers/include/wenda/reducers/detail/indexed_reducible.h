@@ -0,0 +1,59 @@
+#ifndef WENDA_REDUCERS_DETAIL_INDEXED_REDUCIBLE_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_INDEXED_REDUCIBLE_H_INCLUDED
+
+/**
+* @file indexed_reducible.h
+* This file contains the @ref detail::indexed_reducible trait, which gives access to the elements of reducibles
+* that can compute their i-th element directly, such as random access ranges.
+* Reducibles and transformers specialize it, so that they can be materialized in parallel by index.
+*/
+
+#include "../reducers_common.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "is_range.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Trait to access the elements of a reducible by index.
+    * Specializations for which value is true provide the type element_t of the elements, and static member functions
+    * size(reducible), which returns the number of elements, and at(reducible, index), which returns the element at the given index.
+	*/
+	template<typename Reducible, typename Enable = void>
+	struct indexed_reducible
+	{
+		static const bool value = false;
+	};
+
+	template<typename Range>
+	struct indexed_reducible<Range, typename std::enable_if<is_random_access_range<Range>::value>::type>
+	{
+		typedef decltype(std::begin(std::declval<Range const&>())) iterator_t;
+		typedef typename std::iterator_traits<iterator_t>::difference_type difference_t;
+		typedef typename std::iterator_traits<iterator_t>::reference element_t;
+
+		static const bool value = true;
+
+		static std::size_t size(Range const& range)
+		{
+			return static_cast<std::size_t>(std::distance(std::begin(range), std::end(range)));
+		}
+
+		static element_t at(Range const& range, std::size_t index)
+		{
+			return std::begin(range)[static_cast<difference_t>(index)];
+		}
+	};
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_INDEXED_REDUCIBLE_H_INCLUDED
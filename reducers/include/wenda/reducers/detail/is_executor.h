@@ -0,0 +1,44 @@
+#ifndef WENDA_REDUCERS_DETAIL_IS_EXECUTOR_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_IS_EXECUTOR_H_INCLUDED
+
+/**
+* @file is_executor.h
+* This file contains a trait type @ref is_executor to determine whether a type models the executor concept.
+* An executor is an object on which folds are run. It must provide:
+* - a member function concurrency(), returning the number of threads the executor can use;
+* - a member function run(f), which invokes the nullary function f on the executor and waits for it to complete;
+* - a member function invoke(left, right), which invokes the two nullary functions left and right,
+*   potentially in parallel, and returns once both have completed.
+*/
+
+#include "../reducers_common.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	template<typename T>
+	class is_executor
+	{
+		typedef void(*nullary_t)();
+
+		template<typename U> static std::true_type test(
+			typename std::enable_if<
+			    std::is_convertible<decltype(std::declval<U&>().concurrency()), std::size_t>::value,
+			    decltype(std::declval<U&>().invoke(std::declval<nullary_t>(), std::declval<nullary_t>()))*
+			>::type,
+			decltype(std::declval<U&>().run(std::declval<nullary_t>()))*);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<typename std::remove_reference<T>::type>(nullptr, nullptr)) type;
+		static const bool value = type::value;
+	};
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_IS_EXECUTOR_H_INCLUDED
@@ -9,6 +9,11 @@
 
 #include "../reducers_common.h"
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
 namespace detail
@@ -42,6 +47,80 @@ namespace detail
 		typedef decltype(test<T>(0)) type;
 		static const bool value = type::value;
 	};
+
+	/**
+    * @internal
+    * Trait to determine whether a range stores its elements contiguously, so that it can be reduced through a pointer.
+    * This is the case for arrays, and for ranges that provide data() and size() member functions, such as std::vector.
+	*/
+	template<typename T>
+	class is_contiguous_range
+	{
+		template<typename U> static std::true_type test(
+			typename std::enable_if<
+			    std::is_pointer<decltype(std::declval<U&>().data())>::value &&
+			    std::is_convertible<decltype(std::declval<U&>().size()), std::size_t>::value,
+			    int
+			>::type);
+		template<typename U> static std::true_type test(
+			typename std::enable_if<std::extent<U>::value != 0, long>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<typename std::remove_reference<T>::type>(0)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Trait to determine whether a range has random access iterators, such as std::vector, std::deque or arrays.
+	*/
+	template<typename T>
+	class is_random_access_range
+	{
+		template<typename U> static std::true_type test(
+			typename std::enable_if<
+			    std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<decltype(begin(std::declval<U&>()))>::iterator_category>::value,
+			    int
+			>::type);
+		template<typename U> static std::true_type test(
+			typename std::enable_if<std::extent<U>::value != 0, long>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<typename std::remove_reference<T>::type>(0)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Returns a pointer to the first element of a contiguous range.
+	*/
+	template<typename Range>
+	auto contiguous_data(Range& range) -> decltype(range.data())
+	{
+		return range.data();
+	}
+
+	template<typename T, std::size_t N>
+	T* contiguous_data(T(&range)[N])
+	{
+		return range;
+	}
+
+	/**
+    * @internal
+    * Returns the number of elements of a contiguous range.
+	*/
+	template<typename Range>
+	std::size_t contiguous_size(Range& range)
+	{
+		return static_cast<std::size_t>(range.size());
+	}
+
+	template<typename T, std::size_t N>
+	std::size_t contiguous_size(T(&)[N])
+	{
+		return N;
+	}
 }
 
 WENDA_REDUCERS_NAMESPACE_END
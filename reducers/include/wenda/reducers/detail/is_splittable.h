@@ -0,0 +1,101 @@
+#ifndef WENDA_REDUCERS_DETAIL_IS_SPLITTABLE_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_IS_SPLITTABLE_H_INCLUDED
+
+/**
+* @file is_splittable.h
+* This file contains a trait type @ref is_splittable to determine whether a type models the splittable reducible concept.
+* A splittable reducible is a reducible that can be divided in two, which lets the library fold it in parallel.
+* It must provide, either as member functions or as free functions found by argument dependent lookup:
+* - size(), or size(r), returning an estimate of the number of elements as a value convertible to std::size_t;
+* - split(), or split(r), returning a pair-like object whose members first and second are reducibles of
+*   the same type, holding the elements before and after some point, in order.
+*/
+
+#include "../reducers_common.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	template<typename T>
+	class has_split_member_function
+	{
+		template<typename U> static std::true_type test(
+			typename std::enable_if<
+			    std::is_same<typename std::decay<decltype(std::declval<U const&>().split().first)>::type, U>::value &&
+			    std::is_same<typename std::decay<decltype(std::declval<U const&>().split().second)>::type, U>::value &&
+			    std::is_convertible<decltype(std::declval<U const&>().size()), std::size_t>::value,
+			    int
+			>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<typename std::decay<T>::type>(0)) type;
+		static const bool value = type::value;
+	};
+
+	template<typename T>
+	class has_split_function
+	{
+		template<typename U> static std::true_type test(
+			typename std::enable_if<
+			    std::is_same<typename std::decay<decltype(split(std::declval<U const&>()).first)>::type, U>::value &&
+			    std::is_same<typename std::decay<decltype(split(std::declval<U const&>()).second)>::type, U>::value &&
+			    std::is_convertible<decltype(size(std::declval<U const&>())), std::size_t>::value,
+			    int
+			>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<typename std::decay<T>::type>(0)) type;
+		static const bool value = type::value;
+	};
+
+	template<typename T>
+	struct is_splittable
+	{
+		static const bool value = has_split_member_function<T>::value || has_split_function<T>::value;
+	};
+
+	/**
+    * @internal
+    * Returns the estimated number of elements of the given splittable reducible.
+	*/
+	template<typename T>
+	typename std::enable_if<has_split_member_function<T>::value, std::size_t>::type
+	splittable_size(T const& reducible)
+	{
+		return static_cast<std::size_t>(reducible.size());
+	}
+
+	template<typename T>
+	typename std::enable_if<!has_split_member_function<T>::value && has_split_function<T>::value, std::size_t>::type
+	splittable_size(T const& reducible)
+	{
+		return static_cast<std::size_t>(size(reducible));
+	}
+
+	/**
+    * @internal
+    * Splits the given splittable reducible in two.
+	*/
+	template<typename T>
+	typename std::enable_if<has_split_member_function<T>::value, decltype(std::declval<T const&>().split())>::type
+	split_splittable(T const& reducible)
+	{
+		return reducible.split();
+	}
+
+	template<typename T>
+	typename std::enable_if<!has_split_member_function<T>::value && has_split_function<T>::value, decltype(split(std::declval<T const&>()))>::type
+	split_splittable(T const& reducible)
+	{
+		return split(reducible);
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_IS_SPLITTABLE_H_INCLUDED
@@ -0,0 +1,497 @@
+#ifndef WENDA_REDUCERS_DETAIL_PARALLEL_REDUCE_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_PARALLEL_REDUCE_H_INCLUDED
+
+/**
+* @file parallel_reduce.h
+* This file contains the implementation of the parallel divide and conquer reduction
+* that underlies the fold() function. It recursively splits an index space in halves,
+* reduces the leaves sequentially, and combines the partial results in order on an executor.
+* How the index space is split is decided by the partitioner attached to the executor.
+*/
+
+#include "../reducers_common.h"
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../executors/partitioners.h"
+#include "../reduced.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Storage for a value that is constructed at a later point,
+    * used to hold partial results that need not be default constructible.
+	*/
+	template<typename T>
+	class deferred_value
+	{
+		typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage;
+		bool constructed;
+
+	public:
+		deferred_value()
+			: constructed(false)
+		{}
+
+		~deferred_value()
+		{
+			if (constructed)
+			{
+				get().~T();
+			}
+		}
+
+		deferred_value(deferred_value const&) = delete;
+		deferred_value& operator=(deferred_value const&) = delete;
+
+		template<typename U>
+		void set(U&& value)
+		{
+			new (&storage) T(std::forward<U>(value));
+			constructed = true;
+		}
+
+		T& get()
+		{
+			return *reinterpret_cast<T*>(&storage);
+		}
+	};
+
+	template<typename T>
+	class has_local_queue_empty
+	{
+		template<typename U> static std::true_type test(decltype(std::declval<U const&>().local_queue_empty())*);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<T>(nullptr)) type;
+		static const bool value = type::value;
+	};
+
+	template<typename T>
+	class has_partitioner
+	{
+		template<typename U> static std::true_type test(typename std::add_pointer<decltype(std::declval<U const&>().partitioner())>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<T>(nullptr)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Returns whether the calling worker of the given executor should expose more work.
+    * Executors that cannot tell always request more work.
+	*/
+	template<typename Executor>
+	typename std::enable_if<has_local_queue_empty<Executor>::value, bool>::type
+	requests_work(Executor& executor)
+	{
+		return executor.local_queue_empty();
+	}
+
+	template<typename Executor>
+	typename std::enable_if<!has_local_queue_empty<Executor>::value, bool>::type
+	requests_work(Executor&)
+	{
+		return true;
+	}
+
+	template<typename Executor, typename Partitioner>
+	bool requests_work(partitioned_executor<Executor, Partitioner>& executor)
+	{
+		return requests_work(executor.base());
+	}
+
+	/**
+    * @internal
+    * Returns the partitioner attached to the given executor, or an @ref auto_partitioner if there is none.
+	*/
+	template<typename Executor>
+	typename std::enable_if<has_partitioner<Executor>::value, typename std::decay<decltype(std::declval<Executor const&>().partitioner())>::type>::type
+	partitioner_of(Executor const& executor)
+	{
+		return executor.partitioner();
+	}
+
+	template<typename Executor>
+	typename std::enable_if<!has_partitioner<Executor>::value, auto_partitioner>::type
+	partitioner_of(Executor const&)
+	{
+		return auto_partitioner();
+	}
+
+	/**
+    * @internal
+    * Trait to determine whether folds on the given executor are deterministic, that is whether a @ref deterministic_partitioner is attached to it.
+	*/
+	template<typename Executor>
+	struct is_deterministic_executor
+		: std::is_same<decltype(partitioner_of(std::declval<typename std::decay<Executor>::type const&>())), deterministic_partitioner>
+	{
+	};
+
+	/**
+    * @internal
+    * Returns the partitioner used to split the sequence of chunks of a range
+    * that has been cut into chunks according to the given partitioner.
+	*/
+	inline fixed_partitioner chunk_partitioner(fixed_partitioner const&)
+	{
+		return fixed_partitioner(1);
+	}
+
+	inline fixed_partitioner chunk_partitioner(auto_partitioner const&)
+	{
+		return fixed_partitioner(1);
+	}
+
+	inline lazy_partitioner chunk_partitioner(lazy_partitioner const&)
+	{
+		return lazy_partitioner(1);
+	}
+
+	inline deterministic_partitioner chunk_partitioner(deterministic_partitioner const&)
+	{
+		return deterministic_partitioner(1);
+	}
+
+	/**
+    * @internal
+    * Returns whether a range may be reduced sequentially when the executor has a single worker.
+    * This is not the case for deterministic folds, whose reduction tree must not depend on the executor.
+	*/
+	template<typename Partitioner>
+	bool may_reduce_sequentially(Partitioner const&)
+	{
+		return true;
+	}
+
+	inline bool may_reduce_sequentially(deterministic_partitioner const&)
+	{
+		return false;
+	}
+
+	/**
+    * @internal
+    * The maximum number of indices that a piece of a fold that may terminate early
+    * reduces before it checks whether the fold was terminated before it.
+	*/
+	const std::size_t stop_check_interval = 4096;
+
+	/**
+    * @internal
+    * State shared by the pieces of a fold that may terminate early.
+    * It holds the smallest index of a piece in which the reduction was terminated,
+    * so that the pieces after it, whose results are discarded, can be skipped.
+	*/
+	class stop_state
+	{
+		std::atomic<std::size_t> first;
+
+	public:
+		stop_state()
+			: first(std::numeric_limits<std::size_t>::max())
+		{}
+
+		bool is_stopped_before(std::size_t index) const
+		{
+			return first.load(std::memory_order_relaxed) < index;
+		}
+
+		void stop_at(std::size_t index)
+		{
+			std::size_t current = first.load(std::memory_order_relaxed);
+
+			while (index < current && !first.compare_exchange_weak(current, index, std::memory_order_relaxed))
+			{
+			}
+		}
+	};
+
+	/**
+    * @internal
+    * A leaf for folds that may terminate early. It reduces its range in pieces of at most
+    * @ref stop_check_interval indices, and stops as soon as the fold was terminated before it.
+	*/
+	template<typename Leaf>
+	struct stopping_leaf
+	{
+		Leaf const& leaf;
+		stop_state& stop;
+
+		stopping_leaf(Leaf const& leaf, stop_state& stop)
+			: leaf(leaf), stop(stop)
+		{}
+
+		template<typename Value>
+		Value operator()(std::size_t first, std::size_t last, Value seed) const
+		{
+			while (first < last)
+			{
+				if (stop.is_stopped_before(first))
+				{
+					// this piece lies after the point where the fold terminated, its result is discarded.
+					return seed;
+				}
+
+				std::size_t next = last - first > stop_check_interval ? first + stop_check_interval : last;
+				seed = leaf(first, next, std::move(seed));
+
+				if (is_reduced(seed))
+				{
+					stop.stop_at(first);
+					return seed;
+				}
+
+				first = next;
+			}
+
+			return seed;
+		}
+	};
+
+	/**
+    * @internal
+    * Splits the index range [first, last) in halves until the pieces contain at most @p grain indices.
+	*/
+	template<typename Value, typename Leaf, typename Combine, typename Executor>
+	Value split_reduce(std::size_t first, std::size_t last, std::size_t grain, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor)
+	{
+		if (last - first <= grain)
+		{
+			return leaf(first, last, identity);
+		}
+
+		std::size_t middle = first + (last - first) / 2;
+
+		deferred_value<Value> left;
+		deferred_value<Value> right;
+
+		executor.invoke(
+			[&] { left.set(split_reduce(first, middle, grain, identity, leaf, combine, executor)); },
+			[&] { right.set(split_reduce(middle, last, grain, identity, leaf, combine, executor)); });
+
+		return combine(std::move(left.get()), std::move(right.get()));
+	}
+
+	/**
+    * @internal
+    * Reduces the index range [first, last) by lazy binary splitting, continuing from the given @p seed.
+    * The range is reduced in chunks, and the remainder is split in half whenever the executor requests work.
+	*/
+	template<typename Value, typename Leaf, typename Combine, typename Executor>
+	Value lazy_split_reduce(std::size_t first, std::size_t last, std::size_t chunk, Value seed, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor)
+	{
+		while (last - first > chunk)
+		{
+			if (last - first >= 2 * chunk && requests_work(executor))
+			{
+				std::size_t middle = first + (last - first) / 2;
+
+				deferred_value<Value> left;
+				deferred_value<Value> right;
+
+				executor.invoke(
+					[&] { left.set(lazy_split_reduce(first, middle, chunk, std::move(seed), identity, leaf, combine, executor)); },
+					[&] { right.set(lazy_split_reduce(middle, last, chunk, identity, identity, leaf, combine, executor)); });
+
+				return combine(std::move(left.get()), std::move(right.get()));
+			}
+
+			seed = leaf(first, first + chunk, std::move(seed));
+			first += chunk;
+
+			if (is_reduced(seed))
+			{
+				return seed;
+			}
+		}
+
+		return leaf(first, last, std::move(seed));
+	}
+
+	template<typename Value, typename Leaf, typename Combine, typename Executor>
+	Value partitioned_reduce(std::size_t first, std::size_t last, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor, fixed_partitioner const& partitioner)
+	{
+		return split_reduce(first, last, partitioner.grain_size(last - first, executor.concurrency()), identity, leaf, combine, executor);
+	}
+
+	template<typename Value, typename Leaf, typename Combine, typename Executor>
+	Value partitioned_reduce(std::size_t first, std::size_t last, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor, auto_partitioner const& partitioner)
+	{
+		return split_reduce(first, last, partitioner.grain_size(last - first, executor.concurrency()), identity, leaf, combine, executor);
+	}
+
+	template<typename Value, typename Leaf, typename Combine, typename Executor>
+	Value partitioned_reduce(std::size_t first, std::size_t last, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor, lazy_partitioner const& partitioner)
+	{
+		return lazy_split_reduce(first, last, partitioner.grain_size(last - first, executor.concurrency()), identity, identity, leaf, combine, executor);
+	}
+
+	template<typename Value, typename Leaf, typename Combine, typename Executor>
+	Value partitioned_reduce(std::size_t first, std::size_t last, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor, deterministic_partitioner const& partitioner)
+	{
+		return split_reduce(first, last, partitioner.grain_size(last - first, executor.concurrency()), identity, leaf, combine, executor);
+	}
+
+	template<typename Value, typename Leaf, typename Combine, typename Executor, typename Partitioner>
+	Value parallel_reduce_index(std::size_t first, std::size_t last, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor, Partitioner const& partitioner, std::false_type)
+	{
+		if (last - first <= 1 || (executor.concurrency() <= 1 && may_reduce_sequentially(partitioner)))
+		{
+			return leaf(first, last, identity);
+		}
+
+		deferred_value<Value> result;
+		executor.run([&] { result.set(partitioned_reduce(first, last, identity, leaf, combine, executor, partitioner)); });
+		return std::move(result.get());
+	}
+
+	template<typename Value, typename Leaf, typename Combine, typename Executor, typename Partitioner>
+	Value parallel_reduce_index(std::size_t first, std::size_t last, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor, Partitioner const& partitioner, std::true_type)
+	{
+		// the fold may terminate early: the pieces share a stop state, and are combined in order.
+		stop_state stop;
+		return parallel_reduce_index(
+			first, last, identity,
+			stopping_leaf<Leaf>(leaf, stop),
+			in_order_combine<Combine>(combine),
+			executor, partitioner, std::false_type());
+	}
+
+	/**
+    * @internal
+    * Reduces the index range [first, last) in parallel on the given executor.
+    * If the values are of type @ref reduced, the fold terminates early as a sequential reduction would.
+    * @param identity The identity value of the @p combine operation, used as the seed of the pieces.
+    * @param leaf A function object of signature (std::size_t, std::size_t, Value) -> Value that sequentially reduces a subrange from a seed.
+    * @param combine An associative function object of signature (Value, Value) -> Value.
+    * @param executor The executor on which to run the reduction.
+    * @param partitioner The partitioner that decides how the range is split.
+	*/
+	template<typename Value, typename Leaf, typename Combine, typename Executor, typename Partitioner>
+	Value parallel_reduce_index(std::size_t first, std::size_t last, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor, Partitioner const& partitioner)
+	{
+		return parallel_reduce_index(first, last, identity, leaf, combine, executor, partitioner, typename is_reduced_type<Value>::type());
+	}
+
+	/**
+    * @internal
+    * Reduces the index range [first, last) in parallel on the given executor, with the partitioner attached to the executor.
+	*/
+	template<typename Value, typename Leaf, typename Combine, typename Executor>
+	Value parallel_reduce_index(std::size_t first, std::size_t last, Value const& identity, Leaf const& leaf, Combine const& combine, Executor& executor)
+	{
+		return parallel_reduce_index(first, last, identity, leaf, combine, executor, partitioner_of(executor));
+	}
+
+	template<typename Iterator, typename RangeReduce>
+	struct random_access_leaf
+	{
+		typedef typename std::iterator_traits<Iterator>::difference_type difference_t;
+
+		Iterator begin;
+		RangeReduce const& reduce;
+
+		random_access_leaf(Iterator begin, RangeReduce const& reduce)
+			: begin(begin), reduce(reduce)
+		{}
+
+		template<typename Value>
+		Value operator()(std::size_t first, std::size_t last, Value seed) const
+		{
+			return reduce(begin + static_cast<difference_t>(first), begin + static_cast<difference_t>(last), std::move(seed));
+		}
+	};
+
+	template<typename Iterator, typename RangeReduce>
+	struct chunked_leaf
+	{
+		std::vector<Iterator> const& bounds;
+		RangeReduce const& reduce;
+
+		chunked_leaf(std::vector<Iterator> const& bounds, RangeReduce const& reduce)
+			: bounds(bounds), reduce(reduce)
+		{}
+
+		template<typename Value>
+		Value operator()(std::size_t first, std::size_t last, Value seed) const
+		{
+			return reduce(bounds[first], bounds[last], std::move(seed));
+		}
+	};
+
+	template<typename Iterator, typename Value, typename RangeReduce, typename Combine, typename Executor>
+	Value parallel_reduce(Iterator begin, Iterator end, Value const& identity, RangeReduce const& reduce, Combine const& combine, Executor& executor, std::random_access_iterator_tag)
+	{
+		return parallel_reduce_index(
+			0, static_cast<std::size_t>(end - begin), identity,
+			random_access_leaf<Iterator, RangeReduce>(begin, reduce),
+			combine, executor);
+	}
+
+	template<typename Iterator, typename Value, typename RangeReduce, typename Combine, typename Executor>
+	Value parallel_reduce(Iterator begin, Iterator end, Value const& identity, RangeReduce const& reduce, Combine const& combine, Executor& executor, std::forward_iterator_tag)
+	{
+		// without random access, we cut the range into chunks in a single pass, and split the sequence of chunks.
+		auto partitioner = partitioner_of(executor);
+		std::size_t size = static_cast<std::size_t>(std::distance(begin, end));
+		std::size_t grain = partitioner.grain_size(size, executor.concurrency());
+
+		std::vector<Iterator> bounds;
+		bounds.reserve(size / grain + 2);
+
+		for (std::size_t remaining = size; remaining > grain; remaining -= grain)
+		{
+			bounds.push_back(begin);
+			std::advance(begin, grain);
+		}
+
+		bounds.push_back(begin);
+		bounds.push_back(end);
+
+		return parallel_reduce_index(
+			0, bounds.size() - 1, identity,
+			chunked_leaf<Iterator, RangeReduce>(bounds, reduce),
+			combine, executor, chunk_partitioner(partitioner));
+	}
+
+	template<typename Iterator, typename Value, typename RangeReduce, typename Combine, typename Executor>
+	Value parallel_reduce(Iterator begin, Iterator end, Value const& identity, RangeReduce const& reduce, Combine const&, Executor&, std::input_iterator_tag)
+	{
+		// single pass iterators cannot be split.
+		return reduce(begin, end, identity);
+	}
+
+	/**
+    * @internal
+    * Reduces the range [begin, end) in parallel on the given executor.
+    * Random access ranges are split recursively, forward ranges are first cut into chunks,
+    * and input ranges are reduced sequentially.
+    * @param identity The identity value of the @p combine operation, used as the seed of every subrange.
+    * @param reduce A function object of signature (Iterator, Iterator, Value) -> Value that sequentially reduces a subrange.
+    * @param combine An associative function object of signature (Value, Value) -> Value.
+    * @param executor The executor on which to run the reduction.
+	*/
+	template<typename Iterator, typename Value, typename RangeReduce, typename Combine, typename Executor>
+	Value parallel_reduce(Iterator begin, Iterator end, Value const& identity, RangeReduce const& reduce, Combine const& combine, Executor& executor)
+	{
+		return parallel_reduce(
+			std::move(begin), std::move(end), identity, reduce, combine, executor,
+			typename std::iterator_traits<Iterator>::iterator_category());
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_PARALLEL_REDUCE_H_INCLUDED
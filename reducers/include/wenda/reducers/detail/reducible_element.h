@@ -0,0 +1,45 @@
+#ifndef WENDA_REDUCERS_DETAIL_REDUCIBLE_ELEMENT_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_REDUCIBLE_ELEMENT_H_INCLUDED
+
+/**
+* @file reducible_element.h
+* This file contains the @ref detail::reducible_element trait, which gives the type of the elements of a reducible
+* when it is known before reducing it, as it is for ranges. Reducibles and transformers specialize it,
+* so that functions of the elements, such as the keys of group_by(), can be typed from the reducible.
+*/
+
+#include "../reducers_common.h"
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "is_range.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Trait to determine the type of the elements of a reducible.
+    * Specializations for which value is true provide this type, without references or qualifiers, as type.
+	*/
+	template<typename Reducible, typename Enable = void>
+	struct reducible_element
+	{
+		static const bool value = false;
+	};
+
+	template<typename Range>
+	struct reducible_element<Range, typename std::enable_if<is_range<Range>::value>::type>
+	{
+		typedef typename std::decay<decltype(*std::begin(std::declval<Range const&>()))>::type type;
+
+		static const bool value = true;
+	};
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_REDUCIBLE_ELEMENT_H_INCLUDED
@@ -0,0 +1,872 @@
+#ifndef WENDA_REDUCERS_DETAIL_SIMD_REDUCE_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_SIMD_REDUCE_H_INCLUDED
+
+/**
+* @file simd_reduce.h
+* This file contains the kernels used to reduce contiguous ranges of arithmetic values over the built-in monoids,
+* that is sums, minimums, maximums and bitwise operations.
+* On x86 processors, the kernels use SSE2, or AVX2 when the processor supports it, which is detected at run time.
+* Elsewhere, or for the operations without a vector instruction, they fall back to a scalar loop with several accumulators.
+* The kernels rely on the associativity of the operation, hence floating point sums may differ in rounding from a sequential loop,
+* and from one processor to another, as the number of lanes depends on the instruction set. Deterministic folds select
+* the portable kernels instead, which are scalar loops with a fixed number of accumulators.
+* The element-wise combination of arrays of partial aggregates, used by group_by_dense(), relies on the same kernels.
+* This file also contains the compensated and pairwise summation kernels of @ref kahan_monoid and @ref pairwise_sum_monoid.
+*/
+
+#include "../reducers_common.h"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "is_range.h"
+#include "../monoid/monoid.h"
+
+#if defined(WENDA_REDUCERS_SIMD_X86)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Trait to determine whether a reducing function is a monoid operation that the kernels implement,
+    * and over which element type.
+	*/
+	template<typename Operation>
+	struct simd_operation_traits
+	{
+		typedef void element_t;
+		static const bool value = false;
+	};
+
+	template<typename T>
+	struct simd_operation_traits<std::plus<T>>
+	{
+		typedef T element_t;
+		static const bool value = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value;
+	};
+
+	template<typename T>
+	struct simd_operation_traits<min_operation<T>>
+	{
+		typedef T element_t;
+		static const bool value = std::is_arithmetic<T>::value;
+	};
+
+	template<typename T>
+	struct simd_operation_traits<max_operation<T>>
+	{
+		typedef T element_t;
+		static const bool value = std::is_arithmetic<T>::value;
+	};
+
+	template<typename T>
+	struct simd_operation_traits<std::bit_and<T>>
+	{
+		typedef T element_t;
+		static const bool value = std::is_integral<T>::value;
+	};
+
+	template<typename T>
+	struct simd_operation_traits<std::bit_or<T>>
+	{
+		typedef T element_t;
+		static const bool value = std::is_integral<T>::value;
+	};
+
+	template<typename T>
+	struct simd_operation_traits<std::bit_xor<T>>
+	{
+		typedef T element_t;
+		static const bool value = std::is_integral<T>::value;
+	};
+
+	/**
+    * @internal
+    * Trait to determine whether a range can be reduced with the given operation by the kernels,
+    * that is whether it is contiguous and its elements are of the type of the operation.
+	*/
+	template<typename Range, typename Operation, typename Enable = void>
+	struct is_simd_reducible
+	{
+		typedef std::false_type type;
+		static const bool value = false;
+	};
+
+	template<typename Range, typename Operation>
+	struct is_simd_reducible<Range, Operation, typename std::enable_if<
+	    is_contiguous_range<Range>::value && simd_operation_traits<Operation>::value
+	>::type>
+	{
+		typedef typename std::remove_cv<typename std::remove_pointer<
+		    decltype(contiguous_data(std::declval<typename std::remove_reference<Range>::type&>()))
+		>::type>::type element_t;
+
+		static const bool value = std::is_same<element_t, typename simd_operation_traits<Operation>::element_t>::value;
+		typedef std::integral_constant<bool, value> type;
+	};
+
+	/**
+    * @internal
+    * Tag that selects the kernels for the processor, which are chosen at run time.
+	*/
+	struct native_kernels {};
+
+	/**
+    * @internal
+    * Tag that selects the portable kernels, whose order of operations is the same on every processor and in every build.
+	*/
+	struct portable_kernels {};
+
+	/**
+    * @internal
+    * Reduces the elements of [first, last) into the given seed with four independent accumulators,
+    * which breaks the dependency of every step on the previous one.
+	*/
+	template<typename T, typename Operation>
+	T reduce_unrolled(T const* first, T const* last, T seed, Operation const& op)
+	{
+		if (last - first >= 8)
+		{
+			T acc0 = first[0];
+			T acc1 = first[1];
+			T acc2 = first[2];
+			T acc3 = first[3];
+			first += 4;
+
+			for (; last - first >= 4; first += 4)
+			{
+				acc0 = op(acc0, first[0]);
+				acc1 = op(acc1, first[1]);
+				acc2 = op(acc2, first[2]);
+				acc3 = op(acc3, first[3]);
+			}
+
+			seed = op(seed, op(op(acc0, acc1), op(acc2, acc3)));
+		}
+
+		for (; first != last; ++first)
+		{
+			seed = op(seed, *first);
+		}
+
+		return seed;
+	}
+
+#if defined(WENDA_REDUCERS_SIMD_X86)
+	struct sse2_float_lanes
+	{
+		typedef float element_t;
+		typedef __m128 vector_t;
+		static const bool value = true;
+		static const std::size_t width = 4;
+
+		static vector_t load(float const* p) { return _mm_loadu_ps(p); }
+		static void store(float* p, vector_t v) { _mm_storeu_ps(p, v); }
+	};
+
+	struct sse2_double_lanes
+	{
+		typedef double element_t;
+		typedef __m128d vector_t;
+		static const bool value = true;
+		static const std::size_t width = 2;
+
+		static vector_t load(double const* p) { return _mm_loadu_pd(p); }
+		static void store(double* p, vector_t v) { _mm_storeu_pd(p, v); }
+	};
+
+	template<typename T>
+	struct sse2_integral_lanes
+	{
+		typedef T element_t;
+		typedef __m128i vector_t;
+		static const bool value = true;
+		static const std::size_t width = 16 / sizeof(T);
+
+		static vector_t load(T const* p) { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)); }
+		static void store(T* p, vector_t v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+	};
+
+	template<std::size_t Size> struct sse2_add;
+	template<> struct sse2_add<1> { static __m128i apply(__m128i a, __m128i b) { return _mm_add_epi8(a, b); } };
+	template<> struct sse2_add<2> { static __m128i apply(__m128i a, __m128i b) { return _mm_add_epi16(a, b); } };
+	template<> struct sse2_add<4> { static __m128i apply(__m128i a, __m128i b) { return _mm_add_epi32(a, b); } };
+	template<> struct sse2_add<8> { static __m128i apply(__m128i a, __m128i b) { return _mm_add_epi64(a, b); } };
+
+	/**
+    * @internal
+    * The SSE2 implementation of a monoid operation, if there is one.
+    * The operations that SSE2 lacks, such as the minimum of 64 bit integers, use the scalar kernel.
+	*/
+	template<typename Operation, typename Enable = void>
+	struct sse2_kernel
+	{
+		static const bool value = false;
+	};
+
+	template<> struct sse2_kernel<std::plus<float>> : sse2_float_lanes { static vector_t apply(vector_t a, vector_t b) { return _mm_add_ps(a, b); } };
+	template<> struct sse2_kernel<min_operation<float>> : sse2_float_lanes { static vector_t apply(vector_t a, vector_t b) { return _mm_min_ps(a, b); } };
+	template<> struct sse2_kernel<max_operation<float>> : sse2_float_lanes { static vector_t apply(vector_t a, vector_t b) { return _mm_max_ps(a, b); } };
+	template<> struct sse2_kernel<std::plus<double>> : sse2_double_lanes { static vector_t apply(vector_t a, vector_t b) { return _mm_add_pd(a, b); } };
+	template<> struct sse2_kernel<min_operation<double>> : sse2_double_lanes { static vector_t apply(vector_t a, vector_t b) { return _mm_min_pd(a, b); } };
+	template<> struct sse2_kernel<max_operation<double>> : sse2_double_lanes { static vector_t apply(vector_t a, vector_t b) { return _mm_max_pd(a, b); } };
+
+	template<typename T>
+	struct sse2_kernel<std::plus<T>, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+		: sse2_integral_lanes<T>
+	{
+		static __m128i apply(__m128i a, __m128i b) { return sse2_add<sizeof(T)>::apply(a, b); }
+	};
+
+	template<typename T>
+	struct sse2_kernel<min_operation<T>, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 4>::type>
+		: sse2_integral_lanes<T>
+	{
+		static __m128i apply(__m128i a, __m128i b)
+		{
+			__m128i less = _mm_cmplt_epi32(a, b);
+			return _mm_or_si128(_mm_and_si128(less, a), _mm_andnot_si128(less, b));
+		}
+	};
+
+	template<typename T>
+	struct sse2_kernel<max_operation<T>, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 4>::type>
+		: sse2_integral_lanes<T>
+	{
+		static __m128i apply(__m128i a, __m128i b)
+		{
+			__m128i greater = _mm_cmpgt_epi32(a, b);
+			return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+		}
+	};
+
+	template<typename T>
+	struct sse2_kernel<std::bit_and<T>, typename std::enable_if<std::is_integral<T>::value>::type>
+		: sse2_integral_lanes<T>
+	{
+		static __m128i apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+	};
+
+	template<typename T>
+	struct sse2_kernel<std::bit_or<T>, typename std::enable_if<std::is_integral<T>::value>::type>
+		: sse2_integral_lanes<T>
+	{
+		static __m128i apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+	};
+
+	template<typename T>
+	struct sse2_kernel<std::bit_xor<T>, typename std::enable_if<std::is_integral<T>::value>::type>
+		: sse2_integral_lanes<T>
+	{
+		static __m128i apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+	};
+
+	struct avx2_float_lanes
+	{
+		typedef float element_t;
+		typedef __m256 vector_t;
+		static const std::size_t width = 8;
+
+		WENDA_REDUCERS_TARGET_AVX2 static vector_t load(float const* p) { return _mm256_loadu_ps(p); }
+		WENDA_REDUCERS_TARGET_AVX2 static void store(float* p, vector_t v) { _mm256_storeu_ps(p, v); }
+	};
+
+	struct avx2_double_lanes
+	{
+		typedef double element_t;
+		typedef __m256d vector_t;
+		static const std::size_t width = 4;
+
+		WENDA_REDUCERS_TARGET_AVX2 static vector_t load(double const* p) { return _mm256_loadu_pd(p); }
+		WENDA_REDUCERS_TARGET_AVX2 static void store(double* p, vector_t v) { _mm256_storeu_pd(p, v); }
+	};
+
+	template<typename T>
+	struct avx2_integral_lanes
+	{
+		typedef T element_t;
+		typedef __m256i vector_t;
+		static const std::size_t width = 32 / sizeof(T);
+
+		WENDA_REDUCERS_TARGET_AVX2 static vector_t load(T const* p) { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)); }
+		WENDA_REDUCERS_TARGET_AVX2 static void store(T* p, vector_t v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+	};
+
+	template<std::size_t Size> struct avx2_add;
+	template<> struct avx2_add<1> { WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return _mm256_add_epi8(a, b); } };
+	template<> struct avx2_add<2> { WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return _mm256_add_epi16(a, b); } };
+	template<> struct avx2_add<4> { WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); } };
+	template<> struct avx2_add<8> { WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return _mm256_add_epi64(a, b); } };
+
+	/**
+    * @internal
+    * The AVX2 implementation of a monoid operation. It exists for every operation that has an SSE2 implementation.
+	*/
+	template<typename Operation, typename Enable = void>
+	struct avx2_kernel;
+
+	template<> struct avx2_kernel<std::plus<float>> : avx2_float_lanes { WENDA_REDUCERS_TARGET_AVX2 static vector_t apply(vector_t a, vector_t b) { return _mm256_add_ps(a, b); } };
+	template<> struct avx2_kernel<min_operation<float>> : avx2_float_lanes { WENDA_REDUCERS_TARGET_AVX2 static vector_t apply(vector_t a, vector_t b) { return _mm256_min_ps(a, b); } };
+	template<> struct avx2_kernel<max_operation<float>> : avx2_float_lanes { WENDA_REDUCERS_TARGET_AVX2 static vector_t apply(vector_t a, vector_t b) { return _mm256_max_ps(a, b); } };
+	template<> struct avx2_kernel<std::plus<double>> : avx2_double_lanes { WENDA_REDUCERS_TARGET_AVX2 static vector_t apply(vector_t a, vector_t b) { return _mm256_add_pd(a, b); } };
+	template<> struct avx2_kernel<min_operation<double>> : avx2_double_lanes { WENDA_REDUCERS_TARGET_AVX2 static vector_t apply(vector_t a, vector_t b) { return _mm256_min_pd(a, b); } };
+	template<> struct avx2_kernel<max_operation<double>> : avx2_double_lanes { WENDA_REDUCERS_TARGET_AVX2 static vector_t apply(vector_t a, vector_t b) { return _mm256_max_pd(a, b); } };
+
+	template<typename T>
+	struct avx2_kernel<std::plus<T>, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+		: avx2_integral_lanes<T>
+	{
+		WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return avx2_add<sizeof(T)>::apply(a, b); }
+	};
+
+	template<typename T>
+	struct avx2_kernel<min_operation<T>, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 4>::type>
+		: avx2_integral_lanes<T>
+	{
+		WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return _mm256_min_epi32(a, b); }
+	};
+
+	template<typename T>
+	struct avx2_kernel<max_operation<T>, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 4>::type>
+		: avx2_integral_lanes<T>
+	{
+		WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return _mm256_max_epi32(a, b); }
+	};
+
+	template<typename T>
+	struct avx2_kernel<std::bit_and<T>, typename std::enable_if<std::is_integral<T>::value>::type>
+		: avx2_integral_lanes<T>
+	{
+		WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+	};
+
+	template<typename T>
+	struct avx2_kernel<std::bit_or<T>, typename std::enable_if<std::is_integral<T>::value>::type>
+		: avx2_integral_lanes<T>
+	{
+		WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+	};
+
+	template<typename T>
+	struct avx2_kernel<std::bit_xor<T>, typename std::enable_if<std::is_integral<T>::value>::type>
+		: avx2_integral_lanes<T>
+	{
+		WENDA_REDUCERS_TARGET_AVX2 static __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+	};
+
+	/**
+    * @internal
+    * Returns whether the processor and the operating system support AVX2.
+	*/
+	inline bool cpu_supports_avx2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+
+		if (info[0] < 7)
+		{
+			return false;
+		}
+
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+
+		// the operating system must save the upper halves of the registers on context switches.
+		if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+		{
+			return false;
+		}
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+
+	inline bool use_avx2()
+	{
+		static const bool supported = cpu_supports_avx2();
+		return supported;
+	}
+
+	/**
+    * @internal
+    * Reduces the elements of [first, last) into the given seed with the given vector kernel.
+    * The loop keeps four vector accumulators, which are combined, and then folded lane by lane into the seed.
+    * Its definition is expanded once for each instruction set, as GCC and Clang only compile AVX2 intrinsics
+    * in functions that target AVX2.
+	*/
+#define WENDA_REDUCERS_DEFINE_REDUCE_LANES(Name, Target) \
+	template<typename Kernel, typename Operation> \
+	Target \
+	typename Kernel::element_t Name(typename Kernel::element_t const* first, typename Kernel::element_t const* last, typename Kernel::element_t seed, Operation const& op) \
+	{ \
+		typedef typename Kernel::element_t element_t; \
+		typedef typename Kernel::vector_t vector_t; \
+		const std::size_t width = Kernel::width; \
+\
+		if (static_cast<std::size_t>(last - first) >= 4 * width) \
+		{ \
+			vector_t acc0 = Kernel::load(first); \
+			vector_t acc1 = Kernel::load(first + width); \
+			vector_t acc2 = Kernel::load(first + 2 * width); \
+			vector_t acc3 = Kernel::load(first + 3 * width); \
+			first += 4 * width; \
+\
+			for (; static_cast<std::size_t>(last - first) >= 4 * width; first += 4 * width) \
+			{ \
+				acc0 = Kernel::apply(acc0, Kernel::load(first)); \
+				acc1 = Kernel::apply(acc1, Kernel::load(first + width)); \
+				acc2 = Kernel::apply(acc2, Kernel::load(first + 2 * width)); \
+				acc3 = Kernel::apply(acc3, Kernel::load(first + 3 * width)); \
+			} \
+\
+			acc0 = Kernel::apply(Kernel::apply(acc0, acc1), Kernel::apply(acc2, acc3)); \
+\
+			for (; static_cast<std::size_t>(last - first) >= width; first += width) \
+			{ \
+				acc0 = Kernel::apply(acc0, Kernel::load(first)); \
+			} \
+\
+			element_t lanes[Kernel::width]; \
+			Kernel::store(lanes, acc0); \
+\
+			for (std::size_t i = 0; i < width; ++i) \
+			{ \
+				seed = op(seed, lanes[i]); \
+			} \
+		} \
+\
+		for (; first != last; ++first) \
+		{ \
+			seed = op(seed, *first); \
+		} \
+\
+		return seed; \
+	}
+
+	WENDA_REDUCERS_DEFINE_REDUCE_LANES(reduce_lanes, )
+
+	/**
+    * @internal
+    * Same as @ref reduce_lanes, compiled for AVX2.
+	*/
+	WENDA_REDUCERS_DEFINE_REDUCE_LANES(reduce_lanes_avx2, WENDA_REDUCERS_TARGET_AVX2)
+
+#undef WENDA_REDUCERS_DEFINE_REDUCE_LANES
+
+	template<typename T, typename Operation>
+	T reduce_contiguous_x86(T const* first, T const* last, T seed, Operation const& op, std::true_type)
+	{
+		if (use_avx2())
+		{
+			return reduce_lanes_avx2<avx2_kernel<Operation>>(first, last, seed, op);
+		}
+
+		return reduce_lanes<sse2_kernel<Operation>>(first, last, seed, op);
+	}
+
+	template<typename T, typename Operation>
+	T reduce_contiguous_x86(T const* first, T const* last, T seed, Operation const& op, std::false_type)
+	{
+		return reduce_unrolled(first, last, seed, op);
+	}
+#endif
+
+	/**
+    * @internal
+    * Reduces the elements of [first, last) into the given seed with the given monoid operation,
+    * using the fastest kernel available for the operation and the processor.
+    * @tparam Operation An operation for which simd_operation_traits is true, over elements of type T.
+	*/
+	template<typename T, typename Operation>
+	T reduce_contiguous(T const* first, T const* last, T seed, Operation const& op)
+	{
+#if defined(WENDA_REDUCERS_SIMD_X86)
+		typedef std::integral_constant<bool, sse2_kernel<Operation>::value> has_kernel_t;
+		return reduce_contiguous_x86(first, last, seed, op, has_kernel_t());
+#else
+		return reduce_unrolled(first, last, seed, op);
+#endif
+	}
+
+	template<typename T, typename Operation>
+	T reduce_contiguous(T const* first, T const* last, T seed, Operation const& op, native_kernels)
+	{
+		return reduce_contiguous(first, last, seed, op);
+	}
+
+	template<typename T, typename Operation>
+	T reduce_contiguous(T const* first, T const* last, T seed, Operation const& op, portable_kernels)
+	{
+		return reduce_unrolled(first, last, seed, op);
+	}
+
+#if defined(WENDA_REDUCERS_SIMD_X86)
+	/**
+    * @internal
+    * Combines the elements of [right, right + count) into those at @p left, lane by lane, with the given vector kernel.
+    * As for @ref reduce_lanes, its definition is expanded once for each instruction set.
+	*/
+#define WENDA_REDUCERS_DEFINE_COMBINE_LANES(Name, Target) \
+	template<typename Kernel, typename Operation> \
+	Target \
+	void Name(typename Kernel::element_t* left, typename Kernel::element_t const* right, std::size_t count, Operation const& op) \
+	{ \
+		const std::size_t width = Kernel::width; \
+		std::size_t i = 0; \
+\
+		for (; count - i >= width; i += width) \
+		{ \
+			Kernel::store(left + i, Kernel::apply(Kernel::load(left + i), Kernel::load(right + i))); \
+		} \
+\
+		for (; i < count; ++i) \
+		{ \
+			left[i] = op(left[i], right[i]); \
+		} \
+	}
+
+	WENDA_REDUCERS_DEFINE_COMBINE_LANES(combine_lanes, )
+
+	/**
+    * @internal
+    * Same as @ref combine_lanes, compiled for AVX2.
+	*/
+	WENDA_REDUCERS_DEFINE_COMBINE_LANES(combine_lanes_avx2, WENDA_REDUCERS_TARGET_AVX2)
+
+#undef WENDA_REDUCERS_DEFINE_COMBINE_LANES
+
+	template<typename T, typename Operation>
+	void combine_contiguous_x86(T* left, T const* right, std::size_t count, Operation const& op, std::true_type)
+	{
+		if (use_avx2())
+		{
+			combine_lanes_avx2<avx2_kernel<Operation>>(left, right, count, op);
+			return;
+		}
+
+		combine_lanes<sse2_kernel<Operation>>(left, right, count, op);
+	}
+
+	template<typename T, typename Operation>
+	void combine_contiguous_x86(T* left, T const* right, std::size_t count, Operation const& op, std::false_type)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			left[i] = op(left[i], right[i]);
+		}
+	}
+#endif
+
+	/**
+    * @internal
+    * Combines two arrays of @p count elements element-wise with the given monoid operation, into the @p left one,
+    * using the fastest kernel available for the operation and the processor.
+    * @tparam Operation An operation for which simd_operation_traits is true, over elements of type T.
+	*/
+	template<typename T, typename Operation>
+	void combine_contiguous(T* left, T const* right, std::size_t count, Operation const& op)
+	{
+#if defined(WENDA_REDUCERS_SIMD_X86)
+		typedef std::integral_constant<bool, sse2_kernel<Operation>::value> has_kernel_t;
+		combine_contiguous_x86(left, right, count, op, has_kernel_t());
+#else
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			left[i] = op(left[i], right[i]);
+		}
+#endif
+	}
+
+	/**
+    * @internal
+    * Adds the values of [first, last) to a compensated sum with eight independent compensated sums, which are merged at the end.
+	*/
+	template<typename T>
+	kahan_sum<T> reduce_compensated_unrolled(T const* first, T const* last, kahan_sum<T> seed)
+	{
+		const std::size_t lanes = 8;
+
+		if (static_cast<std::size_t>(last - first) >= lanes)
+		{
+			T sums[lanes] = {};
+			T compensations[lanes] = {};
+
+			for (; static_cast<std::size_t>(last - first) >= lanes; first += lanes)
+			{
+				for (std::size_t i = 0; i < lanes; ++i)
+				{
+					compensated_add(sums[i], compensations[i], first[i]);
+				}
+			}
+
+			kahan_operation<T> op;
+
+			for (std::size_t i = 0; i < lanes; ++i)
+			{
+				seed = op(seed, kahan_sum<T>(sums[i], compensations[i]));
+			}
+		}
+
+		for (; first != last; ++first)
+		{
+			compensated_add(seed.sum, seed.compensation, *first);
+		}
+
+		return seed;
+	}
+
+#if defined(WENDA_REDUCERS_SIMD_X86)
+	/**
+    * @internal
+    * The SSE2 implementation of compensated addition, for floating point types.
+	*/
+	template<typename T>
+	struct sse2_compensated_kernel
+	{
+		static const bool value = false;
+	};
+
+	template<>
+	struct sse2_compensated_kernel<float>
+		: sse2_float_lanes
+	{
+		static vector_t zero() { return _mm_setzero_ps(); }
+
+		static void add(vector_t& sum, vector_t& compensation, vector_t value)
+		{
+			vector_t total = _mm_add_ps(sum, value);
+			vector_t rounded = _mm_sub_ps(total, sum);
+			compensation = _mm_add_ps(compensation, _mm_add_ps(_mm_sub_ps(sum, _mm_sub_ps(total, rounded)), _mm_sub_ps(value, rounded)));
+			sum = total;
+		}
+	};
+
+	template<>
+	struct sse2_compensated_kernel<double>
+		: sse2_double_lanes
+	{
+		static vector_t zero() { return _mm_setzero_pd(); }
+
+		static void add(vector_t& sum, vector_t& compensation, vector_t value)
+		{
+			vector_t total = _mm_add_pd(sum, value);
+			vector_t rounded = _mm_sub_pd(total, sum);
+			compensation = _mm_add_pd(compensation, _mm_add_pd(_mm_sub_pd(sum, _mm_sub_pd(total, rounded)), _mm_sub_pd(value, rounded)));
+			sum = total;
+		}
+	};
+
+	/**
+    * @internal
+    * The AVX2 implementation of compensated addition, for floating point types.
+	*/
+	template<typename T>
+	struct avx2_compensated_kernel;
+
+	template<>
+	struct avx2_compensated_kernel<float>
+		: avx2_float_lanes
+	{
+		WENDA_REDUCERS_TARGET_AVX2 static vector_t zero() { return _mm256_setzero_ps(); }
+
+		WENDA_REDUCERS_TARGET_AVX2 static void add(vector_t& sum, vector_t& compensation, vector_t value)
+		{
+			vector_t total = _mm256_add_ps(sum, value);
+			vector_t rounded = _mm256_sub_ps(total, sum);
+			compensation = _mm256_add_ps(compensation, _mm256_add_ps(_mm256_sub_ps(sum, _mm256_sub_ps(total, rounded)), _mm256_sub_ps(value, rounded)));
+			sum = total;
+		}
+	};
+
+	template<>
+	struct avx2_compensated_kernel<double>
+		: avx2_double_lanes
+	{
+		WENDA_REDUCERS_TARGET_AVX2 static vector_t zero() { return _mm256_setzero_pd(); }
+
+		WENDA_REDUCERS_TARGET_AVX2 static void add(vector_t& sum, vector_t& compensation, vector_t value)
+		{
+			vector_t total = _mm256_add_pd(sum, value);
+			vector_t rounded = _mm256_sub_pd(total, sum);
+			compensation = _mm256_add_pd(compensation, _mm256_add_pd(_mm256_sub_pd(sum, _mm256_sub_pd(total, rounded)), _mm256_sub_pd(value, rounded)));
+			sum = total;
+		}
+	};
+
+	/**
+    * @internal
+    * Adds the values of [first, last) to a compensated sum with the given vector kernel.
+    * The loop keeps four vector sums with their compensations, whose lanes are then merged into the seed.
+    * As for @ref reduce_lanes, its definition is expanded once for each instruction set.
+	*/
+#define WENDA_REDUCERS_DEFINE_REDUCE_COMPENSATED_LANES(Name, Target) \
+	template<typename Kernel> \
+	Target \
+	kahan_sum<typename Kernel::element_t> Name(typename Kernel::element_t const* first, typename Kernel::element_t const* last, kahan_sum<typename Kernel::element_t> seed) \
+	{ \
+		typedef typename Kernel::element_t element_t; \
+		typedef typename Kernel::vector_t vector_t; \
+		const std::size_t width = Kernel::width; \
+\
+		if (static_cast<std::size_t>(last - first) >= 4 * width) \
+		{ \
+			vector_t sum0 = Kernel::zero(), sum1 = Kernel::zero(), sum2 = Kernel::zero(), sum3 = Kernel::zero(); \
+			vector_t compensation0 = Kernel::zero(), compensation1 = Kernel::zero(), compensation2 = Kernel::zero(), compensation3 = Kernel::zero(); \
+\
+			for (; static_cast<std::size_t>(last - first) >= 4 * width; first += 4 * width) \
+			{ \
+				Kernel::add(sum0, compensation0, Kernel::load(first)); \
+				Kernel::add(sum1, compensation1, Kernel::load(first + width)); \
+				Kernel::add(sum2, compensation2, Kernel::load(first + 2 * width)); \
+				Kernel::add(sum3, compensation3, Kernel::load(first + 3 * width)); \
+			} \
+\
+			element_t sums[4 * Kernel::width]; \
+			element_t compensations[4 * Kernel::width]; \
+			Kernel::store(sums, sum0); \
+			Kernel::store(sums + width, sum1); \
+			Kernel::store(sums + 2 * width, sum2); \
+			Kernel::store(sums + 3 * width, sum3); \
+			Kernel::store(compensations, compensation0); \
+			Kernel::store(compensations + width, compensation1); \
+			Kernel::store(compensations + 2 * width, compensation2); \
+			Kernel::store(compensations + 3 * width, compensation3); \
+\
+			kahan_operation<element_t> op; \
+\
+			for (std::size_t i = 0; i < 4 * width; ++i) \
+			{ \
+				seed = op(seed, kahan_sum<element_t>(sums[i], compensations[i])); \
+			} \
+		} \
+\
+		for (; first != last; ++first) \
+		{ \
+			compensated_add(seed.sum, seed.compensation, *first); \
+		} \
+\
+		return seed; \
+	}
+
+	WENDA_REDUCERS_DEFINE_REDUCE_COMPENSATED_LANES(reduce_compensated_lanes, )
+
+	/**
+    * @internal
+    * Same as @ref reduce_compensated_lanes, compiled for AVX2.
+	*/
+	WENDA_REDUCERS_DEFINE_REDUCE_COMPENSATED_LANES(reduce_compensated_lanes_avx2, WENDA_REDUCERS_TARGET_AVX2)
+
+#undef WENDA_REDUCERS_DEFINE_REDUCE_COMPENSATED_LANES
+
+	template<typename T>
+	kahan_sum<T> reduce_compensated_x86(T const* first, T const* last, kahan_sum<T> seed, std::true_type)
+	{
+		if (use_avx2())
+		{
+			return reduce_compensated_lanes_avx2<avx2_compensated_kernel<T>>(first, last, seed);
+		}
+
+		return reduce_compensated_lanes<sse2_compensated_kernel<T>>(first, last, seed);
+	}
+
+	template<typename T>
+	kahan_sum<T> reduce_compensated_x86(T const* first, T const* last, kahan_sum<T> seed, std::false_type)
+	{
+		return reduce_compensated_unrolled(first, last, seed);
+	}
+#endif
+
+	/**
+    * @internal
+    * Adds the values of [first, last) to the given compensated sum,
+    * using the fastest kernel available for the type and the processor.
+	*/
+	template<typename T>
+	kahan_sum<T> reduce_compensated(T const* first, T const* last, kahan_sum<T> seed)
+	{
+#if defined(WENDA_REDUCERS_SIMD_X86)
+		typedef std::integral_constant<bool, sse2_compensated_kernel<T>::value> has_kernel_t;
+		return reduce_compensated_x86(first, last, seed, has_kernel_t());
+#else
+		return reduce_compensated_unrolled(first, last, seed);
+#endif
+	}
+
+	template<typename T>
+	kahan_sum<T> reduce_compensated(T const* first, T const* last, kahan_sum<T> seed, native_kernels)
+	{
+		return reduce_compensated(first, last, seed);
+	}
+
+	template<typename T>
+	kahan_sum<T> reduce_compensated(T const* first, T const* last, kahan_sum<T> seed, portable_kernels)
+	{
+		return reduce_compensated_unrolled(first, last, seed);
+	}
+
+	/**
+    * @internal
+    * The number of values below which @ref pairwise_sum stops halving a range, and sums it with the kernels.
+	*/
+	const std::size_t pairwise_block_size = 128;
+
+	/**
+    * @internal
+    * Sums the values of [first, last) by recursively halving the range, so that the rounding error grows
+    * with the logarithm of the number of values. The ranges that are no longer halved are summed with the kernels,
+    * whose lanes only sum a few values each.
+	*/
+	template<typename T, typename Kernels>
+	T pairwise_sum(T const* first, T const* last, Kernels kernels)
+	{
+		std::size_t count = static_cast<std::size_t>(last - first);
+
+		if (count > pairwise_block_size)
+		{
+			// split on a multiple of 32 values, so that the halves keep whole vectors.
+			std::size_t half = count / 2 / 32 * 32;
+			return pairwise_sum(first, first + half, kernels) + pairwise_sum(first + half, last, kernels);
+		}
+
+		return reduce_contiguous(first, last, T(), std::plus<T>(), kernels);
+	}
+
+	/**
+    * @internal
+    * Reducing function for the leaves of a parallel fold over a contiguous range, which reduces them with the given kernels.
+	*/
+	template<typename Operation, typename Kernels>
+	struct contiguous_reduce_function
+	{
+		Operation const& operation;
+
+		contiguous_reduce_function(Operation const& operation)
+			: operation(operation)
+		{}
+
+		template<typename T>
+		T operator()(T const* first, T const* last, T seed) const
+		{
+			return reduce_contiguous(first, last, seed, operation, Kernels());
+		}
+	};
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_SIMD_REDUCE_H_INCLUDED
@@ -0,0 +1,78 @@
+#ifndef WENDA_REDUCERS_DETAIL_STATEFUL_SEED_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_STATEFUL_SEED_H_INCLUDED
+
+/**
+* @file stateful_seed.h
+* This file contains the seed type used by the transformers that depend on the position of the elements,
+* such as take() and drop(). Their state is carried along with the seed rather than in the reducing function,
+* so that the reducing function can remain const and be copied freely.
+*/
+
+#include "../reducers_common.h"
+
+#include <utility>
+#include <type_traits>
+
+#include "../reduced.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Holds the seed of the downstream reduction along with the state of a transformer.
+    * Transformers reduce their source with seeds of type reduced<stateful_seed<Seed, State>>,
+    * which lets them terminate the reduction of the source.
+	*/
+	template<typename Seed, typename State>
+	struct stateful_seed
+	{
+		Seed seed;
+		State state;
+
+		stateful_seed(Seed seed, State state)
+			: seed(std::move(seed)), state(std::move(state))
+		{
+		}
+	};
+
+	/**
+    * @internal
+    * Creates the initial seed of a reduction through a transformer with the given state.
+	*/
+	template<typename Seed, typename State>
+	reduced<stateful_seed<typename std::decay<Seed>::type, State>> make_stateful_seed(Seed&& seed, State state)
+	{
+		typedef stateful_seed<typename std::decay<Seed>::type, State> seed_t;
+		return reduced<seed_t>(seed_t(std::forward<Seed>(seed), std::move(state)));
+	}
+
+	/**
+    * @internal
+    * Returns the given stateful seed, marked as terminated if the downstream reduction was terminated.
+	*/
+	template<typename Seed, typename State>
+	reduced<stateful_seed<Seed, State>> continue_stateful_seed(stateful_seed<Seed, State>&& current, bool done)
+	{
+		done = done || is_reduced(current.seed);
+		return reduced<stateful_seed<Seed, State>>(std::move(current), done);
+	}
+
+	/**
+    * @internal
+    * Marks the given stateful seed as terminated, in place, if it is done or if the downstream reduction was terminated.
+	*/
+	template<typename Seed, typename State>
+	void continue_stateful_seed(reduced<stateful_seed<Seed, State>>& seed, bool done)
+	{
+		if (done || is_reduced(seed.get().seed))
+		{
+			seed = reduced<stateful_seed<Seed, State>>(std::move(seed.get()), true);
+		}
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_STATEFUL_SEED_H_INCLUDED
@@ -0,0 +1,41 @@
+#ifndef WENDA_REDUCERS_DETAIL_STORED_REDUCIBLE_H_INCLUDED
+#define WENDA_REDUCERS_DETAIL_STORED_REDUCIBLE_H_INCLUDED
+
+/**
+* @file stored_reducible.h
+* This file contains the trait that determines how transformers hold the reducible they transform.
+*/
+
+#include "../reducers_common.h"
+
+#include <type_traits>
+
+#include "is_range.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Determines the type under which a transformer holds its source reducible, given the type it was passed as.
+    * Ranges passed as l-values are held by constant reference, so that transforming a container does not copy it,
+    * and arrays remain ranges rather than decaying to pointers. The range must then outlive the transformer.
+    * Other reducibles, such as transformers, are cheap to copy and are held by value, as are r-values, which are moved in.
+	*/
+	template<typename Reducible>
+	struct stored_reducible
+	{
+		typedef typename std::remove_reference<Reducible>::type value_t;
+
+		typedef typename std::conditional<
+			std::is_lvalue_reference<Reducible>::value && is_range<value_t>::value,
+			value_t const&,
+			typename std::decay<Reducible>::type
+		>::type type;
+	};
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_DETAIL_STORED_REDUCIBLE_H_INCLUDED
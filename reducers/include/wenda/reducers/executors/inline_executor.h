@@ -0,0 +1,42 @@
+#ifndef WENDA_REDUCERS_EXECUTORS_INLINE_EXECUTOR_H_INCLUDED
+#define WENDA_REDUCERS_EXECUTORS_INLINE_EXECUTOR_H_INCLUDED
+
+/**
+* @file inline_executor.h
+* This file contains an executor that runs all work on the calling thread.
+*/
+
+#include "../reducers_common.h"
+
+#include <cstddef>
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+/**
+* This executor runs all the work sequentially on the calling thread.
+* Folding on it is equivalent to reducing, and never starts or uses any other thread.
+*/
+struct inline_executor
+{
+	std::size_t concurrency() const
+	{
+		return 1;
+	}
+
+	template<typename Function>
+	void run(Function&& function) const
+	{
+		function();
+	}
+
+	template<typename Left, typename Right>
+	void invoke(Left&& left, Right&& right) const
+	{
+		left();
+		right();
+	}
+};
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_EXECUTORS_INLINE_EXECUTOR_H_INCLUDED
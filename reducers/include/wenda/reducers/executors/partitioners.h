@@ -0,0 +1,188 @@
+#ifndef WENDA_REDUCERS_EXECUTORS_PARTITIONERS_H_INCLUDED
+#define WENDA_REDUCERS_EXECUTORS_PARTITIONERS_H_INCLUDED
+
+/**
+* @file partitioners.h
+* This file contains the partitioners, which control how fold() splits its input into pieces of work,
+* and an executor adaptor that attaches a partitioner to an executor.
+*/
+
+#include "../reducers_common.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+/**
+* This partitioner splits the input until the pieces contain at most a fixed number of elements.
+* It is appropriate when the cost of the elements is known and uniform.
+*/
+class fixed_partitioner
+{
+	std::size_t grain;
+
+public:
+	/**
+    * Creates a new partitioner with the given grain size.
+    * @param grain The maximum number of elements of a piece of work. It is at least one.
+	*/
+	explicit fixed_partitioner(std::size_t grain)
+		: grain(grain == 0 ? 1 : grain)
+	{}
+
+	std::size_t grain_size(std::size_t, std::size_t) const
+	{
+		return grain;
+	}
+};
+
+/**
+* This partitioner splits the input in a number of pieces proportional to the
+* concurrency of the executor, leaving room for work-stealing to balance the load.
+* This is the partitioner used when none is specified.
+*/
+class auto_partitioner
+{
+public:
+	std::size_t grain_size(std::size_t size, std::size_t concurrency) const
+	{
+		std::size_t grain = size / (8 * (concurrency == 0 ? 1 : concurrency));
+		return grain == 0 ? 1 : grain;
+	}
+};
+
+/**
+* This partitioner implements lazy binary splitting. Each worker processes its input in small chunks,
+* and only splits the remainder in half when its own queue is empty, that is when the work it exposed
+* before has been stolen by idle workers. The input is hence only divided when there is demand for it,
+* which balances pipelines whose cost per element is irregular (for example after a filter) without tuning.
+* On executors that cannot report the state of their queues, it behaves as a @ref fixed_partitioner with the chunk size as grain.
+*/
+class lazy_partitioner
+{
+	std::size_t chunk;
+
+public:
+	/**
+    * Creates a new lazy partitioner.
+    * @param chunk The number of elements processed between two checks for demand.
+    * If it is zero, a chunk size is derived from the size of the input and the concurrency of the executor.
+	*/
+	explicit lazy_partitioner(std::size_t chunk = 0)
+		: chunk(chunk)
+	{}
+
+	std::size_t grain_size(std::size_t size, std::size_t concurrency) const
+	{
+		if (chunk != 0)
+		{
+			return chunk;
+		}
+
+		std::size_t grain = size / (64 * (concurrency == 0 ? 1 : concurrency));
+		return grain == 0 ? 1 : grain;
+	}
+};
+
+/**
+* This partitioner makes folds deterministic. The input is split in halves until the pieces contain at most
+* a fixed number of elements, and the partial results are combined along the same tree, whatever the number of
+* workers and however the work was scheduled. The shape of the reduction tree hence only depends on the length of the input,
+* and folds over operations that are not exactly associative, such as floating point additions, give bit-identical
+* results from run to run and across machines.
+*/
+class deterministic_partitioner
+{
+	std::size_t grain;
+
+public:
+	/**
+    * Creates a new deterministic partitioner with the given grain size.
+    * @param grain The maximum number of elements of a leaf of the reduction tree. It is at least one.
+	*/
+	explicit deterministic_partitioner(std::size_t grain = 1024)
+		: grain(grain == 0 ? 1 : grain)
+	{}
+
+	std::size_t grain_size(std::size_t, std::size_t) const
+	{
+		return grain;
+	}
+};
+
+/**
+* This class adapts an executor to run folds with the given partitioner.
+* It models the executor concept itself, and can hence be passed anywhere an executor is expected.
+* The executor is held by reference if @p Executor is an l-value reference type, and by value otherwise.
+*/
+template<typename Executor, typename Partitioner>
+class partitioned_executor
+{
+	Executor executor;
+	Partitioner partitionerValue;
+
+public:
+	partitioned_executor(Executor&& executor, Partitioner partitioner)
+		: executor(std::forward<Executor>(executor)), partitionerValue(std::move(partitioner))
+	{}
+
+	std::size_t concurrency() const
+	{
+		return executor.concurrency();
+	}
+
+	template<typename Function>
+	void run(Function&& function)
+	{
+		executor.run(std::forward<Function>(function));
+	}
+
+	template<typename Left, typename Right>
+	void invoke(Left&& left, Right&& right)
+	{
+		executor.invoke(std::forward<Left>(left), std::forward<Right>(right));
+	}
+
+	template<typename Function, typename E = Executor>
+	auto post(Function&& function) -> decltype(std::declval<typename std::remove_reference<E>::type&>().post(std::forward<Function>(function)))
+	{
+		return executor.post(std::forward<Function>(function));
+	}
+
+	/**
+    * Returns the underlying executor.
+	*/
+	typename std::remove_reference<Executor>::type& base()
+	{
+		return executor;
+	}
+
+	Partitioner const& partitioner() const
+	{
+		return partitionerValue;
+	}
+};
+
+/**
+* Attaches a partitioner to the given executor.
+* @code
+* auto result = data | filter(p) | fold<additive_monoid<int>>(with_partitioner(pool, lazy_partitioner()));
+* @endcode
+* @param executor The executor on which to run the folds.
+* @param partitioner The partitioner to use, for example a @ref fixed_partitioner, @ref auto_partitioner, @ref lazy_partitioner
+* or @ref deterministic_partitioner.
+* @returns An executor that folds with the given partitioner.
+*/
+template<typename Executor, typename Partitioner>
+partitioned_executor<Executor, typename std::decay<Partitioner>::type>
+with_partitioner(Executor&& executor, Partitioner&& partitioner)
+{
+	typedef partitioned_executor<Executor, typename std::decay<Partitioner>::type> return_t;
+	return return_t(std::forward<Executor>(executor), std::forward<Partitioner>(partitioner));
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_EXECUTORS_PARTITIONERS_H_INCLUDED
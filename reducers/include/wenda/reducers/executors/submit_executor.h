@@ -0,0 +1,180 @@
+#ifndef WENDA_REDUCERS_EXECUTORS_SUBMIT_EXECUTOR_H_INCLUDED
+#define WENDA_REDUCERS_EXECUTORS_SUBMIT_EXECUTOR_H_INCLUDED
+
+/**
+* @file submit_executor.h
+* This file contains an executor adaptor, which runs folds on a thread pool owned by the caller.
+*/
+
+#include "../reducers_common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * State shared between a caller of submit_executor::invoke() and the task it submitted.
+    * Whoever claims the state first runs the function.
+	*/
+	struct submitted_task_state
+	{
+		std::atomic<bool> claimed;
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool done;
+		std::exception_ptr exception;
+
+		submitted_task_state()
+			: claimed(false), done(false)
+		{}
+
+		bool claim()
+		{
+			return !claimed.exchange(true);
+		}
+
+		template<typename Function>
+		void execute(Function& function)
+		{
+			try
+			{
+				function();
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			done = true;
+			condition.notify_all();
+		}
+
+		void wait()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this] { return done; });
+		}
+	};
+}
+
+/**
+* This class adapts an external thread pool to the executor concept, so that folds can
+* run on a pool that the application already owns, instead of starting threads of their own.
+* The pool is only required to provide a way to submit tasks, through the @p Submit function.
+* When the calling thread finds that a task it submitted has not been started yet, it runs it
+* itself, hence the adaptor never blocks on a task that is waiting in the queue of the pool.
+* @tparam Submit A function object of signature (std::function<void()>) -> void that schedules a task on the pool.
+*/
+template<typename Submit>
+class submit_executor
+{
+	Submit submit;
+	std::size_t threads;
+
+public:
+	/**
+    * Creates a new executor that submits its work through the given function.
+    * @param submit The function used to submit tasks to the pool.
+    * @param concurrency The number of threads of the pool, which is used to size the work.
+	*/
+	submit_executor(Submit submit, std::size_t concurrency)
+		: submit(std::move(submit)), threads(concurrency == 0 ? 1 : concurrency)
+	{}
+
+	std::size_t concurrency() const
+	{
+		return threads;
+	}
+
+	template<typename Function>
+	void run(Function&& function)
+	{
+		function();
+	}
+
+	/**
+    * Submits the given function to the pool, and returns without waiting for it.
+	*/
+	template<typename Function>
+	void post(Function&& function)
+	{
+		std::shared_ptr<typename std::decay<Function>::type> task = std::make_shared<typename std::decay<Function>::type>(std::forward<Function>(function));
+		submit(std::function<void()>([task] { (*task)(); }));
+	}
+
+	template<typename Left, typename Right>
+	void invoke(Left&& left, Right&& right)
+	{
+		typedef typename std::remove_reference<Right>::type right_t;
+
+		std::shared_ptr<detail::submitted_task_state> state = std::make_shared<detail::submitted_task_state>();
+		right_t* rightFunction = &right;
+
+		// the task only touches the right function if it claims it, in which case we wait for it.
+		submit(std::function<void()>([state, rightFunction]
+		{
+			if (state->claim())
+			{
+				state->execute(*rightFunction);
+			}
+		}));
+
+		try
+		{
+			left();
+		}
+		catch (...)
+		{
+			if (!state->claim())
+			{
+				state->wait();
+			}
+
+			throw;
+		}
+
+		if (state->claim())
+		{
+			right();
+		}
+		else
+		{
+			state->wait();
+
+			if (state->exception)
+			{
+				std::rethrow_exception(state->exception);
+			}
+		}
+	}
+};
+
+/**
+* Creates a new executor that runs its work on an external pool.
+* @param submit A function object of signature (std::function<void()>) -> void that schedules a task on the pool.
+* @param concurrency The number of threads of the pool.
+* @returns An executor that can be passed to fold().
+* @sa submit_executor
+*/
+template<typename Submit>
+submit_executor<typename std::decay<Submit>::type>
+make_submit_executor(Submit&& submit, std::size_t concurrency)
+{
+	return submit_executor<typename std::decay<Submit>::type>(std::forward<Submit>(submit), concurrency);
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_EXECUTORS_SUBMIT_EXECUTOR_H_INCLUDED
@@ -0,0 +1,554 @@
+#ifndef WENDA_REDUCERS_EXECUTORS_THREAD_POOL_H_INCLUDED
+#define WENDA_REDUCERS_EXECUTORS_THREAD_POOL_H_INCLUDED
+
+/**
+* @file thread_pool.h
+* This file contains a portable work-stealing thread pool, which is used
+* by the library to run parallel folds.
+* Each worker owns a deque of tasks: it pushes and pops work at the back of its own deque,
+* while idle workers steal the oldest (and hence usually largest) tasks from the front of the deques of others.
+*/
+
+#include "../reducers_common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Base class for the units of work scheduled on a @ref thread_pool.
+    * Tasks are never owned by the pool: whoever schedules a task must keep it
+    * alive until it has completed.
+	*/
+	class pool_task
+	{
+		std::atomic<bool> completed;
+		std::exception_ptr exception;
+
+		virtual void run() = 0;
+
+	protected:
+		pool_task()
+			: completed(false)
+		{}
+
+		~pool_task()
+		{}
+
+		/**
+        * Marks the task as completed. Note that the owner of the task may destroy it
+        * as soon as it observes the completion, hence this must be the last access to the task.
+		*/
+		virtual void finish()
+		{
+			completed.store(true, std::memory_order_release);
+		}
+
+	public:
+		void execute()
+		{
+			try
+			{
+				run();
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+
+			finish();
+		}
+
+		bool is_completed() const
+		{
+			return completed.load(std::memory_order_acquire);
+		}
+
+		void rethrow_if_failed() const
+		{
+			if (exception)
+			{
+				std::rethrow_exception(exception);
+			}
+		}
+	};
+
+	/**
+    * @internal
+    * A task that invokes a function object by reference.
+	*/
+	template<typename Function>
+	class function_task : public pool_task
+	{
+		Function& function;
+
+		virtual void run()
+		{
+			function();
+		}
+
+	public:
+		explicit function_task(Function& function)
+			: function(function)
+		{}
+	};
+
+	/**
+    * @internal
+    * A task for which a thread that is not part of the pool can block until it completes.
+	*/
+	template<typename Function>
+	class blocking_task : public function_task<Function>
+	{
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool done;
+
+		virtual void finish()
+		{
+			// notify while holding the lock, so that the waiting thread cannot
+			// destroy the task before we are done with it.
+			std::lock_guard<std::mutex> lock(mutex);
+			done = true;
+			condition.notify_all();
+		}
+
+	public:
+		explicit blocking_task(Function& function)
+			: function_task<Function>(function), done(false)
+		{}
+
+		void wait()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this] { return done; });
+		}
+	};
+
+	/**
+    * @internal
+    * A task that owns its function object, and destroys itself once it has completed.
+    * It is used for work that is scheduled on the pool without waiting for it.
+    * It is final, as it is deleted through its own type while the destructor of @ref pool_task is not virtual.
+	*/
+	template<typename Function>
+	class owning_task final : public pool_task
+	{
+		Function function;
+
+		virtual void run()
+		{
+			function();
+		}
+
+		virtual void finish()
+		{
+			delete this;
+		}
+
+	public:
+		explicit owning_task(Function function)
+			: function(std::move(function))
+		{}
+	};
+
+	/**
+    * @internal
+    * A double-ended queue of tasks. The owning worker uses the back,
+    * while thieves take work from the front.
+	*/
+	class work_queue
+	{
+		std::mutex mutex;
+		std::deque<pool_task*> tasks;
+		std::atomic<std::size_t> count; ///< the number of tasks, readable without taking the lock.
+
+	public:
+		work_queue()
+			: count(0)
+		{}
+
+		bool empty() const
+		{
+			return count.load(std::memory_order_relaxed) == 0;
+		}
+
+		void push(pool_task* task)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push_back(task);
+			count.store(tasks.size(), std::memory_order_relaxed);
+		}
+
+		pool_task* pop()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (tasks.empty())
+			{
+				return nullptr;
+			}
+
+			pool_task* task = tasks.back();
+			tasks.pop_back();
+			count.store(tasks.size(), std::memory_order_relaxed);
+			return task;
+		}
+
+		bool pop_if(pool_task* task)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (tasks.empty() || tasks.back() != task)
+			{
+				return false;
+			}
+
+			tasks.pop_back();
+			count.store(tasks.size(), std::memory_order_relaxed);
+			return true;
+		}
+
+		pool_task* steal()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (tasks.empty())
+			{
+				return nullptr;
+			}
+
+			pool_task* task = tasks.front();
+			tasks.pop_front();
+			count.store(tasks.size(), std::memory_order_relaxed);
+			return task;
+		}
+	};
+}
+
+/**
+* This class implements a fixed-size pool of worker threads that schedules work by work-stealing.
+* Work is expressed in a fork-join style through invoke(), which runs two function objects
+* potentially in parallel, and returns once both have completed. Threads that are not part of
+* the pool enter it through run().
+*/
+class thread_pool
+{
+	struct worker_context
+	{
+		thread_pool* pool;
+		std::size_t index;
+	};
+
+	std::size_t workers;
+	std::vector<std::unique_ptr<detail::work_queue>> queues; ///< one queue per worker, followed by the queue for external submissions.
+	std::vector<std::thread> threads;
+
+	std::mutex sleep_mutex;
+	std::condition_variable wake_condition;
+	std::atomic<std::ptrdiff_t> pending;
+	std::atomic<std::size_t> sleeping;
+	std::atomic<bool> stopping;
+
+	static worker_context*& current_context()
+	{
+		static WENDA_REDUCERS_THREAD_LOCAL worker_context* context = nullptr;
+		return context;
+	}
+
+	worker_context* current_worker() const
+	{
+		worker_context* context = current_context();
+		return context != nullptr && context->pool == this ? context : nullptr;
+	}
+
+	std::size_t external_queue() const
+	{
+		return workers;
+	}
+
+	void schedule(std::size_t queue, detail::pool_task* task)
+	{
+		queues[queue]->push(task);
+		pending.fetch_add(1);
+
+		if (sleeping.load() != 0)
+		{
+			// taking the lock ensures that a worker about to sleep either sees the new
+			// task, or is already waiting and receives the notification.
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			wake_condition.notify_one();
+		}
+	}
+
+	/**
+    * Takes a task for the worker with the given @p index: from its own queue first, then from the
+    * queue for external submissions if @p external is true, and finally from the queues of the other workers.
+	*/
+	detail::pool_task* find_task(std::size_t index, bool external)
+	{
+		detail::pool_task* task = queues[index]->pop();
+
+		if (task == nullptr && external)
+		{
+			task = queues[external_queue()]->steal();
+		}
+
+		for (std::size_t i = 1; task == nullptr && i < workers; ++i)
+		{
+			task = queues[(index + i) % workers]->steal();
+		}
+
+		if (task != nullptr)
+		{
+			pending.fetch_sub(1);
+		}
+
+		return task;
+	}
+
+	void wait_for(detail::pool_task& task, std::size_t index)
+	{
+		while (!task.is_completed())
+		{
+			// only help with the work of other workers: an external submission is unrelated to
+			// the join, and could keep this worker away from it for an arbitrarily long time.
+			detail::pool_task* other = find_task(index, false);
+
+			if (other != nullptr)
+			{
+				other->execute();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void worker_loop(std::size_t index)
+	{
+		worker_context context = { this, index };
+		current_context() = &context;
+
+		for (;;)
+		{
+			detail::pool_task* task = find_task(index, true);
+
+			if (task != nullptr)
+			{
+				task->execute();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleep_mutex);
+			sleeping.fetch_add(1);
+			wake_condition.wait(lock, [this] { return stopping.load() || pending.load() > 0; });
+			sleeping.fetch_sub(1);
+
+			if (stopping.load() && pending.load() <= 0)
+			{
+				break;
+			}
+		}
+
+		current_context() = nullptr;
+	}
+
+public:
+	/**
+    * Returns the default number of workers of a pool, which is the number of hardware threads.
+	*/
+	static std::size_t default_concurrency()
+	{
+		std::size_t concurrency = std::thread::hardware_concurrency();
+		return concurrency == 0 ? 1 : concurrency;
+	}
+
+	/**
+    * Creates a new thread pool with the given number of worker threads.
+    * @param concurrency The number of worker threads. If it is zero, a single worker is created.
+	*/
+	explicit thread_pool(std::size_t concurrency = default_concurrency())
+		: workers(concurrency == 0 ? 1 : concurrency), pending(0), sleeping(0), stopping(false)
+	{
+		for (std::size_t i = 0; i <= workers; ++i)
+		{
+			queues.push_back(std::unique_ptr<detail::work_queue>(new detail::work_queue()));
+		}
+
+		threads.reserve(workers);
+
+		for (std::size_t i = 0; i < workers; ++i)
+		{
+			threads.push_back(std::thread([this, i] { worker_loop(i); }));
+		}
+	}
+
+	/**
+    * Stops and joins all the worker threads.
+    * No work may be in flight on the pool when it is destroyed.
+	*/
+	~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			stopping.store(true);
+			wake_condition.notify_all();
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	thread_pool(thread_pool const&) = delete;
+	thread_pool& operator=(thread_pool const&) = delete;
+
+	/**
+    * Returns the number of worker threads in this pool.
+	*/
+	std::size_t concurrency() const
+	{
+		return workers;
+	}
+
+	/**
+    * Returns whether the calling thread is one of the workers of this pool.
+	*/
+	bool is_worker() const
+	{
+		return current_worker() != nullptr;
+	}
+
+	/**
+    * Returns whether the queue of the calling worker is empty, which indicates that
+    * the work it previously exposed has been stolen by idle workers.
+    * It is used for lazy splitting, and returns false if the calling thread is not a worker of this pool.
+	*/
+	bool local_queue_empty() const
+	{
+		worker_context* context = current_worker();
+		return context != nullptr && queues[context->index]->empty();
+	}
+
+	/**
+    * Runs the given function on this pool, and blocks until it has completed.
+    * If the calling thread is already a worker of this pool, the function is simply invoked.
+    * Exceptions thrown by the function are propagated to the caller.
+    * @param function A nullary function object.
+	*/
+	template<typename Function>
+	void run(Function&& function)
+	{
+		if (is_worker())
+		{
+			function();
+			return;
+		}
+
+		detail::blocking_task<typename std::remove_reference<Function>::type> task(function);
+		schedule(external_queue(), &task);
+		task.wait();
+		task.rethrow_if_failed();
+	}
+
+	/**
+    * Schedules the given function to run on this pool, and returns without waiting for it.
+    * The function is moved or copied into the pool, and any exception it throws is discarded.
+    * The pool completes all the functions scheduled on it before it is destroyed.
+    * @param function A nullary function object.
+	*/
+	template<typename Function>
+	void post(Function&& function)
+	{
+		typedef detail::owning_task<typename std::decay<Function>::type> task_t;
+
+		// the task goes to the external queue even from a worker, so that it does not get in the way of the fork-join work.
+		std::unique_ptr<task_t> task(new task_t(std::forward<Function>(function)));
+		schedule(external_queue(), task.get());
+		task.release();
+	}
+
+	/**
+    * Invokes the two given functions, potentially in parallel, and returns once both have completed.
+    * The @p right function is made available to be stolen by idle workers, while the calling
+    * thread proceeds with the @p left function. If no worker has taken @p right once @p left
+    * has completed, the calling thread runs it as well.
+    * If either function throws, the exception is propagated once both have completed.
+    * @param left The function to run on the calling thread.
+    * @param right The function that may be run by another worker.
+	*/
+	template<typename Left, typename Right>
+	void invoke(Left&& left, Right&& right)
+	{
+		worker_context* context = current_worker();
+
+		if (context == nullptr)
+		{
+			run([&] { invoke(left, right); });
+			return;
+		}
+
+		detail::function_task<typename std::remove_reference<Right>::type> task(right);
+		schedule(context->index, &task);
+
+		try
+		{
+			left();
+		}
+		catch (...)
+		{
+			// the task lives on this stack frame, it must complete before we unwind.
+			if (queues[context->index]->pop_if(&task))
+			{
+				pending.fetch_sub(1);
+			}
+			else
+			{
+				wait_for(task, context->index);
+			}
+
+			throw;
+		}
+
+		if (queues[context->index]->pop_if(&task))
+		{
+			pending.fetch_sub(1);
+			right();
+		}
+		else
+		{
+			wait_for(task, context->index);
+			task.rethrow_if_failed();
+		}
+	}
+};
+
+/**
+* Returns the thread pool used by the library when no other pool is specified.
+* It is created on first use, with one worker per hardware thread.
+*/
+inline thread_pool& default_thread_pool()
+{
+	static thread_pool pool;
+	return pool;
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_EXECUTORS_THREAD_POOL_H_INCLUDED
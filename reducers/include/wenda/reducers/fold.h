@@ -13,6 +13,10 @@
 #include <utility>
 #include <type_traits>
 
+#include "detail/is_range.h"
+#include "detail/is_executor.h"
+#include "detail/is_splittable.h"
+
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
 namespace detail
@@ -28,11 +32,76 @@ namespace detail
 		static const bool value = type::value;
 	};
 
+	template<typename T, typename ReduceFunction, typename CombineFunction, typename Executor>
+	class has_executor_foldable_member_function
+	{
+		template<typename U> static std::true_type test(
+			typename std::add_pointer<decltype(std::declval<U>().fold(
+			    std::declval<ReduceFunction>(),
+			    std::declval<CombineFunction>(),
+			    std::declval<Executor&>()))>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<T>(nullptr)) type;
+		static const bool value = type::value;
+	};
+
 	template<typename Foldable, typename Reduce, typename Combine>
 	struct fold_return_type
 	{
 		typedef typename std::result_of<Combine()>::type type;
 	};
+
+	/**
+    * This struct is a simple trait to determine whether the generic overload for ranges
+    * should be enabled.
+    * It is enabled in the case that the type is a range, and that it has no fold() member function.
+	*/
+    template<typename Range, typename Function, typename Element>
+	struct enable_range_fold
+	{
+		static const bool value =
+			!has_foldable_member_function<Range, Function, Element>::value &&
+			is_range<Range>::value;
+	};
+	/**
+    * This struct is a simple trait to determine whether the generic overload for splittable reducibles
+    * should be enabled.
+    * It is enabled in the case that the type is splittable, and that it is neither a range nor has a fold() member function.
+	*/
+	template<typename Splittable, typename Function, typename Element>
+	struct enable_splittable_fold
+	{
+		static const bool value =
+			!has_foldable_member_function<Splittable, Function, Element>::value &&
+			!is_range<Splittable>::value &&
+			is_splittable<Splittable>::value;
+	};
+
+	template<typename Splittable, typename Function, typename Element, typename Executor>
+	struct enable_splittable_executor_fold
+	{
+		static const bool value =
+			!has_executor_foldable_member_function<Splittable, Function, Element, Executor>::value &&
+			!is_range<Splittable>::value &&
+			is_splittable<Splittable>::value &&
+			is_executor<Executor>::value;
+	};
+
+	/**
+    * @internal
+    * Trait to determine whether a reducible can be folded on an executor, so that
+    * it can be folded in parallel when it is nested in another fold.
+    * Transformers specialize this trait to forward to the reducible they transform.
+	*/
+	template<typename T, typename ReduceFunction, typename CombineFunction, typename Executor>
+	struct is_executor_foldable
+	{
+		static const bool value =
+			has_executor_foldable_member_function<T, ReduceFunction, CombineFunction, Executor>::value ||
+			is_range<T>::value ||
+			is_splittable<T>::value;
+	};
 }
 
 /**
@@ -58,16 +127,84 @@ fold(Foldable&& foldable, ReduceFunction&& reduce, CombineFunction&& combine)
 	return foldable.fold(std::forward<ReduceFunction>(reduce), std::forward<CombineFunction>(combine));
 }
 
+/**
+* Overload of fold() for C++ ranges.
+* It is declared here so that the transformers can find it when folding a range,
+* and is defined in range_foldable.h.
+*/
+template<typename Range, typename Reduce, typename Combine>
+typename std::enable_if<
+    detail::enable_range_fold<Range, Reduce, Combine>::value,
+    typename std::decay<typename std::result_of<Combine()>::type>::type
+>::type
+fold(Range&& range, Reduce&& reduce, Combine&& combine);
+
+/**
+* Folds the given @p foldable using the given reduction and combination functions, running on the given @p executor.
+* This is the default implementation for types that implement a fold member function taking an executor.
+* @param foldable The foldable object to be folded.
+* @param reduce The reduction function. It must be an invokable object with a signature compatible with (Seed, Value) -> Seed.
+* @param combine The combination function, as for the three argument version of fold().
+* @param executor The executor on which the fold is run, for example a @ref thread_pool or an @ref inline_executor.
+* @returns The result of the aggregation over the given foldable.
+*/
+template<typename Foldable, typename ReduceFunction, typename CombineFunction, typename Executor>
+typename std::enable_if<
+	detail::has_executor_foldable_member_function<Foldable, ReduceFunction, CombineFunction, typename std::remove_reference<Executor>::type>::value &&
+	detail::is_executor<Executor>::value,
+	typename std::decay<typename std::result_of<CombineFunction()>::type>::type
+>::type
+fold(Foldable&& foldable, ReduceFunction&& reduce, CombineFunction&& combine, Executor&& executor)
+{
+	return foldable.fold(std::forward<ReduceFunction>(reduce), std::forward<CombineFunction>(combine), executor);
+}
+
+/**
+* Overload of fold() for C++ ranges, running on the given executor.
+* It is declared here so that the transformers can find it when folding a range,
+* and is defined in range_foldable.h.
+*/
+template<typename Range, typename Reduce, typename Combine, typename Executor>
+typename std::enable_if<
+    detail::enable_range_fold<Range, Reduce, Combine>::value && detail::is_executor<Executor>::value,
+    typename std::decay<typename std::result_of<Combine()>::type>::type
+>::type
+fold(Range&& range, Reduce&& reduce, Combine&& combine, Executor&& executor);
+
+/**
+* Overload of fold() for splittable reducibles.
+* It is declared here so that the transformers can find it when folding a splittable reducible,
+* and is defined in splittable_foldable.h.
+*/
+template<typename Splittable, typename Reduce, typename Combine>
+typename std::enable_if<
+	detail::enable_splittable_fold<Splittable, Reduce, Combine>::value,
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+>::type
+fold(Splittable&& splittable, Reduce&& reduce, Combine&& combine);
+
+/**
+* Overload of fold() for splittable reducibles, running on the given executor.
+* It is declared here so that the transformers can find it when folding a splittable reducible,
+* and is defined in splittable_foldable.h.
+*/
+template<typename Splittable, typename Reduce, typename Combine, typename Executor>
+typename std::enable_if<
+	detail::enable_splittable_executor_fold<Splittable, Reduce, Combine, typename std::remove_reference<Executor>::type>::value,
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+>::type
+fold(Splittable&& splittable, Reduce&& reduce, Combine&& combine, Executor&& executor);
+
 namespace detail
 {
 	template<typename ReduceFunction, typename CombineFunction>
 	struct fold_expression
 	{
-		CombineFunction combine;
 		ReduceFunction reduce;
+		CombineFunction combine;
 
 		fold_expression(ReduceFunction reduce, CombineFunction combine)
-			: combine(std::move(combine)), reduce(std::move(reduce))
+			: reduce(std::move(reduce)), combine(std::move(combine))
 		{
 		}
 	};
@@ -76,14 +213,38 @@ namespace detail
 	typename std::decay<typename std::result_of<CombineFunction()>::type>::type
 	operator|(Foldable&& foldable, fold_expression<ReduceFunction, CombineFunction> const& expr)
 	{
-		return fold(std::forward<Foldable>(foldable), expr.function, expr.element);
+		return fold(std::forward<Foldable>(foldable), expr.reduce, expr.combine);
 	}
 
     template<typename Foldable, typename ReduceFunction, typename CombineFunction>
     typename std::decay<typename std::result_of<CombineFunction()>::type>::type
 	operator|(Foldable&& foldable, fold_expression<ReduceFunction, CombineFunction>&& expr)
 	{
-		return fold(std::forward<Foldable>(foldable), std::move(expr.combine), std::move(expr.reduce));
+		return fold(std::forward<Foldable>(foldable), std::move(expr.reduce), std::move(expr.combine));
+	}
+
+	/**
+    * This struct holds the arguments of a fold on a given executor in a pipe expression.
+    * The executor is held by reference if it was given as an l-value, and by value otherwise.
+	*/
+	template<typename ReduceFunction, typename CombineFunction, typename Executor>
+	struct executor_fold_expression
+	{
+		ReduceFunction reduce;
+		CombineFunction combine;
+		Executor executor;
+
+		executor_fold_expression(ReduceFunction reduce, CombineFunction combine, Executor&& executor)
+			: reduce(std::move(reduce)), combine(std::move(combine)), executor(std::forward<Executor>(executor))
+		{
+		}
+	};
+
+	template<typename Foldable, typename ReduceFunction, typename CombineFunction, typename Executor>
+	typename std::decay<typename std::result_of<CombineFunction()>::type>::type
+	operator|(Foldable&& foldable, executor_fold_expression<ReduceFunction, CombineFunction, Executor>&& expr)
+	{
+		return fold(std::forward<Foldable>(foldable), std::move(expr.reduce), std::move(expr.combine), expr.executor);
 	}
 }
 
@@ -92,13 +253,34 @@ namespace detail
 * @sa fold()
 */
 template<typename ReduceFunction, typename CombineFunction>
-detail::fold_expression<typename std::decay<CombineFunction>::type, typename std::decay<ReduceFunction>::type>
+detail::fold_expression<typename std::decay<ReduceFunction>::type, typename std::decay<CombineFunction>::type>
 fold(ReduceFunction&& reduce, CombineFunction&& combine)
 {
-	typedef detail::fold_expression<typename std::decay<CombineFunction>::type, typename std::decay<ReduceFunction>::type> return_t;
-	return return_t(reduce, combine);
+	typedef detail::fold_expression<typename std::decay<ReduceFunction>::type, typename std::decay<CombineFunction>::type> return_t;
+	return return_t(std::forward<ReduceFunction>(reduce), std::forward<CombineFunction>(combine));
+}
+
+/**
+* Version of fold() on a given executor that is used with the pipe expressions.
+* @code
+* data | fold(reduce, combine, pool);
+* @endcode
+* @sa fold()
+*/
+template<typename ReduceFunction, typename CombineFunction, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	detail::executor_fold_expression<typename std::decay<ReduceFunction>::type, typename std::decay<CombineFunction>::type, Executor>
+>::type
+fold(ReduceFunction&& reduce, CombineFunction&& combine, Executor&& executor)
+{
+	typedef detail::executor_fold_expression<typename std::decay<ReduceFunction>::type, typename std::decay<CombineFunction>::type, Executor> return_t;
+	return return_t(std::forward<ReduceFunction>(reduce), std::forward<CombineFunction>(combine), std::forward<Executor>(executor));
 }
 
 WENDA_REDUCERS_NAMESPACE_END
 
-#endif
\ No newline at end of file
+#include "foldables/range_foldable.h"
+#include "foldables/splittable_foldable.h"
+
+#endif // WENDA_REDUCERS_FOLD_H_INCLUDED
\ No newline at end of file
@@ -0,0 +1,291 @@
+#ifndef WENDA_REDUCERS_FOLD_ASYNC_H_INCLUDED
+#define WENDA_REDUCERS_FOLD_ASYNC_H_INCLUDED
+
+/**
+* @file fold_async.h
+* This file contains the fold_async() function, which starts a fold in the background
+* and returns a std::future to its result, so that the calling thread is not blocked while the fold runs.
+*/
+
+#include "reducers_common.h"
+
+#include <exception>
+#include <future>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include "fold.h"
+#include "detail/is_executor.h"
+#include "executors/thread_pool.h"
+#include "monoid/monoid.h"
+#include "monoid/monoid_fold.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	template<typename T>
+	class has_post_member_function
+	{
+		typedef void(*nullary_t)();
+
+		template<typename U> static std::true_type test(
+			typename std::add_pointer<decltype(std::declval<U&>().post(std::declval<nullary_t>()))>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<typename std::remove_reference<T>::type>(nullptr)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Runs the given function in the background on the given executor.
+    * Executors that cannot run work without waiting for it, such as the @ref inline_executor, run it on the calling thread.
+	*/
+	template<typename Executor, typename Function>
+	typename std::enable_if<has_post_member_function<Executor>::value>::type
+	post_to(Executor& executor, Function&& function)
+	{
+		executor.post(std::forward<Function>(function));
+	}
+
+	template<typename Executor, typename Function>
+	typename std::enable_if<!has_post_member_function<Executor>::value>::type
+	post_to(Executor&, Function&& function)
+	{
+		function();
+	}
+
+	/**
+    * @internal
+    * This struct holds the state of a fold that runs in the background.
+    * It owns the foldable and the functions, and holds the executor by reference if it was given as an l-value.
+    * A foldable pipeline owned here still refers to the l-value ranges it was built on.
+	*/
+	template<typename Foldable, typename ReduceFunction, typename CombineFunction, typename Executor>
+	struct async_fold_state
+	{
+		typedef typename std::decay<typename std::result_of<CombineFunction()>::type>::type value_t;
+
+		Foldable foldable;
+		ReduceFunction reduce;
+		CombineFunction combine;
+		Executor executor;
+		std::promise<value_t> promise;
+
+		async_fold_state(Foldable foldable, ReduceFunction reduce, CombineFunction combine, Executor&& executor)
+			: foldable(std::move(foldable)), reduce(std::move(reduce)), combine(std::move(combine)), executor(std::forward<Executor>(executor))
+		{
+		}
+
+		void operator()()
+		{
+			try
+			{
+				promise.set_value(fold(std::move(foldable), reduce, combine, executor));
+			}
+			catch (...)
+			{
+				promise.set_exception(std::current_exception());
+			}
+		}
+	};
+
+	template<typename Foldable, typename ReduceFunction, typename CombineFunction, typename Executor>
+	std::future<typename std::decay<typename std::result_of<CombineFunction()>::type>::type>
+	start_fold_async(Foldable&& foldable, ReduceFunction&& reduce, CombineFunction&& combine, Executor&& executor)
+	{
+		typedef async_fold_state<
+			typename std::decay<Foldable>::type,
+			typename std::decay<ReduceFunction>::type,
+			typename std::decay<CombineFunction>::type,
+			Executor
+		> state_t;
+
+		std::shared_ptr<state_t> state = std::make_shared<state_t>(
+			std::forward<Foldable>(foldable),
+			std::forward<ReduceFunction>(reduce),
+			std::forward<CombineFunction>(combine),
+			std::forward<Executor>(executor));
+
+		auto result = state->promise.get_future();
+		post_to(state->executor, [state] { (*state)(); });
+		return result;
+	}
+}
+
+/**
+* Starts folding the given @p foldable in the background on the given @p executor, and returns immediately.
+* The foldable and the functions are moved or copied into the background task, hence an l-value range is copied.
+* Pipelines such as data | map(f) are copied as well, but they hold l-value ranges such as data by reference,
+* so that the ranges a pipeline was built on must outlive the returned future.
+* The executor is held by reference if it is an l-value, and must then outlive the fold.
+* Executors that cannot run work in the background, such as the @ref inline_executor, fold on the calling thread before returning.
+* @param foldable The foldable object to be folded.
+* @param reduce The reduction function, as for fold().
+* @param combine The combination function, as for fold().
+* @param executor The executor on which to run the fold. It may provide a post(f) member function to run f without waiting for it.
+* @returns A future that becomes ready with the result of the fold, or with the exception thrown while folding.
+*/
+template<typename Foldable, typename ReduceFunction, typename CombineFunction, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	std::future<typename std::decay<typename std::result_of<CombineFunction()>::type>::type>
+>::type
+fold_async(Foldable&& foldable, ReduceFunction&& reduce, CombineFunction&& combine, Executor&& executor)
+{
+	return detail::start_fold_async(
+		std::forward<Foldable>(foldable),
+		std::forward<ReduceFunction>(reduce),
+		std::forward<CombineFunction>(combine),
+		std::forward<Executor>(executor));
+}
+
+/**
+* Starts folding the given @p foldable in the background on the @ref default_thread_pool(), and returns immediately.
+* @sa fold_async(Foldable&&, ReduceFunction&&, CombineFunction&&, Executor&&)
+*/
+template<typename Foldable, typename ReduceFunction, typename CombineFunction>
+typename std::enable_if<
+	!detail::is_executor<CombineFunction>::value,
+	std::future<typename std::decay<typename std::result_of<CombineFunction()>::type>::type>
+>::type
+fold_async(Foldable&& foldable, ReduceFunction&& reduce, CombineFunction&& combine)
+{
+	return detail::start_fold_async(
+		std::forward<Foldable>(foldable),
+		std::forward<ReduceFunction>(reduce),
+		std::forward<CombineFunction>(combine),
+		default_thread_pool());
+}
+
+/**
+* Starts folding the given @p foldable over the structure of the given @p Monoid in the background on the given @p executor.
+* @tparam Monoid The monoid structure over which to fold the @p foldable.
+* @returns A future that becomes ready with the result of the fold.
+*/
+template<typename Monoid, typename Foldable, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	std::future<typename monoid_traits<Monoid>::element_t>
+>::type
+fold_async(Foldable&& foldable, Executor&& executor)
+{
+	typedef detail::monoid_combine<Monoid> combine_t;
+	typedef typename detail::monoid_operation<Monoid, typename detail::executor_kernels<Executor>::type>::type reduce_t;
+	return detail::start_fold_async(std::forward<Foldable>(foldable), reduce_t(), combine_t(), std::forward<Executor>(executor));
+}
+
+/**
+* Starts folding the given @p foldable over the structure of the given @p Monoid in the background on the @ref default_thread_pool().
+* @tparam Monoid The monoid structure over which to fold the @p foldable.
+* @returns A future that becomes ready with the result of the fold.
+*/
+template<typename Monoid, typename Foldable>
+typename std::enable_if<
+	!detail::is_executor<Foldable>::value,
+	std::future<typename monoid_traits<Monoid>::element_t>
+>::type
+fold_async(Foldable&& foldable)
+{
+	typedef detail::monoid_combine<Monoid> combine_t;
+	typedef typename detail::monoid_operation<Monoid>::type reduce_t;
+	return detail::start_fold_async(std::forward<Foldable>(foldable), reduce_t(), combine_t(), default_thread_pool());
+}
+
+namespace detail
+{
+	/**
+    * This struct holds the arguments of a background fold in a pipe expression.
+    * The executor is held by reference if it was given as an l-value, and by value otherwise.
+	*/
+	template<typename ReduceFunction, typename CombineFunction, typename Executor>
+	struct async_fold_expression
+	{
+		ReduceFunction reduce;
+		CombineFunction combine;
+		Executor executor;
+
+		async_fold_expression(ReduceFunction reduce, CombineFunction combine, Executor&& executor)
+			: reduce(std::move(reduce)), combine(std::move(combine)), executor(std::forward<Executor>(executor))
+		{
+		}
+	};
+
+	template<typename Foldable, typename ReduceFunction, typename CombineFunction, typename Executor>
+	std::future<typename std::decay<typename std::result_of<CombineFunction()>::type>::type>
+	operator|(Foldable&& foldable, async_fold_expression<ReduceFunction, CombineFunction, Executor>&& expr)
+	{
+		return start_fold_async(std::forward<Foldable>(foldable), std::move(expr.reduce), std::move(expr.combine), std::forward<Executor>(expr.executor));
+	}
+}
+
+/**
+* Version of fold_async() on a given executor that is used with the pipe expressions.
+* @code
+* std::future<int> result = data | fold_async(reduce, combine, pool);
+* @endcode
+* @sa fold_async()
+*/
+template<typename ReduceFunction, typename CombineFunction, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	detail::async_fold_expression<typename std::decay<ReduceFunction>::type, typename std::decay<CombineFunction>::type, Executor>
+>::type
+fold_async(ReduceFunction&& reduce, CombineFunction&& combine, Executor&& executor)
+{
+	typedef detail::async_fold_expression<typename std::decay<ReduceFunction>::type, typename std::decay<CombineFunction>::type, Executor> return_t;
+	return return_t(std::forward<ReduceFunction>(reduce), std::forward<CombineFunction>(combine), std::forward<Executor>(executor));
+}
+
+/**
+* Version of fold_async() on the @ref default_thread_pool() that is used with the pipe expressions.
+* @sa fold_async()
+*/
+template<typename ReduceFunction, typename CombineFunction>
+detail::async_fold_expression<typename std::decay<ReduceFunction>::type, typename std::decay<CombineFunction>::type, thread_pool&>
+fold_async(ReduceFunction&& reduce, CombineFunction&& combine)
+{
+	typedef detail::async_fold_expression<typename std::decay<ReduceFunction>::type, typename std::decay<CombineFunction>::type, thread_pool&> return_t;
+	return return_t(std::forward<ReduceFunction>(reduce), std::forward<CombineFunction>(combine), default_thread_pool());
+}
+
+/**
+* Creates an object, that when combined with a foldable through the bitwise-or operator,
+* starts folding the given foldable in the background using the structure of the given monoid, on the given executor.
+* @code
+* std::future<long long> total = data | map(f) | fold_async<additive_monoid<long long>>(pool);
+* @endcode
+* @tparam Monoid A type describing the structure of the monoid that is folded over.
+* @returns An unspecified object, that when combined with a foldable, returns a future to the result of the fold.
+*/
+template<typename Monoid, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	detail::async_fold_expression<typename detail::monoid_operation<Monoid, typename detail::executor_kernels<Executor>::type>::type, detail::monoid_combine<Monoid>, Executor>
+>::type
+fold_async(Executor&& executor)
+{
+	typedef typename detail::monoid_operation<Monoid, typename detail::executor_kernels<Executor>::type>::type reduce_t;
+	typedef detail::async_fold_expression<reduce_t, detail::monoid_combine<Monoid>, Executor> return_t;
+	return return_t(reduce_t(), detail::monoid_combine<Monoid>(), std::forward<Executor>(executor));
+}
+
+/**
+* Creates an object, that when combined with a foldable through the bitwise-or operator,
+* starts folding the given foldable in the background using the structure of the given monoid, on the @ref default_thread_pool().
+* @tparam Monoid A type describing the structure of the monoid that is folded over.
+* @returns An unspecified object, that when combined with a foldable, returns a future to the result of the fold.
+*/
+template<typename Monoid>
+detail::async_fold_expression<typename detail::monoid_operation<Monoid>::type, detail::monoid_combine<Monoid>, thread_pool&>
+fold_async()
+{
+	typedef detail::async_fold_expression<typename detail::monoid_operation<Monoid>::type, detail::monoid_combine<Monoid>, thread_pool&> return_t;
+	return return_t(typename detail::monoid_operation<Monoid>::type(), detail::monoid_combine<Monoid>(), default_thread_pool());
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_FOLD_ASYNC_H_INCLUDED
@@ -0,0 +1,280 @@
+#ifndef WENDA_REDUCERS_FOLD_INTO_H_INCLUDED
+#define WENDA_REDUCERS_FOLD_INTO_H_INCLUDED
+
+/**
+* @file fold_into.h
+* This file implements fold_into(), the parallel counterpart of into_container(), which materializes
+* the elements of a foldable into a new container on an executor, in order.
+* Reducibles that compute their elements by index, such as maps over random access ranges or over sequences
+* of integers, are written directly into the storage of the container, by ranges of indices in parallel.
+* Other foldables, such as filtered or collected ones, are folded into a buffer per chunk, and the buffers are combined
+* in order. An exclusive scan of the sizes of the buffers then gives their offsets in the container, and they are
+* moved into it in parallel.
+* @code
+* auto selected = rows | filter(is_selected) | fold_into<std::vector<row>>(pool);
+* @endcode
+*/
+
+#include "reducers_common.h"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fold.h"
+#include "into.h"
+#include "detail/indexed_reducible.h"
+#include "detail/is_executor.h"
+#include "detail/parallel_reduce.h"
+#include "executors/thread_pool.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * The seed of a buffered fold_into(), which holds the buffers of a sequence of chunks in order.
+    * The elements are appended to the last buffer, and the buffers of the chunks that precede it are complete.
+	*/
+	template<typename T>
+	struct into_chunks
+	{
+		std::vector<std::vector<T>> complete;
+		std::vector<T> last;
+	};
+
+	/**
+    * @internal
+    * Appends elements to the last buffer of an @ref into_chunks seed, in place.
+    * Reducibles that accumulate by value are given the seed back in return.
+    * Blocks of elements are appended at once, so that the elements that filters compact are copied in bulk.
+	*/
+	template<typename T>
+	struct into_chunks_reducer
+	{
+		template<typename Value>
+		void operator()(into_chunks<T>& seed, Value&& value) const
+		{
+			seed.last.push_back(std::forward<Value>(value));
+		}
+
+		template<typename Value>
+		into_chunks<T> operator()(into_chunks<T>&& seed, Value&& value) const
+		{
+			seed.last.push_back(std::forward<Value>(value));
+			return std::move(seed);
+		}
+
+		template<typename U>
+		into_chunks<T> reduce_block(into_chunks<T> seed, U const* first, U const* last) const
+		{
+			seed.last.insert(seed.last.end(), first, last);
+			return seed;
+		}
+	};
+
+	/**
+    * @internal
+    * Combines the chunks of two @ref into_chunks seeds, where the left one precedes the right one, without copying any element.
+	*/
+	template<typename T>
+	struct into_chunks_combine
+	{
+		into_chunks<T> operator()() const
+		{
+			return into_chunks<T>();
+		}
+
+		into_chunks<T> operator()(into_chunks<T> left, into_chunks<T> right) const
+		{
+			if (!left.last.empty())
+			{
+				left.complete.push_back(std::move(left.last));
+			}
+
+			for (auto& chunk : right.complete)
+			{
+				left.complete.push_back(std::move(chunk));
+			}
+
+			left.last = std::move(right.last);
+			return left;
+		}
+	};
+
+	/**
+    * @internal
+    * Moves the buffers of the given chunks into the container in parallel, each at the offset given by the exclusive scan of their sizes.
+	*/
+	template<typename Container, typename T, typename Executor>
+	void scatter_chunks(Container& container, into_chunks<T>&& result, Executor& executor)
+	{
+		typedef typename std::iterator_traits<typename Container::iterator>::difference_type difference_t;
+
+		std::vector<std::vector<T>>& chunks = result.complete;
+
+		if (!result.last.empty())
+		{
+			chunks.push_back(std::move(result.last));
+		}
+
+		std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+		for (std::size_t i = 0; i < chunks.size(); ++i)
+		{
+			offsets[i + 1] = offsets[i] + chunks[i].size();
+		}
+
+		container.resize(offsets.back());
+		auto destination = container.begin();
+
+		auto leaf = [&](std::size_t first, std::size_t last, std::size_t moved) -> std::size_t
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				std::move(chunks[i].begin(), chunks[i].end(), destination + static_cast<difference_t>(offsets[i]));
+				moved += chunks[i].size();
+				std::vector<T>().swap(chunks[i]);
+			}
+
+			return moved;
+		};
+
+		parallel_reduce_index(0, chunks.size(), std::size_t(0), leaf, std::plus<std::size_t>(), executor);
+	}
+
+	/**
+    * @internal
+    * Materializes a reducible whose elements are accessible by index, by writing them directly into the container in parallel.
+	*/
+	template<typename Container, typename Foldable, typename Executor>
+	void fold_into_container(Container& container, Foldable const& foldable, Executor& executor, std::true_type)
+	{
+		typedef indexed_reducible<Foldable> indexed_t;
+		typedef typename std::iterator_traits<typename Container::iterator>::difference_type difference_t;
+
+		container.resize(indexed_t::size(foldable));
+		auto destination = container.begin();
+
+		auto leaf = [&](std::size_t first, std::size_t last, std::size_t written) -> std::size_t
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				destination[static_cast<difference_t>(i)] = indexed_t::at(foldable, i);
+			}
+
+			return written + (last - first);
+		};
+
+		parallel_reduce_index(0, container.size(), std::size_t(0), leaf, std::plus<std::size_t>(), executor);
+	}
+
+	/**
+    * @internal
+    * Materializes a foldable by folding it into buffers per chunk, which are then moved into the container.
+	*/
+	template<typename Container, typename Foldable, typename Executor>
+	void fold_into_container(Container& container, Foldable&& foldable, Executor& executor, std::false_type)
+	{
+		typedef typename Container::value_type value_t;
+
+		into_chunks<value_t> result = fold(std::forward<Foldable>(foldable), into_chunks_reducer<value_t>(), into_chunks_combine<value_t>(), executor);
+		scatter_chunks(container, std::move(result), executor);
+	}
+
+	template<typename Container>
+	struct fold_into_expression
+	{
+	};
+
+	/**
+    * @internal
+    * This struct holds the executor of a fold_into() in a pipe expression.
+    * The executor is held by reference if it was given as an l-value, and by value otherwise.
+	*/
+	template<typename Container, typename Executor>
+	struct executor_fold_into_expression
+	{
+		Executor executor;
+
+		executor_fold_into_expression(Executor&& executor)
+			: executor(std::forward<Executor>(executor))
+		{
+		}
+	};
+}
+
+/**
+* Materializes the given foldable into a new container, in parallel on the given executor.
+* The elements are in the same order as they would be reduced in.
+* @tparam Container The type of the container. It must have random access iterators and be resizable, such as std::vector.
+* @param foldable The foldable to materialize.
+* @param executor The executor on which the foldable is materialized.
+* @returns The container holding the elements of the foldable.
+*/
+template<typename Container, typename Foldable, typename Executor>
+typename std::enable_if<detail::is_executor<Executor>::value, Container>::type
+fold_into(Foldable&& foldable, Executor&& executor)
+{
+	static_assert(detail::is_resizable_container<Container>::value, "fold_into() requires a resizable container with random access iterators.");
+
+	typedef detail::indexed_reducible<typename std::decay<Foldable>::type> indexed_t;
+
+	Container container;
+	detail::fold_into_container(container, std::forward<Foldable>(foldable), executor, std::integral_constant<bool, indexed_t::value>());
+	return container;
+}
+
+/**
+* Materializes the given foldable into a new container, in parallel on the @ref default_thread_pool().
+*/
+template<typename Container, typename Foldable>
+typename std::enable_if<!detail::is_executor<Foldable>::value, Container>::type
+fold_into(Foldable&& foldable)
+{
+	return fold_into<Container>(std::forward<Foldable>(foldable), default_thread_pool());
+}
+
+/**
+* Version of fold_into() on the @ref default_thread_pool() that is used with the pipe expressions.
+*/
+template<typename Container>
+detail::fold_into_expression<Container> fold_into()
+{
+	return detail::fold_into_expression<Container>();
+}
+
+/**
+* Version of fold_into() on a given executor that is used with the pipe expressions.
+* @code
+* auto result = data | map(f) | fold_into<std::vector<int>>(pool);
+* @endcode
+*/
+template<typename Container, typename Executor>
+typename std::enable_if<detail::is_executor<Executor>::value, detail::executor_fold_into_expression<Container, Executor>>::type
+fold_into(Executor&& executor)
+{
+	return detail::executor_fold_into_expression<Container, Executor>(std::forward<Executor>(executor));
+}
+
+namespace detail
+{
+	template<typename Foldable, typename Container>
+	Container operator|(Foldable&& foldable, fold_into_expression<Container>)
+	{
+		return fold_into<Container>(std::forward<Foldable>(foldable));
+	}
+
+	template<typename Foldable, typename Container, typename Executor>
+	Container operator|(Foldable&& foldable, executor_fold_into_expression<Container, Executor>&& expr)
+	{
+		return fold_into<Container>(std::forward<Foldable>(foldable), expr.executor);
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_FOLD_INTO_H_INCLUDED
@@ -4,7 +4,9 @@
 /**
 * @file range_foldable.h
 * This file contains a basic implementation of the fold() function for
-* C++ ranges. The implementation is based on Microsoft's parallel patterns library for VC.
+* C++ ranges. The ranges are split and reduced in parallel on the library's work-stealing @ref thread_pool.
+* Contiguous ranges of arithmetic values folded with the operation of a built-in monoid are reduced with the kernels in simd_reduce.h,
+* or with the portable kernels when the fold is deterministic.
 */
 
 #include "../reducers_common.h"
@@ -13,33 +15,17 @@
 #include <type_traits>
 #include <iterator>
 
-#ifdef _MSC_VER
-#include <ppl.h>
-#endif
-
 #include "../detail/is_range.h"
+#include "../detail/block_reduce.h"
+#include "../detail/parallel_reduce.h"
+#include "../detail/simd_reduce.h"
+#include "../executors/thread_pool.h"
 #include "../reducibles/iterator_pair_reducible.h"
 #include "../reduce.h"
 #include "../fold.h"
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
-namespace detail
-{
-	/**
-    * This struct is a simple trait to determine whether the generic overload for ranges
-    * should be enabled.
-    * It is enabled in the case that the type is a range, and that it has no reducible() member function.
-	*/
-    template<typename Range, typename Function, typename Element>
-	struct enable_range_fold
-	{
-		static const bool value =
-			!has_foldable_member_function<Range, Function, Element>::value &&
-			is_range<Range>::value;
-	};
-}
-
 namespace detail
 {
     template<typename Reduce>
@@ -59,26 +45,84 @@ namespace detail
 		}
 	};
 
-    template<typename Range, typename Reduce, typename Combine>
+	/**
+    * @internal
+    * Trait to determine whether the leaves of a fold can be reduced with the kernels in simd_reduce.h,
+    * which requires the fold to be over values of the same type as the elements of the range.
+	*/
+	template<typename Range, typename Reduce, typename Combine>
+	struct is_simd_foldable
+	{
+		typedef typename std::decay<Reduce>::type operation_t;
+		typedef typename std::decay<typename std::result_of<Combine()>::type>::type value_t;
+
+		static const bool value =
+			is_simd_reducible<Range, operation_t>::value &&
+			std::is_same<value_t, typename simd_operation_traits<operation_t>::element_t>::value;
+		typedef std::integral_constant<bool, value> type;
+	};
+
+    template<typename Range, typename Reduce, typename Combine, typename Executor>
 	typename std::decay<typename std::result_of<Combine()>::type>::type 
-	fold_range_impl(Range&& range, Reduce&& reduce, Combine&& combine)
+	fold_range_elements(Range&& range, Reduce&& reduce, Combine&& combine, Executor& executor, std::false_type)
 	{
 		using std::begin;
 		using std::end;
-#ifdef _MSC_VER
-		return concurrency::parallel_reduce(
-			begin(range), end(range), 
+		return parallel_reduce(
+			begin(range), end(range),
+			combine(),
+			range_reduce_function<typename std::decay<Reduce>::type>(std::forward<Reduce>(reduce)),
+			combine,
+			executor);
+	}
+
+	template<typename Range, typename Reduce, typename Combine, typename Executor>
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+	fold_range_elements(Range&& range, Reduce&& reduce, Combine&& combine, Executor& executor, std::true_type)
+	{
+		// the leaves of contiguous ranges are delimited by pointers, so that they are reduced as blocks.
+		auto first = contiguous_data(range);
+		return parallel_reduce(
+			first, first + contiguous_size(range),
 			combine(),
 			range_reduce_function<typename std::decay<Reduce>::type>(std::forward<Reduce>(reduce)),
-            combine);
-#else
-		static_assert(false, "no implementation of fold_range_impl available for your platform.");
-#endif
+			combine,
+			executor);
+	}
+
+    template<typename Range, typename Reduce, typename Combine, typename Executor>
+	typename std::decay<typename std::result_of<Combine()>::type>::type 
+	fold_range_impl(Range&& range, Reduce&& reduce, Combine&& combine, Executor& executor, std::false_type)
+	{
+		typedef typename is_contiguous_range<Range>::type contiguous_t;
+		return fold_range_elements(std::forward<Range>(range), std::forward<Reduce>(reduce), std::forward<Combine>(combine), executor, contiguous_t());
+	}
+
+	template<typename Range, typename Reduce, typename Combine, typename Executor>
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+	fold_range_impl(Range&& range, Reduce&& reduce, Combine&& combine, Executor& executor, std::true_type)
+	{
+		auto first = contiguous_data(range);
+		return parallel_reduce(
+			first, first + contiguous_size(range),
+			combine(),
+			contiguous_reduce_function<typename std::decay<Reduce>::type, typename executor_kernels<Executor>::type>(reduce),
+			combine,
+			executor);
+	}
+
+    template<typename Range, typename Reduce, typename Combine, typename Executor>
+	typename std::decay<typename std::result_of<Combine()>::type>::type 
+	fold_range_impl(Range&& range, Reduce&& reduce, Combine&& combine, Executor& executor)
+	{
+		typedef typename is_simd_foldable<Range, Reduce, Combine>::type simd_t;
+		return fold_range_impl(std::forward<Range>(range), std::forward<Reduce>(reduce), std::forward<Combine>(combine), executor, simd_t());
 	}
 }
 
 /**
 * Overload of fold() for C++ ranges.
+* The range is folded on the @ref default_thread_pool().
 * @param range A C++ range that is to be folded.
 */
 template<typename Range, typename Reduce, typename Combine>
@@ -88,7 +132,22 @@ typename std::enable_if<
 >::type
 fold(Range&& range, Reduce&& reduce, Combine&& combine)
 {
-	return detail::fold_range_impl(std::forward<Range>(range), std::forward<Reduce>(reduce), std::forward<Combine>(combine));
+	return detail::fold_range_impl(std::forward<Range>(range), std::forward<Reduce>(reduce), std::forward<Combine>(combine), default_thread_pool());
+}
+
+/**
+* Overload of fold() for C++ ranges, running on the given executor.
+* @param range A C++ range that is to be folded.
+* @param executor The executor on which to run the fold.
+*/
+template<typename Range, typename Reduce, typename Combine, typename Executor>
+typename std::enable_if<
+    detail::enable_range_fold<Range, Reduce, Combine>::value && detail::is_executor<Executor>::value,
+    typename std::decay<typename std::result_of<Combine()>::type>::type
+>::type
+fold(Range&& range, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	return detail::fold_range_impl(std::forward<Range>(range), std::forward<Reduce>(reduce), std::forward<Combine>(combine), executor);
 }
 
 WENDA_REDUCERS_NAMESPACE_END
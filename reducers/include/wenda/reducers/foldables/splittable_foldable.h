@@ -0,0 +1,267 @@
+#ifndef WENDA_REDUCERS_FOLDABLE_SPLITTABLE_FOLDABLE_H_INCLUDED
+#define WENDA_REDUCERS_FOLDABLE_SPLITTABLE_FOLDABLE_H_INCLUDED
+
+/**
+* @file splittable_foldable.h
+* This file contains an implementation of the fold() function for splittable reducibles,
+* that is reducibles that provide split() and size() (see is_splittable.h).
+* They are split recursively, and the pieces are reduced in parallel on an executor,
+* which lets user defined containers take part in parallel folds without implementing fold() themselves.
+* As for ranges, folds over @ref reduced values skip the pieces after the point where they terminated.
+*/
+
+#include "../reducers_common.h"
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <type_traits>
+
+#include "../detail/is_splittable.h"
+#include "../detail/parallel_reduce.h"
+#include "../reduced.h"
+#include "../executors/partitioners.h"
+#include "../executors/thread_pool.h"
+#include "../reduce.h"
+#include "../fold.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Returns whether the given halves of a splittable reducible of the given size are both smaller than it,
+    * so that splitting makes progress.
+	*/
+	template<typename Halves>
+	bool is_proper_split(Halves const& halves, std::size_t size)
+	{
+		return splittable_size(halves.first) < size && splittable_size(halves.second) < size;
+	}
+
+	/**
+    * @internal
+    * The position of a piece of a splittable reducible in the tree of splits.
+    * The whole reducible covers the indices [0, 2^N), where N is the number of bits of std::size_t,
+    * and each split gives the upper half of the indices of a piece to its right half.
+    * Unlike the sizes of the pieces, which are only estimates, the first indices of the pieces are ordered as the pieces are.
+    * Pieces split more than N times share the index of their left half, and are then never skipped in favour of one another.
+	*/
+	struct split_position
+	{
+		std::size_t index;
+		unsigned depth;
+
+		split_position()
+			: index(0), depth(0)
+		{}
+
+		split_position(std::size_t index, unsigned depth)
+			: index(index), depth(depth)
+		{}
+
+		split_position left() const
+		{
+			return depth < std::numeric_limits<std::size_t>::digits ? split_position(index, depth + 1) : *this;
+		}
+
+		split_position right() const
+		{
+			if (depth < std::numeric_limits<std::size_t>::digits)
+			{
+				return split_position(index + (std::size_t(1) << (std::numeric_limits<std::size_t>::digits - 1 - depth)), depth + 1);
+			}
+
+			return *this;
+		}
+	};
+
+	/**
+    * @internal
+    * The state of a fold over a splittable reducible, shared by all its pieces.
+    * The pieces are identified by their @ref split_position, which is used to skip
+    * the pieces that lie after the point where the fold was terminated.
+	*/
+	template<typename Value, typename Reducer, typename Combine, typename Executor>
+	struct splittable_fold_state
+	{
+		typedef Value value_t;
+
+		Value const& identity;
+		Reducer const& reducer;
+		in_order_combine<Combine> combine;
+		Executor& executor;
+		stop_state stop;
+
+		splittable_fold_state(Value const& identity, Reducer const& reducer, Combine const& combine, Executor& executor)
+			: identity(identity), reducer(reducer), combine(combine), executor(executor)
+		{}
+
+		template<typename Splittable>
+		Value reduce_piece(Splittable const& reducible, split_position position, Value seed)
+		{
+			if (stop.is_stopped_before(position.index))
+			{
+				// this piece lies after the point where the fold terminated, its result is discarded.
+				return seed;
+			}
+
+			seed = reduce(reducible, reducer, std::move(seed));
+
+			if (is_reduced(seed))
+			{
+				stop.stop_at(position.index);
+			}
+
+			return seed;
+		}
+	};
+
+	/**
+    * @internal
+    * Splits the given reducible in halves until the pieces contain at most @p grain elements.
+	*/
+	template<typename Splittable, typename State>
+	typename State::value_t split_reduce_splittable(Splittable const& reducible, split_position position, std::size_t grain, State& state)
+	{
+		typedef typename State::value_t value_t;
+		std::size_t size = splittable_size(reducible);
+
+		if (size <= grain || state.stop.is_stopped_before(position.index))
+		{
+			return state.reduce_piece(reducible, position, state.identity);
+		}
+
+		auto halves = split_splittable(reducible);
+
+		if (!is_proper_split(halves, size))
+		{
+			return state.reduce_piece(reducible, position, state.identity);
+		}
+
+		deferred_value<value_t> left;
+		deferred_value<value_t> right;
+
+		state.executor.invoke(
+			[&] { left.set(split_reduce_splittable(halves.first, position.left(), grain, state)); },
+			[&] { right.set(split_reduce_splittable(halves.second, position.right(), grain, state)); });
+
+		return state.combine(std::move(left.get()), std::move(right.get()));
+	}
+
+	/**
+    * @internal
+    * Reduces the given reducible by lazy binary splitting, continuing from the given @p seed.
+    * The reducible is split in halves down to pieces of @p chunk elements, and the right halves
+    * are only exposed to other workers when the executor requests work.
+	*/
+	template<typename Splittable, typename State>
+	typename State::value_t lazy_reduce_splittable(Splittable const& reducible, split_position position, std::size_t chunk, typename State::value_t seed, State& state)
+	{
+		typedef typename State::value_t value_t;
+		std::size_t size = splittable_size(reducible);
+
+		if (size <= chunk || state.stop.is_stopped_before(position.index))
+		{
+			return state.reduce_piece(reducible, position, std::move(seed));
+		}
+
+		auto halves = split_splittable(reducible);
+
+		if (!is_proper_split(halves, size))
+		{
+			return state.reduce_piece(reducible, position, std::move(seed));
+		}
+
+		if (requests_work(state.executor))
+		{
+			deferred_value<value_t> left;
+			deferred_value<value_t> right;
+
+			state.executor.invoke(
+				[&] { left.set(lazy_reduce_splittable(halves.first, position.left(), chunk, std::move(seed), state)); },
+				[&] { right.set(lazy_reduce_splittable(halves.second, position.right(), chunk, value_t(state.identity), state)); });
+
+			return state.combine(std::move(left.get()), std::move(right.get()));
+		}
+
+		value_t leftValue = lazy_reduce_splittable(halves.first, position.left(), chunk, std::move(seed), state);
+
+		if (is_reduced(leftValue))
+		{
+			return leftValue;
+		}
+
+		return lazy_reduce_splittable(halves.second, position.right(), chunk, std::move(leftValue), state);
+	}
+
+	template<typename Splittable, typename State, typename Partitioner>
+	typename State::value_t partitioned_reduce_splittable(Splittable const& reducible, std::size_t grain, State& state, Partitioner const&)
+	{
+		return split_reduce_splittable(reducible, split_position(), grain, state);
+	}
+
+	template<typename Splittable, typename State>
+	typename State::value_t partitioned_reduce_splittable(Splittable const& reducible, std::size_t grain, State& state, lazy_partitioner const&)
+	{
+		return lazy_reduce_splittable(reducible, split_position(), grain, typename State::value_t(state.identity), state);
+	}
+
+	template<typename Splittable, typename Reducer, typename Combine, typename Executor>
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+	fold_splittable_impl(Splittable const& reducible, Reducer const& reducer, Combine const& combine, Executor& executor)
+	{
+		typedef typename std::decay<typename std::result_of<Combine()>::type>::type value_t;
+
+		auto partitioner = partitioner_of(executor);
+		std::size_t size = splittable_size(reducible);
+
+		if (size <= 1 || (executor.concurrency() <= 1 && may_reduce_sequentially(partitioner)))
+		{
+			return reduce(reducible, reducer, combine());
+		}
+
+		value_t identity = combine();
+		std::size_t grain = partitioner.grain_size(size, executor.concurrency());
+		splittable_fold_state<value_t, Reducer, Combine, Executor> state(identity, reducer, combine, executor);
+
+		deferred_value<value_t> result;
+		executor.run([&] { result.set(partitioned_reduce_splittable(reducible, grain, state, partitioner)); });
+		return std::move(result.get());
+	}
+}
+
+/**
+* Overload of fold() for splittable reducibles.
+* The reducible is folded on the @ref default_thread_pool().
+* @param splittable A splittable reducible that is to be folded.
+*/
+template<typename Splittable, typename Reduce, typename Combine>
+typename std::enable_if<
+	detail::enable_splittable_fold<Splittable, Reduce, Combine>::value,
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+>::type
+fold(Splittable&& splittable, Reduce&& reduce, Combine&& combine)
+{
+	return detail::fold_splittable_impl(splittable, reduce, combine, default_thread_pool());
+}
+
+/**
+* Overload of fold() for splittable reducibles, running on the given executor.
+* @param splittable A splittable reducible that is to be folded.
+* @param executor The executor on which to run the fold.
+*/
+template<typename Splittable, typename Reduce, typename Combine, typename Executor>
+typename std::enable_if<
+	detail::enable_splittable_executor_fold<Splittable, Reduce, Combine, typename std::remove_reference<Executor>::type>::value,
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+>::type
+fold(Splittable&& splittable, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	return detail::fold_splittable_impl(splittable, reduce, combine, executor);
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_FOLDABLE_SPLITTABLE_FOLDABLE_H_INCLUDED
@@ -0,0 +1,346 @@
+#ifndef WENDA_REDUCERS_GROUP_BY_H_INCLUDED
+#define WENDA_REDUCERS_GROUP_BY_H_INCLUDED
+
+/**
+* @file group_by.h
+* This file implements group_by(), which folds a foldable into a @ref group_map from keys to the aggregate,
+* under a monoid, of the elements that have each key, or of values computed from them.
+* @code
+* auto totals = amounts | group_by<additive_monoid<long long>>([](long long amount) { return amount / 100; });
+* auto perCountry = group_by<additive_monoid<double>>(sales, [](sale const& s) { return s.country; }, [](sale const& s) { return s.amount; });
+* @endcode
+* The type of the keys is that of the key function applied to the elements of the foldable. When the type of the elements
+* is not known before folding, as for splittable reducibles or sink-style collect(), the key type is named explicitly:
+* @code
+* auto counts = group_by<additive_monoid<int>, std::string>(words, [](std::string const& w) { return w; }, [](std::string const&) { return 1; });
+* @endcode
+* Each chunk of the fold accumulates into its own table in place, which is continued across the chunks a worker
+* reduces in sequence, and the tables are then merged pairwise with the operation of the monoid.
+*/
+
+#include "reducers_common.h"
+
+#include <utility>
+#include <type_traits>
+
+#include "fold.h"
+#include "group_map.h"
+#include "monoid/monoid.h"
+#include "detail/is_executor.h"
+#include "detail/reducible_element.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * The default key type of group_by(), which requests that the type of the keys is deduced from the elements of the foldable.
+	*/
+	struct deduced_key
+	{
+	};
+
+	/**
+    * @internal
+    * Determines the type of the keys of a group_by(): the given type, or the result of the key function
+    * applied to the elements of the foldable, which must then be known.
+	*/
+	template<typename Foldable, typename KeyFunction, typename Key, bool Known = reducible_element<typename std::remove_cv<typename std::remove_reference<Foldable>::type>::type>::value>
+	struct group_by_key
+	{
+		typedef Key type;
+	};
+
+	template<typename Foldable, typename KeyFunction>
+	struct group_by_key<Foldable, KeyFunction, deduced_key, true>
+	{
+		typedef typename reducible_element<typename std::remove_cv<typename std::remove_reference<Foldable>::type>::type>::type element_t;
+		typedef typename std::decay<typename std::result_of<KeyFunction const&(element_t const&)>::type>::type type;
+	};
+
+	template<typename Foldable, typename KeyFunction>
+	struct group_by_key<Foldable, KeyFunction, deduced_key, false>
+	{
+		static_assert(reducible_element<typename std::remove_cv<typename std::remove_reference<Foldable>::type>::type>::value,
+			"group_by: the type of the elements of the foldable is not known, name the key type as in group_by<Monoid, Key>()");
+	};
+
+	/**
+    * @internal
+    * Determines the type of the @ref group_map that group_by() returns, which maps the keys
+    * computed from the elements of the foldable to elements of the monoid.
+	*/
+	template<typename Foldable, typename Monoid, typename KeyFunction, typename Key>
+	struct group_by_result
+	{
+		typedef group_map<typename group_by_key<Foldable, KeyFunction, Key>::type, typename monoid_traits<Monoid>::element_t> type;
+	};
+
+	/**
+    * @internal
+    * Determines the return type of the group_by() overloads, which is only computed for the enabled overload,
+    * so that the key function is not invoked with the elements of the foldable when it is an executor.
+	*/
+	template<typename Foldable, typename Monoid, typename KeyFunction, typename Key, bool Enable>
+	struct enable_group_by
+	{
+	};
+
+	template<typename Foldable, typename Monoid, typename KeyFunction, typename Key>
+	struct enable_group_by<Foldable, Monoid, KeyFunction, Key, true>
+	{
+		typedef typename group_by_result<Foldable, Monoid, KeyFunction, Key>::type type;
+	};
+
+	/**
+    * @internal
+    * The value function of a group_by() without one, which aggregates the elements themselves.
+	*/
+	struct group_by_identity
+	{
+		template<typename Value>
+		Value&& operator()(Value&& value) const
+		{
+			return std::forward<Value>(value);
+		}
+	};
+
+	/**
+    * @internal
+    * Accumulates the value of each element in place into the aggregate of its key, which starts at the unit of the monoid.
+	*/
+	template<typename Result, typename Monoid, typename KeyFunction, typename ValueFunction>
+	struct group_by_reducer
+	{
+		typedef typename monoid_traits<Monoid>::operation_t operation_t;
+
+		KeyFunction key;
+		ValueFunction value;
+		operation_t operation;
+
+		group_by_reducer(KeyFunction key, ValueFunction value)
+			: key(std::move(key)), value(std::move(value))
+		{
+		}
+
+		template<typename Element>
+		void operator()(Result& groups, Element&& element) const
+		{
+			typename Result::key_type k = key(element);
+			auto group = groups.find(k);
+
+			if (group == groups.end())
+			{
+				group = groups.insert(typename Result::value_type(std::move(k), monoid_traits<Monoid>::unit())).first;
+			}
+
+			group->second = operation(std::move(group->second), value(std::forward<Element>(element)));
+		}
+	};
+
+	/**
+    * @internal
+    * Merges the tables of two chunks, where the left one precedes the right one.
+    * The smaller table is merged into the larger one, and the aggregates of common keys are combined in order.
+	*/
+	template<typename Result, typename Monoid>
+	struct group_by_combine
+	{
+		typedef typename monoid_traits<Monoid>::operation_t operation_t;
+
+		operation_t operation;
+
+		Result operator()() const
+		{
+			return Result();
+		}
+
+		Result operator()(Result left, Result right) const
+		{
+			if (left.size() >= right.size())
+			{
+				for (auto& entry : right)
+				{
+					auto group = left.find(entry.first);
+
+					if (group == left.end())
+					{
+						left.insert(std::move(entry));
+					}
+					else
+					{
+						group->second = operation(std::move(group->second), std::move(entry.second));
+					}
+				}
+
+				return left;
+			}
+
+			for (auto& entry : left)
+			{
+				auto group = right.find(entry.first);
+
+				if (group == right.end())
+				{
+					right.insert(std::move(entry));
+				}
+				else
+				{
+					group->second = operation(std::move(entry.second), std::move(group->second));
+				}
+			}
+
+			return right;
+		}
+	};
+
+	template<typename Monoid, typename Key, typename KeyFunction>
+	struct group_by_expression
+	{
+		KeyFunction key;
+
+		group_by_expression(KeyFunction key)
+			: key(std::move(key))
+		{
+		}
+	};
+
+	/**
+    * @internal
+    * This struct holds the key function and the executor of a group_by() in a pipe expression.
+    * The executor is held by reference if it was given as an l-value, and by value otherwise.
+	*/
+	template<typename Monoid, typename Key, typename KeyFunction, typename Executor>
+	struct executor_group_by_expression
+	{
+		KeyFunction key;
+		Executor executor;
+
+		executor_group_by_expression(KeyFunction key, Executor&& executor)
+			: key(std::move(key)), executor(std::forward<Executor>(executor))
+		{
+		}
+	};
+}
+
+/**
+* Groups the elements of the given foldable by key, and folds the values of the elements of each group over the given monoid,
+* in parallel on the given executor.
+* @tparam Monoid The monoid over which the values of each group are folded, as described by @ref monoid_traits.
+* @tparam Key The type of the keys, which is by default the type of the key function applied to the elements of the foldable.
+* @param foldable The foldable whose elements are grouped.
+* @param key The function that computes the key of an element. The keys must be hashable by std::hash.
+* @param value The function that computes the value of an element, which is aggregated under its key.
+* @param executor The executor on which the foldable is folded.
+* @returns A @ref group_map from each key to the aggregate of the values of the elements that have it.
+*/
+template<typename Monoid, typename Key = detail::deduced_key, typename Foldable, typename KeyFunction, typename ValueFunction, typename Executor>
+typename detail::enable_group_by<Foldable, Monoid, typename std::decay<KeyFunction>::type, Key, detail::is_executor<Executor>::value>::type
+group_by(Foldable&& foldable, KeyFunction&& key, ValueFunction&& value, Executor&& executor)
+{
+	typedef typename std::decay<KeyFunction>::type key_function_t;
+	typedef typename detail::group_by_result<Foldable, Monoid, key_function_t, Key>::type result_t;
+	typedef detail::group_by_reducer<result_t, Monoid, key_function_t, typename std::decay<ValueFunction>::type> reducer_t;
+	typedef detail::group_by_combine<result_t, Monoid> combine_t;
+
+	return fold(std::forward<Foldable>(foldable), reducer_t(std::forward<KeyFunction>(key), std::forward<ValueFunction>(value)), combine_t(), executor);
+}
+
+/**
+* Groups the elements of the given foldable by key, and folds the values of the elements of each group over the given monoid.
+* The foldable is folded as by the three argument version of fold().
+*/
+template<typename Monoid, typename Key = detail::deduced_key, typename Foldable, typename KeyFunction, typename ValueFunction>
+typename detail::enable_group_by<Foldable, Monoid, typename std::decay<KeyFunction>::type, Key, !detail::is_executor<ValueFunction>::value>::type
+group_by(Foldable&& foldable, KeyFunction&& key, ValueFunction&& value)
+{
+	typedef typename std::decay<KeyFunction>::type key_function_t;
+	typedef typename detail::group_by_result<Foldable, Monoid, key_function_t, Key>::type result_t;
+	typedef detail::group_by_reducer<result_t, Monoid, key_function_t, typename std::decay<ValueFunction>::type> reducer_t;
+	typedef detail::group_by_combine<result_t, Monoid> combine_t;
+
+	return fold(std::forward<Foldable>(foldable), reducer_t(std::forward<KeyFunction>(key), std::forward<ValueFunction>(value)), combine_t());
+}
+
+/**
+* Groups the elements of the given foldable by key, and folds the elements of each group over the given monoid,
+* in parallel on the given executor.
+* @tparam Monoid The monoid over which the elements of each group are folded, as described by @ref monoid_traits.
+* @param foldable The foldable whose elements are grouped.
+* @param key The function that computes the key of an element. The keys must be hashable by std::hash.
+* @param executor The executor on which the foldable is folded.
+* @returns A @ref group_map from each key to the aggregate of the elements that have it.
+*/
+template<typename Monoid, typename Key = detail::deduced_key, typename Foldable, typename KeyFunction, typename Executor>
+typename detail::enable_group_by<Foldable, Monoid, typename std::decay<KeyFunction>::type, Key, detail::is_executor<Executor>::value>::type
+group_by(Foldable&& foldable, KeyFunction&& key, Executor&& executor)
+{
+	return group_by<Monoid, Key>(std::forward<Foldable>(foldable), std::forward<KeyFunction>(key), detail::group_by_identity(), executor);
+}
+
+/**
+* Groups the elements of the given foldable by key, and folds the elements of each group over the given monoid.
+* The foldable is folded as by the three argument version of fold().
+*/
+template<typename Monoid, typename Key = detail::deduced_key, typename Foldable, typename KeyFunction>
+typename detail::enable_group_by<Foldable, Monoid, typename std::decay<KeyFunction>::type, Key, !detail::is_executor<KeyFunction>::value>::type
+group_by(Foldable&& foldable, KeyFunction&& key)
+{
+	return group_by<Monoid, Key>(std::forward<Foldable>(foldable), std::forward<KeyFunction>(key), detail::group_by_identity());
+}
+
+/**
+* Version of group_by() that is used with the pipe expressions.
+* @code
+* auto byLastDigit = data | filter(is_valid) | group_by<additive_monoid<int>>([](int n) { return n % 10; });
+* @endcode
+*/
+template<typename Monoid, typename Key = detail::deduced_key, typename KeyFunction>
+detail::group_by_expression<Monoid, Key, typename std::decay<KeyFunction>::type>
+group_by(KeyFunction&& key)
+{
+	return detail::group_by_expression<Monoid, Key, typename std::decay<KeyFunction>::type>(std::forward<KeyFunction>(key));
+}
+
+/**
+* Version of group_by() on a given executor that is used with the pipe expressions.
+*/
+template<typename Monoid, typename Key = detail::deduced_key, typename KeyFunction, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	detail::executor_group_by_expression<Monoid, Key, typename std::decay<KeyFunction>::type, Executor>
+>::type
+group_by(KeyFunction&& key, Executor&& executor)
+{
+	typedef detail::executor_group_by_expression<Monoid, Key, typename std::decay<KeyFunction>::type, Executor> return_t;
+	return return_t(std::forward<KeyFunction>(key), std::forward<Executor>(executor));
+}
+
+namespace detail
+{
+	template<typename Foldable, typename Monoid, typename Key, typename KeyFunction>
+	typename group_by_result<Foldable, Monoid, KeyFunction, Key>::type
+	operator|(Foldable&& foldable, group_by_expression<Monoid, Key, KeyFunction> const& expr)
+	{
+		return group_by<Monoid, Key>(std::forward<Foldable>(foldable), expr.key);
+	}
+
+	template<typename Foldable, typename Monoid, typename Key, typename KeyFunction>
+	typename group_by_result<Foldable, Monoid, KeyFunction, Key>::type
+	operator|(Foldable&& foldable, group_by_expression<Monoid, Key, KeyFunction>&& expr)
+	{
+		return group_by<Monoid, Key>(std::forward<Foldable>(foldable), std::move(expr.key));
+	}
+
+	template<typename Foldable, typename Monoid, typename Key, typename KeyFunction, typename Executor>
+	typename group_by_result<Foldable, Monoid, KeyFunction, Key>::type
+	operator|(Foldable&& foldable, executor_group_by_expression<Monoid, Key, KeyFunction, Executor>&& expr)
+	{
+		return group_by<Monoid, Key>(std::forward<Foldable>(foldable), std::move(expr.key), expr.executor);
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_GROUP_BY_H_INCLUDED
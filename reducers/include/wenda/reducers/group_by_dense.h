@@ -0,0 +1,293 @@
+#ifndef WENDA_REDUCERS_GROUP_BY_DENSE_H_INCLUDED
+#define WENDA_REDUCERS_GROUP_BY_DENSE_H_INCLUDED
+
+/**
+* @file group_by_dense.h
+* This file implements group_by_dense(), the counterpart of group_by() for keys that are small non-negative integers,
+* such as enumerations, hours of the day or country codes. The aggregates are held in a flat array indexed by key,
+* so that accumulating an element, or a value computed from it, is a single indexed update rather than a hash table lookup.
+* @code
+* auto perHour = group_by_dense<additive_monoid<int>>(events, hour_of, [](event const&) { return 1; }, 24);
+* @endcode
+* Each chunk of the fold accumulates into its own array, and the arrays are combined element-wise,
+* with the kernels in simd_reduce.h for the built-in monoids.
+*/
+
+#include "reducers_common.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <type_traits>
+#include <vector>
+
+#include "fold.h"
+#include "group_by.h"
+#include "monoid/monoid.h"
+#include "detail/is_executor.h"
+#include "detail/simd_reduce.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * Accumulates the value of each element in place into the aggregate at the index given by its key.
+    * Blocks of elements, such as those that maps and filters produce from contiguous ranges, are accumulated in a single loop.
+	*/
+	template<typename Monoid, typename KeyFunction, typename ValueFunction>
+	struct dense_group_by_reducer
+	{
+		typedef typename monoid_traits<Monoid>::element_t element_t;
+		typedef typename monoid_traits<Monoid>::operation_t operation_t;
+
+		KeyFunction key;
+		ValueFunction value;
+		operation_t operation;
+
+		dense_group_by_reducer(KeyFunction key, ValueFunction value)
+			: key(std::move(key)), value(std::move(value))
+		{
+		}
+
+		template<typename Element>
+		void operator()(std::vector<element_t>& groups, Element&& element) const
+		{
+			typename std::vector<element_t>::reference group = groups[index_of(groups, element)];
+			group = operation(std::move(group), value(std::forward<Element>(element)));
+		}
+
+		template<typename T>
+		std::vector<element_t> reduce_block(std::vector<element_t> groups, T const* first, T const* last) const
+		{
+			for (; first != last; ++first)
+			{
+				typename std::vector<element_t>::reference group = groups[index_of(groups, *first)];
+				group = operation(std::move(group), value(*first));
+			}
+
+			return groups;
+		}
+
+	private:
+		template<typename Element>
+		std::size_t index_of(std::vector<element_t> const& groups, Element const& element) const
+		{
+			std::size_t index = static_cast<std::size_t>(key(element));
+
+			if (index >= groups.size())
+			{
+				throw std::out_of_range("group_by_dense: key outside of the domain");
+			}
+
+			return index;
+		}
+	};
+
+	/**
+    * @internal
+    * Combines the arrays of aggregates of two chunks element-wise, where the left one precedes the right one.
+	*/
+	template<typename Monoid>
+	struct dense_group_by_combine
+	{
+		typedef typename monoid_traits<Monoid>::element_t element_t;
+		typedef typename monoid_traits<Monoid>::operation_t operation_t;
+
+		std::size_t domain_size;
+		operation_t operation;
+
+		dense_group_by_combine(std::size_t domain_size)
+			: domain_size(domain_size)
+		{
+		}
+
+		std::vector<element_t> operator()() const
+		{
+			return std::vector<element_t>(domain_size, monoid_traits<Monoid>::unit());
+		}
+
+		std::vector<element_t> operator()(std::vector<element_t> left, std::vector<element_t> right) const
+		{
+			typedef std::integral_constant<bool,
+				simd_operation_traits<operation_t>::value &&
+				std::is_same<element_t, typename simd_operation_traits<operation_t>::element_t>::value &&
+				!std::is_same<element_t, bool>::value> has_kernel_t;
+
+			combine(left, right, has_kernel_t());
+			return left;
+		}
+
+	private:
+		void combine(std::vector<element_t>& left, std::vector<element_t> const& right, std::true_type) const
+		{
+			combine_contiguous(left.data(), right.data(), left.size(), operation);
+		}
+
+		void combine(std::vector<element_t>& left, std::vector<element_t>& right, std::false_type) const
+		{
+			for (std::size_t i = 0; i < left.size(); ++i)
+			{
+				left[i] = operation(std::move(left[i]), std::move(right[i]));
+			}
+		}
+	};
+
+	template<typename Monoid, typename KeyFunction>
+	struct dense_group_by_expression
+	{
+		KeyFunction key;
+		std::size_t domain_size;
+
+		dense_group_by_expression(KeyFunction key, std::size_t domain_size)
+			: key(std::move(key)), domain_size(domain_size)
+		{
+		}
+	};
+
+	/**
+    * @internal
+    * This struct holds the key function, the size of the domain and the executor of a group_by_dense() in a pipe expression.
+    * The executor is held by reference if it was given as an l-value, and by value otherwise.
+	*/
+	template<typename Monoid, typename KeyFunction, typename Executor>
+	struct executor_dense_group_by_expression
+	{
+		KeyFunction key;
+		std::size_t domain_size;
+		Executor executor;
+
+		executor_dense_group_by_expression(KeyFunction key, std::size_t domain_size, Executor&& executor)
+			: key(std::move(key)), domain_size(domain_size), executor(std::forward<Executor>(executor))
+		{
+		}
+	};
+}
+
+/**
+* Groups the elements of the given foldable by a key in [0, domain_size), and folds the values of the elements of each group
+* over the given monoid, in parallel on the given executor.
+* @tparam Monoid The monoid over which the values of each group are folded, as described by @ref monoid_traits.
+* @param foldable The foldable whose elements are grouped.
+* @param key The function that computes the key of an element, as an integer or an enumeration.
+* @param value The function that computes the value of an element, which is aggregated under its key.
+* @param domain_size The number of keys.
+* @param executor The executor on which the foldable is folded.
+* @returns An array of @p domain_size aggregates, where the aggregate of the keys without elements is the unit of the monoid.
+* @throws std::out_of_range if the key of an element lies outside of the domain.
+*/
+template<typename Monoid, typename Foldable, typename KeyFunction, typename ValueFunction, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	std::vector<typename monoid_traits<Monoid>::element_t>
+>::type
+group_by_dense(Foldable&& foldable, KeyFunction&& key, ValueFunction&& value, std::size_t domain_size, Executor&& executor)
+{
+	typedef detail::dense_group_by_reducer<Monoid, typename std::decay<KeyFunction>::type, typename std::decay<ValueFunction>::type> reducer_t;
+	typedef detail::dense_group_by_combine<Monoid> combine_t;
+
+	return fold(std::forward<Foldable>(foldable), reducer_t(std::forward<KeyFunction>(key), std::forward<ValueFunction>(value)), combine_t(domain_size), executor);
+}
+
+/**
+* Groups the elements of the given foldable by a key in [0, domain_size), and folds the values of the elements of each group over the given monoid.
+* The foldable is folded as by the three argument version of fold().
+*/
+template<typename Monoid, typename Foldable, typename KeyFunction, typename ValueFunction>
+std::vector<typename monoid_traits<Monoid>::element_t>
+group_by_dense(Foldable&& foldable, KeyFunction&& key, ValueFunction&& value, std::size_t domain_size)
+{
+	typedef detail::dense_group_by_reducer<Monoid, typename std::decay<KeyFunction>::type, typename std::decay<ValueFunction>::type> reducer_t;
+	typedef detail::dense_group_by_combine<Monoid> combine_t;
+
+	return fold(std::forward<Foldable>(foldable), reducer_t(std::forward<KeyFunction>(key), std::forward<ValueFunction>(value)), combine_t(domain_size));
+}
+
+/**
+* Groups the elements of the given foldable by a key in [0, domain_size), and folds the elements of each group over the given monoid,
+* in parallel on the given executor.
+* @tparam Monoid The monoid over which the elements of each group are folded, as described by @ref monoid_traits.
+* @param foldable The foldable whose elements are grouped.
+* @param key The function that computes the key of an element, as an integer or an enumeration.
+* @param domain_size The number of keys.
+* @param executor The executor on which the foldable is folded.
+* @returns An array of @p domain_size aggregates, where the aggregate of the keys without elements is the unit of the monoid.
+* @throws std::out_of_range if the key of an element lies outside of the domain.
+*/
+template<typename Monoid, typename Foldable, typename KeyFunction, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	std::vector<typename monoid_traits<Monoid>::element_t>
+>::type
+group_by_dense(Foldable&& foldable, KeyFunction&& key, std::size_t domain_size, Executor&& executor)
+{
+	return group_by_dense<Monoid>(std::forward<Foldable>(foldable), std::forward<KeyFunction>(key), detail::group_by_identity(), domain_size, executor);
+}
+
+/**
+* Groups the elements of the given foldable by a key in [0, domain_size), and folds the elements of each group over the given monoid.
+* The foldable is folded as by the three argument version of fold().
+*/
+template<typename Monoid, typename Foldable, typename KeyFunction>
+std::vector<typename monoid_traits<Monoid>::element_t>
+group_by_dense(Foldable&& foldable, KeyFunction&& key, std::size_t domain_size)
+{
+	return group_by_dense<Monoid>(std::forward<Foldable>(foldable), std::forward<KeyFunction>(key), detail::group_by_identity(), domain_size);
+}
+
+/**
+* Version of group_by_dense() that is used with the pipe expressions.
+* @code
+* auto histogram = data | filter(is_valid) | group_by_dense<additive_monoid<int>>([](int n) { return n % 10; }, 10);
+* @endcode
+*/
+template<typename Monoid, typename KeyFunction>
+detail::dense_group_by_expression<Monoid, typename std::decay<KeyFunction>::type>
+group_by_dense(KeyFunction&& key, std::size_t domain_size)
+{
+	typedef detail::dense_group_by_expression<Monoid, typename std::decay<KeyFunction>::type> return_t;
+	return return_t(std::forward<KeyFunction>(key), domain_size);
+}
+
+/**
+* Version of group_by_dense() on a given executor that is used with the pipe expressions.
+*/
+template<typename Monoid, typename KeyFunction, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	detail::executor_dense_group_by_expression<Monoid, typename std::decay<KeyFunction>::type, Executor>
+>::type
+group_by_dense(KeyFunction&& key, std::size_t domain_size, Executor&& executor)
+{
+	typedef detail::executor_dense_group_by_expression<Monoid, typename std::decay<KeyFunction>::type, Executor> return_t;
+	return return_t(std::forward<KeyFunction>(key), domain_size, std::forward<Executor>(executor));
+}
+
+namespace detail
+{
+	template<typename Foldable, typename Monoid, typename KeyFunction>
+	std::vector<typename monoid_traits<Monoid>::element_t>
+	operator|(Foldable&& foldable, dense_group_by_expression<Monoid, KeyFunction> const& expr)
+	{
+		return group_by_dense<Monoid>(std::forward<Foldable>(foldable), expr.key, expr.domain_size);
+	}
+
+	template<typename Foldable, typename Monoid, typename KeyFunction>
+	std::vector<typename monoid_traits<Monoid>::element_t>
+	operator|(Foldable&& foldable, dense_group_by_expression<Monoid, KeyFunction>&& expr)
+	{
+		return group_by_dense<Monoid>(std::forward<Foldable>(foldable), std::move(expr.key), expr.domain_size);
+	}
+
+	template<typename Foldable, typename Monoid, typename KeyFunction, typename Executor>
+	std::vector<typename monoid_traits<Monoid>::element_t>
+	operator|(Foldable&& foldable, executor_dense_group_by_expression<Monoid, KeyFunction, Executor>&& expr)
+	{
+		return group_by_dense<Monoid>(std::forward<Foldable>(foldable), std::move(expr.key), expr.domain_size, expr.executor);
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_GROUP_BY_DENSE_H_INCLUDED
@@ -0,0 +1,222 @@
+#ifndef WENDA_REDUCERS_GROUP_MAP_H_INCLUDED
+#define WENDA_REDUCERS_GROUP_MAP_H_INCLUDED
+
+/**
+* @file group_map.h
+* This file contains the @ref group_map class, the open-addressing hash map that group_by() aggregates into.
+* Its entries are stored contiguously in insertion order, and a table of slots, probed linearly, holds their indices.
+* Inserting a key thus allocates no node, and iterating over the groups is a scan of an array.
+*/
+
+#include "reducers_common.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * The index held by the slots of a @ref group_map that hold no entry.
+	*/
+	const std::size_t empty_group_slot = static_cast<std::size_t>(-1);
+
+	/**
+    * @internal
+    * The number of slots of a @ref group_map when its first entry is inserted.
+	*/
+	const std::size_t initial_group_slots = 16;
+}
+
+/**
+* This class implements a hash map from keys to values, that supports insertion and lookup but not erasure.
+* The entries are iterated over in the order in which they were inserted.
+*/
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class group_map
+{
+public:
+	typedef Key key_type;
+	typedef Value mapped_type;
+	typedef std::pair<const Key, Value> value_type;
+	typedef typename std::vector<value_type>::iterator iterator;
+	typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+	group_map()
+		: shift(64)
+	{
+	}
+
+	std::size_t size() const
+	{
+		return entries.size();
+	}
+
+	bool empty() const
+	{
+		return entries.empty();
+	}
+
+	iterator begin() { return entries.begin(); }
+	iterator end() { return entries.end(); }
+	const_iterator begin() const { return entries.begin(); }
+	const_iterator end() const { return entries.end(); }
+
+	/**
+    * Returns an iterator to the entry with the given key, or end() if there is none.
+	*/
+	iterator find(Key const& key)
+	{
+		std::size_t index = find_index(key, hasher(key));
+		return index == detail::empty_group_slot ? entries.end() : entries.begin() + index;
+	}
+
+	const_iterator find(Key const& key) const
+	{
+		std::size_t index = find_index(key, hasher(key));
+		return index == detail::empty_group_slot ? entries.end() : entries.begin() + index;
+	}
+
+	std::size_t count(Key const& key) const
+	{
+		return find_index(key, hasher(key)) == detail::empty_group_slot ? 0 : 1;
+	}
+
+	/**
+    * Returns the value of the entry with the given key.
+    * @throws std::out_of_range if there is no entry with the given key.
+	*/
+	Value const& at(Key const& key) const
+	{
+		std::size_t index = find_index(key, hasher(key));
+
+		if (index == detail::empty_group_slot)
+		{
+			throw std::out_of_range("group_map::at: key not found");
+		}
+
+		return entries[index].second;
+	}
+
+	/**
+    * Inserts the given entry if there is no entry with the same key.
+    * @returns An iterator to the entry with the key, and whether the given entry was inserted.
+	*/
+	std::pair<iterator, bool> insert(value_type value)
+	{
+		std::size_t hash = hasher(value.first);
+		std::size_t index = find_index(value.first, hash);
+
+		if (index != detail::empty_group_slot)
+		{
+			return std::make_pair(entries.begin() + index, false);
+		}
+
+		if (2 * (entries.size() + 1) > slots.size())
+		{
+			rehash(slots.empty() ? detail::initial_group_slots : 2 * slots.size());
+		}
+
+		place(entries.size(), hash);
+		entries.push_back(std::move(value));
+		hashes.push_back(hash);
+		return std::make_pair(entries.end() - 1, true);
+	}
+
+	/**
+    * Prepares the map to hold the given number of entries without rehashing.
+	*/
+	void reserve(std::size_t count)
+	{
+		std::size_t capacity = slots.empty() ? detail::initial_group_slots : slots.size();
+
+		while (capacity < 2 * count)
+		{
+			capacity *= 2;
+		}
+
+		if (capacity > slots.size())
+		{
+			rehash(capacity);
+		}
+
+		entries.reserve(count);
+		hashes.reserve(count);
+	}
+
+private:
+	std::vector<value_type> entries;
+	std::vector<std::size_t> hashes;
+	std::vector<std::size_t> slots;
+	unsigned shift;
+	Hash hasher;
+	KeyEqual equal;
+
+	/**
+    * Returns the slot at which probing for the given hash starts. The hash is scrambled by Fibonacci hashing,
+    * so that keys whose hashes differ only in their high bits, such as multiples of a power of two, are spread over the slots.
+	*/
+	std::size_t home_slot(std::size_t hash) const
+	{
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> shift);
+	}
+
+	std::size_t find_index(Key const& key, std::size_t hash) const
+	{
+		if (slots.empty())
+		{
+			return detail::empty_group_slot;
+		}
+
+		std::size_t mask = slots.size() - 1;
+
+		for (std::size_t slot = home_slot(hash);; slot = (slot + 1) & mask)
+		{
+			std::size_t index = slots[slot];
+
+			if (index == detail::empty_group_slot || (hashes[index] == hash && equal(entries[index].first, key)))
+			{
+				return index;
+			}
+		}
+	}
+
+	void place(std::size_t index, std::size_t hash)
+	{
+		std::size_t mask = slots.size() - 1;
+		std::size_t slot = home_slot(hash);
+
+		while (slots[slot] != detail::empty_group_slot)
+		{
+			slot = (slot + 1) & mask;
+		}
+
+		slots[slot] = index;
+	}
+
+	void rehash(std::size_t capacity)
+	{
+		slots.assign(capacity, detail::empty_group_slot);
+
+		shift = 64;
+		for (std::size_t c = capacity; c > 1; c /= 2)
+		{
+			--shift;
+		}
+
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			place(i, hashes[i]);
+		}
+	}
+};
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_GROUP_MAP_H_INCLUDED
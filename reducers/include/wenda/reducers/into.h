@@ -6,35 +6,53 @@
 * This file implements a special reducer, that instead
 * of accumulating towards a single value, accumulates
 * to a sequence written through a output iterator.
+* It also implements into_container(), which accumulates into a new container, and
+* uses the size hint of the reducible to allocate the storage of the container up front.
 */
 
 #include "reducers_common.h"
 
+#include <cstddef>
+#include <iterator>
 #include <utility>
 #include <type_traits>
 
 #include "reduce.h"
+#include "size_hint.h"
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
 namespace detail
 {
+	/**
+    * @internal
+    * Writes each element through the output iterator that is the seed, and advances it in place.
+    * Reducibles that accumulate by value are given the advanced iterator in return.
+	*/
 	struct output_iterator_accumulator
 	{
         template<typename Iterator, typename Value>
-		typename Iterator operator()(Iterator iterator, Value&& value)
+		void operator()(Iterator& iterator, Value&& value) const
 		{
 			*iterator = std::forward<Value>(value);
-			return ++iterator;
+			++iterator;
+		}
+
+        template<typename Iterator, typename Value>
+		typename std::enable_if<!std::is_reference<Iterator>::value, Iterator>::type
+		operator()(Iterator&& iterator, Value&& value) const
+		{
+			(*this)(iterator, std::forward<Value>(value));
+			return std::move(iterator);
 		}
 	};
 
     template<typename Iterator>
-	struct into_expresion
+	struct into_expression
 	{
 		Iterator iterator;
 
-		into_expresion(Iterator iterator)
+		into_expression(Iterator iterator)
 			: iterator(std::move(iterator))
 		{}
 	};
@@ -59,13 +77,13 @@ into(Reducible&& reducible, Iterator&& iterator)
 namespace detail
 {
     template<typename Reducible, typename Iterator>
-	Iterator operator|(Reducible&& reducible, into_expresion<Iterator> const& expr)
+	Iterator operator|(Reducible&& reducible, into_expression<Iterator> const& expr)
 	{
 		return into(std::forward<Reducible>(reducible), expr.iterator);
 	}
 
     template<typename Reducible, typename Iterator>
-	Iterator operator|(Reducible&& reducible, into_expresion<Iterator>&& expr)
+	Iterator operator|(Reducible&& reducible, into_expression<Iterator>&& expr)
 	{
 		return into(std::forward<Reducible>(reducible), std::move(expr.iterator));
 	}
@@ -79,10 +97,171 @@ namespace detail
 * @returns A implementation-specific helper object that can be combined with a reducible to accumulate the reducible.
 */
 template<typename Iterator>
-detail::into_expresion<typename std::decay<Iterator>::type>
+detail::into_expression<typename std::decay<Iterator>::type>
 into(Iterator&& iterator)
 {
-	return detail::into_expresion<typename std::decay<Iterator>::type>(std::forward<Iterator>(iterator));
+	return detail::into_expression<typename std::decay<Iterator>::type>(std::forward<Iterator>(iterator));
+}
+
+namespace detail
+{
+	/**
+    * @internal
+    * Trait to determine whether a container can reserve storage for a number of elements, such as std::vector.
+	*/
+	template<typename Container>
+	class has_reserve_member_function
+	{
+		template<typename U> static std::true_type test(
+			typename std::add_pointer<decltype(std::declval<U&>().reserve(std::size_t()))>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<Container>(nullptr)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Trait to determine whether a container can be resized to a number of default constructed elements,
+    * which are then overwritten through its random access iterators, such as std::vector or std::deque.
+	*/
+	template<typename Container>
+	class is_resizable_container
+	{
+		template<typename U> static std::true_type test(
+			typename std::enable_if<
+			    std::is_default_constructible<typename U::value_type>::value &&
+			    std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<typename U::iterator>::iterator_category>::value,
+			    typename std::add_pointer<decltype(std::declval<U&>().resize(std::size_t()))>::type
+			>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<Container>(nullptr)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Overwrites the elements of a resized container in order, counting them in the seed, and appends the elements
+    * that follow once its end is reached, so that the container is filled safely even if the size hint was wrong.
+	*/
+	template<typename Container>
+	struct resized_container_accumulator
+	{
+		Container& container;
+
+		explicit resized_container_accumulator(Container& container)
+			: container(container)
+		{}
+
+		template<typename Value>
+		std::size_t operator()(std::size_t written, Value&& value) const
+		{
+			if (written < container.size())
+			{
+				container.begin()[written] = std::forward<Value>(value);
+			}
+			else
+			{
+				container.push_back(std::forward<Value>(value));
+			}
+
+			return written + 1;
+		}
+	};
+
+	template<typename Container>
+	void reserve_container(Container& container, size_hint hint, std::true_type)
+	{
+		if (hint.is_exact())
+		{
+			container.reserve(hint.count);
+		}
+	}
+
+	template<typename Container>
+	void reserve_container(Container&, size_hint, std::false_type)
+	{
+	}
+
+	/**
+    * @internal
+    * Appends the elements of the reducible to the container, after reserving their storage if their number is known.
+    * Upper bounds are not reserved, as filtered reducibles may only keep a small fraction of the elements of their source.
+	*/
+	template<typename Container, typename Reducible>
+	void fill_container(Container& container, Reducible&& reducible, size_hint hint, std::false_type)
+	{
+		reserve_container(container, hint, typename has_reserve_member_function<Container>::type());
+		reduce(std::forward<Reducible>(reducible), output_iterator_accumulator(), std::back_inserter(container));
+	}
+
+	/**
+    * @internal
+    * Writes the elements of the reducible directly into the storage of the container if their number is known,
+    * and appends them otherwise. Elements beyond the hint are appended, and the storage left over is erased.
+	*/
+	template<typename Container, typename Reducible>
+	void fill_container(Container& container, Reducible&& reducible, size_hint hint, std::true_type)
+	{
+		if (!hint.is_exact())
+		{
+			fill_container(container, std::forward<Reducible>(reducible), hint, std::false_type());
+			return;
+		}
+
+		container.resize(hint.count);
+		std::size_t written = reduce(std::forward<Reducible>(reducible), resized_container_accumulator<Container>(container), std::size_t(0));
+
+		if (written < container.size())
+		{
+			container.erase(container.begin() + written, container.end());
+		}
+	}
+
+	template<typename Container>
+	struct into_container_expression
+	{
+	};
+}
+
+/**
+* Reduces a reducible into a new container.
+* If the size hint of the reducible is exact, the container is allocated once, and the elements are
+* written directly into its storage when it has random access iterators, such as std::vector.
+* Otherwise, the elements are appended to the container.
+* @tparam Container The type of the container, which must support push_back().
+* @param reducible The reducible to accumulate into the container.
+* @returns The container holding the elements of the reducible, in order.
+*/
+template<typename Container, typename Reducible>
+Container into_container(Reducible&& reducible)
+{
+	Container container;
+	size_hint hint = get_size_hint(reducible);
+	detail::fill_container(container, std::forward<Reducible>(reducible), hint, typename detail::is_resizable_container<Container>::type());
+	return container;
+}
+
+/**
+* Reduces a reducible into a new container.
+* This is similar to the one-argument version, but should have the reducible passed in by pipeing.
+* @tparam Container The type of the container, which must support push_back().
+* @returns A implementation-specific helper object that can be combined with a reducible to accumulate the reducible.
+*/
+template<typename Container>
+detail::into_container_expression<Container> into_container()
+{
+	return detail::into_container_expression<Container>();
+}
+
+namespace detail
+{
+    template<typename Reducible, typename Container>
+	Container operator|(Reducible&& reducible, into_container_expression<Container>)
+	{
+		return into_container<Container>(std::forward<Reducible>(reducible));
+	}
 }
 
 WENDA_REDUCERS_NAMESPACE_END
@@ -10,6 +10,7 @@
 #include "../reducers_common.h"
 
 #include <functional>
+#include <limits>
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
@@ -52,6 +53,209 @@ struct additive_monoid
 	static element_t unit() { return T(); }
 };
 
+/**
+* This type represents a floating point sum together with the rounding error that it has accumulated,
+* which @ref kahan_monoid carries along the summation.
+*/
+template<typename T>
+struct kahan_sum
+{
+	T sum;
+	T compensation;
+
+	kahan_sum()
+		: sum(), compensation()
+	{
+	}
+
+	kahan_sum(T sum, T compensation)
+		: sum(sum), compensation(compensation)
+	{
+	}
+
+	/**
+    * Returns the compensated value of the sum.
+	*/
+	T value() const
+	{
+		return sum + compensation;
+	}
+
+	operator T() const
+	{
+		return value();
+	}
+};
+
+namespace detail
+{
+	/**
+    * @internal
+    * Adds a value to a sum, and accumulates the exact rounding error of the addition into the compensation,
+    * without branching on the magnitudes of the operands.
+	*/
+	template<typename T>
+	void compensated_add(T& sum, T& compensation, T value)
+	{
+		T total = sum + value;
+		T rounded = total - sum;
+		compensation += (sum - (total - rounded)) + (value - rounded);
+		sum = total;
+	}
+
+	/**
+    * @internal
+    * The operation of @ref kahan_monoid, which adds values or merges other compensated sums.
+	*/
+	template<typename T>
+	struct kahan_operation
+	{
+		kahan_sum<T> operator()(kahan_sum<T> left, T const& value) const
+		{
+			compensated_add(left.sum, left.compensation, value);
+			return left;
+		}
+
+		kahan_sum<T> operator()(kahan_sum<T> left, kahan_sum<T> const& right) const
+		{
+			compensated_add(left.sum, left.compensation, right.sum);
+			left.compensation += right.compensation;
+			return left;
+		}
+	};
+
+	/**
+    * @internal
+    * The operation of @ref pairwise_sum_monoid, which adds values.
+    * It is distinct from std::plus, so that reductions over the monoid sum blocks of values pairwise.
+	*/
+	template<typename T>
+	struct pairwise_sum_operation
+	{
+		T operator()(T const& left, T const& right) const
+		{
+			return left + right;
+		}
+	};
+}
+
+/**
+* This type represents the sums of a floating point type with compensated (Kahan-Babuska) summation.
+* Its elements are @ref kahan_sum values, which carry the rounding error of the sum along,
+* so that the error of the result does not grow with the number of values. They convert to the compensated sum.
+* Parallel folds merge the compensated sums of their pieces.
+* This relies on strict floating point semantics, and must not be compiled with options that reassociate operations.
+*/
+template<typename T>
+struct kahan_monoid
+{
+	typedef kahan_sum<T> element_t;
+	typedef detail::kahan_operation<T> operation_t;
+	static element_t unit() { return element_t(); }
+};
+
+/**
+* This type represents the sums of a floating point type with pairwise summation.
+* Contiguous values, such as those of a std::vector, are summed by recursively halving their range, so that the
+* rounding error grows with the logarithm of the number of values, instead of linearly as with @ref additive_monoid.
+*/
+template<typename T>
+struct pairwise_sum_monoid
+{
+	typedef T element_t;
+	typedef detail::pairwise_sum_operation<T> operation_t;
+	static element_t unit() { return T(); }
+};
+
+namespace detail
+{
+	/**
+    * @internal
+    * Function object returning the smaller of its arguments, or the first one if they are equivalent.
+	*/
+	template<typename T>
+	struct min_operation
+	{
+		T operator()(T const& left, T const& right) const
+		{
+			return right < left ? right : left;
+		}
+	};
+
+	/**
+    * @internal
+    * Function object returning the larger of its arguments, or the first one if they are equivalent.
+	*/
+	template<typename T>
+	struct max_operation
+	{
+		T operator()(T const& left, T const& right) const
+		{
+			return left < right ? right : left;
+		}
+	};
+}
+
+/**
+* This type represents the monoid of a totally ordered type under the minimum operation.
+* Its unit is the largest value of the type, or positive infinity for floating point types.
+* The result is unspecified for floating point values that include NaN.
+*/
+template<typename T>
+struct min_monoid
+{
+	typedef T element_t;
+	typedef detail::min_operation<T> operation_t;
+	static element_t unit() { return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : (std::numeric_limits<T>::max)(); }
+};
+
+/**
+* This type represents the monoid of a totally ordered type under the maximum operation.
+* Its unit is the lowest value of the type, or negative infinity for floating point types.
+* The result is unspecified for floating point values that include NaN.
+*/
+template<typename T>
+struct max_monoid
+{
+	typedef T element_t;
+	typedef detail::max_operation<T> operation_t;
+	static element_t unit() { return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest(); }
+};
+
+/**
+* This type represents the monoid of an integral type under the bitwise and operation,
+* whose unit is the value with all bits set.
+*/
+template<typename T>
+struct bitwise_and_monoid
+{
+	typedef T element_t;
+	typedef std::bit_and<T> operation_t;
+	static element_t unit() { return static_cast<T>(~T()); }
+};
+
+/**
+* This type represents the monoid of an integral type under the bitwise or operation.
+*/
+template<typename T>
+struct bitwise_or_monoid
+{
+	typedef T element_t;
+	typedef std::bit_or<T> operation_t;
+	static element_t unit() { return T(); }
+};
+
+/**
+* This type represents the monoid of an integral type under the bitwise exclusive or operation.
+*/
+template<typename T>
+struct bitwise_xor_monoid
+{
+	typedef T element_t;
+	typedef std::bit_xor<T> operation_t;
+	static element_t unit() { return T(); }
+};
+
 WENDA_REDUCERS_NAMESPACE_END
 
 #endif // WENDA_REDUCERS_MONOID_MONOID_H_INCLUDED
\ No newline at end of file
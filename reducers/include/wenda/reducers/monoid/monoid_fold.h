@@ -10,9 +10,12 @@
 #include "../reducers_common.h"
 
 #include <utility>
+#include <type_traits>
 
 #include "monoid.h"
 #include "../fold.h"
+#include "../detail/is_executor.h"
+#include "../detail/block_reduce.h"
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
@@ -43,14 +46,36 @@ namespace detail
 * @sa fold(void)
 */
 template<typename Monoid, typename Foldable>
-typename monoid_traits<Monoid>::element_t
+typename std::enable_if<
+	!detail::is_executor<Foldable>::value,
+	typename monoid_traits<Monoid>::element_t
+>::type
 fold(Foldable&& foldable)
 {
 	typedef detail::monoid_combine<Monoid> combine_t;
-	typedef typename monoid_traits<Monoid>::operation_t reduce_t;
+	typedef typename detail::monoid_operation<Monoid>::type reduce_t;
 	return fold(std::forward<Foldable>(foldable), reduce_t(), combine_t());
 }
 
+/**
+* Folds the given @p foldable over the structure of the given @p Monoid, running on the given @p executor.
+* @param foldable The foldable to fold.
+* @param executor The executor on which to run the fold, for example a @ref thread_pool or an @ref inline_executor.
+* @tparam Monoid The monoid structure over which to fold the @p foldable.
+* @returns The result of folding the sequence over the given monoid structure.
+*/
+template<typename Monoid, typename Foldable, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	typename monoid_traits<Monoid>::element_t
+>::type
+fold(Foldable&& foldable, Executor&& executor)
+{
+	typedef detail::monoid_combine<Monoid> combine_t;
+	typedef typename detail::monoid_operation<Monoid, typename detail::executor_kernels<Executor>::type>::type reduce_t;
+	return fold(std::forward<Foldable>(foldable), reduce_t(), combine_t(), executor);
+}
+
 namespace detail
 {
     template<typename Monoid>
@@ -65,6 +90,28 @@ namespace detail
 	{
 		return fold<Monoid>(std::forward<Foldable>(foldable));
 	}
+
+	/**
+    * This struct holds the executor of a monoid fold in a pipe expression.
+    * The executor is held by reference if it was given as an l-value, and by value otherwise.
+	*/
+	template<typename Monoid, typename Executor>
+	struct monoid_executor_fold_expression
+	{
+		Executor executor;
+
+		monoid_executor_fold_expression(Executor&& executor)
+			: executor(std::forward<Executor>(executor))
+		{
+		}
+	};
+
+    template<typename Monoid, typename Executor, typename Foldable>
+    typename monoid_traits<Monoid>::element_t
+	operator|(Foldable&& foldable, monoid_executor_fold_expression<Monoid, Executor>&& expr)
+	{
+		return fold<Monoid>(std::forward<Foldable>(foldable), expr.executor);
+	}
 }
 
 /**
@@ -80,6 +127,28 @@ detail::monoid_fold_expression<Monoid> fold()
 	return detail::monoid_fold_expression<Monoid>();
 }
 
+/**
+* Creates an object, that when combined with a foldable through the
+* bitwise-or operator, folds the given foldable using the structure of the
+* given monoid on the given executor.
+* @code
+* thread_pool pool(4);
+* auto sum = data | map(f) | fold<additive_monoid<int>>(pool);
+* @endcode
+* @param executor The executor on which to run the fold.
+* @tparam Monoid A type describing the structure of the monoid that is folded over.
+* @returns An unspecified object, that when combined with a foldable, folds the sequence.
+*/
+template<typename Monoid, typename Executor>
+typename std::enable_if<
+	detail::is_executor<Executor>::value,
+	detail::monoid_executor_fold_expression<Monoid, Executor>
+>::type
+fold(Executor&& executor)
+{
+	return detail::monoid_executor_fold_expression<Monoid, Executor>(std::forward<Executor>(executor));
+}
+
 WENDA_REDUCERS_NAMESPACE_END
 
 #endif // WENDA_REDUCERS_MONOID_MONOID_FOLD_H_INCLUDED
\ No newline at end of file
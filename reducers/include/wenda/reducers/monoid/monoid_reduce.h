@@ -7,17 +7,92 @@
 * This is a specialization of the general reduce() algorithm, with a
 * given operation and seed that derive from the algebraic properties of the reducible's
 * element type.
+* Contiguous ranges of arithmetic values reduced over the built-in monoids are reduced with the kernels in simd_reduce.h,
+* and other random access ranges are reduced with several independent accumulators, as the operation of a monoid is associative.
 */
 
 #include "../reducers_common.h"
 
+#include <iterator>
 #include <utility>
+#include <type_traits>
 
 #include "monoid.h"
 #include "../reduce.h"
+#include "../detail/simd_reduce.h"
+#include "../detail/block_reduce.h"
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
+namespace detail
+{
+	template<typename Monoid, typename Reducible>
+	typename monoid_traits<Monoid>::element_t monoid_reduce_range(Reducible&& reducible, std::false_type)
+	{
+		return reduce(std::forward<Reducible>(reducible), typename monoid_operation<Monoid>::type(), monoid_traits<Monoid>::unit());
+	}
+
+	template<typename Monoid, typename Reducible>
+	typename monoid_traits<Monoid>::element_t monoid_reduce_random_access(Reducible&& reducible, std::false_type)
+	{
+		using std::begin;
+		using std::end;
+
+		auto unit = monoid_traits<Monoid>::unit();
+		return reduce_accumulators(begin(reducible), end(reducible), unit, unit, typename monoid_traits<Monoid>::operation_t());
+	}
+
+	template<typename Monoid, typename T>
+	typename monoid_traits<Monoid>::element_t monoid_reduce_pointers(T const* first, T const* last, std::true_type)
+	{
+		typedef typename monoid_operation<Monoid>::type operation_t;
+		return operation_t().reduce_block(monoid_traits<Monoid>::unit(), first, last);
+	}
+
+	template<typename Monoid, typename T>
+	typename monoid_traits<Monoid>::element_t monoid_reduce_pointers(T const* first, T const* last, std::false_type)
+	{
+		auto unit = monoid_traits<Monoid>::unit();
+		return reduce_accumulators(first, last, unit, unit, typename monoid_traits<Monoid>::operation_t());
+	}
+
+	template<typename Monoid, typename Reducible>
+	typename monoid_traits<Monoid>::element_t monoid_reduce_random_access(Reducible&& reducible, std::true_type)
+	{
+		// contiguous elements are reduced as a single block, which the operation of the monoid may reduce by itself.
+		auto first = contiguous_data(reducible);
+		typedef typename std::remove_const<typename std::remove_pointer<decltype(first)>::type>::type value_t;
+		typedef typename has_reduce_block_member_function<
+			typename monoid_operation<Monoid>::type,
+			typename monoid_traits<Monoid>::element_t,
+			value_t
+		>::type has_block_t;
+
+		return monoid_reduce_pointers<Monoid>(first, first + contiguous_size(reducible), has_block_t());
+	}
+
+	template<typename Monoid, typename Reducible>
+	typename monoid_traits<Monoid>::element_t monoid_reduce_range(Reducible&& reducible, std::true_type)
+	{
+		typedef typename is_contiguous_range<Reducible>::type contiguous_t;
+		return monoid_reduce_random_access<Monoid>(std::forward<Reducible>(reducible), contiguous_t());
+	}
+
+	template<typename Monoid, typename Reducible>
+	typename monoid_traits<Monoid>::element_t monoid_reduce_impl(Reducible&& reducible, std::false_type)
+	{
+		typedef typename is_random_access_range<Reducible>::type random_access_t;
+		return monoid_reduce_range<Monoid>(std::forward<Reducible>(reducible), random_access_t());
+	}
+
+	template<typename Monoid, typename Reducible>
+	typename monoid_traits<Monoid>::element_t monoid_reduce_impl(Reducible&& reducible, std::true_type)
+	{
+		auto first = contiguous_data(reducible);
+		return reduce_contiguous(first, first + contiguous_size(reducible), monoid_traits<Monoid>::unit(), typename monoid_traits<Monoid>::operation_t());
+	}
+}
+
 /**
 * Reduces the given reducible over a given monoid.
 * This calls reduce with the unit value as seed and the monoid operation as reducing operation.
@@ -27,7 +102,8 @@ WENDA_REDUCERS_NAMESPACE_BEGIN
 template<typename Monoid, typename Reducible>
 typename monoid_traits<Monoid>::element_t reduce(Reducible&& reducible)
 {
-	return reduce(std::forward<Reducible>(reducible), monoid_traits<Monoid>::operation_t(), monoid_traits<Monoid>::unit());
+	typedef typename detail::is_simd_reducible<Reducible, typename monoid_traits<Monoid>::operation_t>::type simd_t;
+	return detail::monoid_reduce_impl<Monoid>(std::forward<Reducible>(reducible), simd_t());
 }
 
 namespace detail
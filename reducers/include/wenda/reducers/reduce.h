@@ -77,6 +77,21 @@ reduce(Reducible&& reducible, FuncType&& function, SeedType&& seed)
 	return reducible.reduce(std::forward<FuncType>(function), std::forward<SeedType>(seed));
 }
 
+namespace detail
+{
+    template<typename T, typename FuncType, typename Seed>
+	class enable_range_reducible;
+}
+
+/**
+* Overload of the reduce function for ranges.
+* It is declared here so that it can be found by the pipe expressions and transformers,
+* and is defined in range_reducible.h.
+*/
+template<typename Range, typename FuncType, typename Seed>
+typename std::enable_if<detail::enable_range_reducible<Range, FuncType, Seed>::value, Seed>::type
+reduce(Range&& range, FuncType&& function, Seed&& seed);
+
 /**
 * Reduces the given reducible passed in using the pipe expression
 * with the given function and seed.
@@ -84,7 +99,9 @@ reduce(Reducible&& reducible, FuncType&& function, SeedType&& seed)
 * @code
 * reducible | reduce(std::plus<int>(), 0);
 * @endcode
-* @param function The reduction/aggregation function. It must have signature (Value, Seed) -> Seed
+* @param function The reduction/aggregation function. It must have signature (Seed, Value) -> Seed,
+* or signature (Seed&, Value) -> void to accumulate into the seed in place, which the reducibles
+* and transformers of the library then do without moving the seed for every element.
 * @param seed The initial value to be passed to the reduction function.
 * @returns An object that can be or-ed with a reducible to reduce it.
 */
@@ -113,4 +130,6 @@ namespace detail
 
 WENDA_REDUCERS_NAMESPACE_END
 
+#include "reducibles/range_reducible.h"
+
 #endif // WENDA_REDUCERS_REDUCE_H_INCLUDED
\ No newline at end of file
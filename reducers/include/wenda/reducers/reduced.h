@@ -0,0 +1,201 @@
+#ifndef WENDA_REDUCERS_REDUCED_H_INCLUDED
+#define WENDA_REDUCERS_REDUCED_H_INCLUDED
+
+/**
+* @file reduced.h
+* This file contains the @ref reduced wrapper, which lets a reducing function terminate a reduction early.
+* A reduction whose seed is of type reduced<T> stops as soon as the reducing function returns a value
+* created by make_reduced(). All the reducibles and transformers of the library honour it, and so do
+* parallel folds, which skip the work that lies after the point where the reduction stopped.
+* @code
+* // finds whether any element is negative, stopping at the first one.
+* auto found = data | reduce([](reduced<bool> acc, int n) { return n < 0 ? make_reduced(true) : acc; }, reduced<bool>(false));
+* bool result = unreduced(found);
+* @endcode
+*/
+
+#include "reducers_common.h"
+
+#include <utility>
+#include <type_traits>
+
+#include "detail/accumulate.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+/**
+* This class holds a seed value, along with whether the reduction is complete.
+* It is used as the seed type of reductions that may terminate early.
+* When folding with seeds of this type, the combination function is only invoked on values that are not complete,
+* and the result is marked complete if its right operand was.
+* @tparam T The type of the value.
+*/
+template<typename T>
+class reduced
+{
+	T val;
+	bool done;
+
+public:
+	/**
+    * Creates a new value, which by default lets the reduction continue.
+    * @param value The value.
+    * @param done Whether the reduction is complete.
+	*/
+	explicit reduced(T value = T(), bool done = false)
+		: val(std::move(value)), done(done)
+	{}
+
+	/**
+    * Returns whether the reduction is complete.
+	*/
+	bool is_reduced() const
+	{
+		return done;
+	}
+
+	/**
+    * Returns the value.
+	*/
+	T& get()
+	{
+		return val;
+	}
+
+	/**
+    * Returns the value.
+	*/
+	T const& get() const
+	{
+		return val;
+	}
+};
+
+/**
+* Creates a value that terminates the reduction, with the given result.
+* @param value The result of the reduction.
+* @returns A @ref reduced instance that is complete.
+*/
+template<typename T>
+reduced<typename std::decay<T>::type> make_reduced(T&& value)
+{
+	return reduced<typename std::decay<T>::type>(std::forward<T>(value), true);
+}
+
+/**
+* Returns the value held by the given @ref reduced instance.
+*/
+template<typename T>
+T unreduced(reduced<T> const& value)
+{
+	return value.get();
+}
+
+/**
+* Returns the given value, for values that are not of type @ref reduced.
+*/
+template<typename T>
+T unreduced(T const& value)
+{
+	return value;
+}
+
+namespace detail
+{
+	template<typename T>
+	struct is_reduced_type
+		: std::false_type
+	{};
+
+	template<typename T>
+	struct is_reduced_type<reduced<T>>
+		: std::true_type
+	{};
+
+	/**
+    * @internal
+    * Returns whether the given seed terminates its reduction. Seeds that are not of type @ref reduced never do,
+    * hence reducibles can check every seed at no cost for ordinary reductions.
+	*/
+	template<typename T>
+	bool is_reduced(T const&)
+	{
+		return false;
+	}
+
+	template<typename T>
+	bool is_reduced(reduced<T> const& value)
+	{
+		return value.is_reduced();
+	}
+
+	/**
+    * @internal
+    * Reduces the elements of the range [first, last) into the given seed, stopping early if the seed terminates the reduction.
+    * In-place reducing functions accumulate into the seed, which is then never moved within the loop.
+	*/
+	template<typename Iterator, typename Function, typename Seed>
+	Seed reduce_iterators(Iterator first, Iterator last, Seed seed, Function& function)
+	{
+		for (; first != last; ++first)
+		{
+			accumulate_into(function, seed, *first);
+
+			if (is_reduced(seed))
+			{
+				break;
+			}
+		}
+
+		return seed;
+	}
+
+	/**
+    * @internal
+    * Combines two partial results of a fold, where @p left precedes @p right.
+    * If the reduction was terminated within @p left, @p right is discarded, and if it was
+    * terminated within @p right, the result is marked as terminated.
+	*/
+	template<typename Combine, typename Value>
+	typename std::decay<Value>::type combine_in_order(Combine const& combine, Value&& left, Value&& right)
+	{
+		return combine(std::forward<Value>(left), std::forward<Value>(right));
+	}
+
+	template<typename Combine, typename T>
+	reduced<T> combine_in_order(Combine const& combine, reduced<T>&& left, reduced<T>&& right)
+	{
+		if (left.is_reduced())
+		{
+			return std::move(left);
+		}
+
+		bool done = right.is_reduced();
+		reduced<T> result = combine(std::move(left), std::move(right));
+		return reduced<T>(std::move(result.get()), done || result.is_reduced());
+	}
+
+	/**
+    * @internal
+    * A combination function that combines its operands in order, as in @ref combine_in_order.
+	*/
+	template<typename Combine>
+	struct in_order_combine
+	{
+		Combine const& combine;
+
+		in_order_combine(Combine const& combine)
+			: combine(combine)
+		{}
+
+		template<typename Value>
+		typename std::decay<Value>::type operator()(Value&& left, Value&& right) const
+		{
+			return combine_in_order(combine, std::move(left), std::move(right));
+		}
+	};
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_REDUCED_H_INCLUDED
@@ -26,4 +26,34 @@
 */
 #define WENDA_REDUCERS_NAMESPACE_END } }
 
+/**
+* Storage class specifier for thread local variables.
+* Visual C++ 2013 does not support the C++11 thread_local keyword, but
+* supports thread local storage of plain pointers through __declspec(thread).
+*/
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define WENDA_REDUCERS_THREAD_LOCAL __declspec(thread)
+#else
+#define WENDA_REDUCERS_THREAD_LOCAL thread_local
+#endif
+
+/**
+* Defined when the library may use SIMD kernels for the monoid reductions of contiguous arithmetic ranges.
+* SSE2 is part of the x64 baseline and is always used there, while AVX2 is used when the processor supports it at run time.
+* Define WENDA_REDUCERS_NO_SIMD before including the library to only use portable code.
+*/
+#if !defined(WENDA_REDUCERS_NO_SIMD) && (defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__))
+#define WENDA_REDUCERS_SIMD_X86
+#endif
+
+/**
+* Marks a function that uses AVX2 intrinsics. GCC and Clang only compile them in functions
+* that target AVX2, while Visual C++ accepts them anywhere.
+*/
+#if defined(__GNUC__)
+#define WENDA_REDUCERS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WENDA_REDUCERS_TARGET_AVX2
+#endif
+
 #endif // WENDA_REDUCERS_REDUCERS_COMMON_H_INCLUDED
\ No newline at end of file
@@ -10,14 +10,23 @@
 
 #include "../reducers_common.h"
 
+#include <iterator>
 #include <utility>
 #include <type_traits>
-#include <numeric>
+
+#include "../reduced.h"
+#include "../size_hint.h"
+#include "../detail/block_reduce.h"
+#include "../detail/parallel_reduce.h"
+#include "../detail/reducible_element.h"
+#include "../executors/thread_pool.h"
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
 /**
 * This class implements a reducible from an iterator pair.
+* It is also foldable: random access iterator pairs are split recursively, forward iterator pairs
+* are cut into chunks in a single pass, and input iterator pairs are reduced sequentially.
 */
 template<typename iterator_type>
 class iterator_pair_reducible
@@ -30,9 +39,55 @@ public:
 	{}
 
     template<typename Function, typename Seed>
-	Seed reduce(Function&& function, Seed&& seed) const
+	typename std::decay<Seed>::type reduce(Function&& function, Seed&& seed) const
+	{
+		return detail::reduce_elements(start, end, typename std::decay<Seed>::type(std::forward<Seed>(seed)), function);
+	}
+
+	/**
+    * Returns the size hint of this iterator pair, which is exact for random access iterators, and unknown otherwise.
+	*/
+	size_hint get_size_hint() const
+	{
+		return get_size_hint(typename std::iterator_traits<iterator_type>::iterator_category());
+	}
+
+	/**
+    * Folds over this iterator pair with the given functions on the given executor.
+	*/
+	template<typename ReduceFunction, typename CombineFunction, typename Executor>
+	typename std::decay<typename std::result_of<CombineFunction()>::type>::type
+	fold(ReduceFunction&& reduce, CombineFunction&& combine, Executor& executor) const
+	{
+		typedef typename std::decay<typename std::result_of<CombineFunction()>::type>::type value_t;
+
+		auto leaf = [&](iterator_type first, iterator_type last, value_t seed) -> value_t
+		{
+			return detail::reduce_elements(std::move(first), std::move(last), std::move(seed), reduce);
+		};
+
+		return detail::parallel_reduce(start, end, combine(), leaf, combine, executor);
+	}
+
+	/**
+    * Folds over this iterator pair with the given functions on the @ref default_thread_pool().
+	*/
+	template<typename ReduceFunction, typename CombineFunction>
+	typename std::decay<typename std::result_of<CombineFunction()>::type>::type
+	fold(ReduceFunction&& reduce, CombineFunction&& combine) const
 	{
-		return std::accumulate(start, end, std::forward<Seed>(seed), std::forward<Function>(function));
+		return fold(std::forward<ReduceFunction>(reduce), std::forward<CombineFunction>(combine), default_thread_pool());
+	}
+
+private:
+	size_hint get_size_hint(std::random_access_iterator_tag) const
+	{
+		return size_hint(size_hint::exact, static_cast<std::size_t>(std::distance(start, end)));
+	}
+
+	size_hint get_size_hint(std::input_iterator_tag) const
+	{
+		return size_hint();
 	}
 };
 
@@ -50,6 +105,17 @@ make_iterator_pair_reducible(It1&& start, It2&& end)
 	return iterator_pair_reducible<typename std::decay<It1>::type>(std::forward<It1>(start), std::forward<It2>(end));
 }
 
+namespace detail
+{
+	template<typename iterator_type>
+	struct reducible_element<iterator_pair_reducible<iterator_type>>
+	{
+		typedef typename std::iterator_traits<iterator_type>::value_type type;
+
+		static const bool value = true;
+	};
+}
+
 WENDA_REDUCERS_NAMESPACE_END
 
 #endif // WENDA_REDUCERS_REDUCIBLES_ITERATOR_PAIR_REDUCIBLE_H_INCLUDED
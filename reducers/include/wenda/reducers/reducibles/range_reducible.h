@@ -14,7 +14,11 @@
 #include <type_traits>
 
 #include "../reduce.h"
+#include "../reduced.h"
+#include "../size_hint.h"
 #include "../detail/is_range.h"
+#include "../detail/block_reduce.h"
+#include "../detail/reducible_element.h"
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
@@ -58,14 +62,42 @@ public:
 	*/
     template<typename FunctionType, typename SeedType>
 	SeedType reduce(FunctionType&& function, SeedType seed) const
+	{
+		return reduce(function, std::move(seed), typename detail::is_contiguous_range<Range>::type());
+	}
+
+	/**
+    * Returns the size hint of the range, which is exact if it has a size() member function or random access iterators.
+	*/
+	size_hint get_size_hint() const
+	{
+		return detail::default_size_hint(range);
+	}
+
+private:
+	template<typename FunctionType, typename SeedType>
+	SeedType reduce(FunctionType& function, SeedType seed, std::false_type) const
 	{
 		for (auto&& val : range)
 		{
-			seed = function(std::move(seed), val);
+			detail::accumulate_into(function, seed, val);
+
+			if (detail::is_reduced(seed))
+			{
+				break;
+			}
 		}
 
 		return seed;
 	}
+
+	template<typename FunctionType, typename SeedType>
+	SeedType reduce(FunctionType& function, SeedType seed, std::true_type) const
+	{
+		// contiguous elements are reduced as blocks by the functions that support them.
+		auto first = detail::contiguous_data(range);
+		return detail::reduce_elements(first, first + detail::contiguous_size(range), std::move(seed), function);
+	}
 };
 
 /**
@@ -78,6 +110,14 @@ range_reducible<Range> make_range_reducible(Range&& range)
 	return range_reducible<Range>(std::forward<Range>(range));
 }
 
+namespace detail
+{
+	template<typename Range>
+	struct reducible_element<range_reducible<Range>>
+		: reducible_element<typename std::remove_cv<typename std::remove_reference<Range>::type>::type>
+	{};
+}
+
 /**
 * Overload of the reduce function for ranges.
 */
@@ -5,17 +5,135 @@
 * @file sequence_reducible.h
 * This file implements a reducible that lazily generates a sequence of elements by
 * repeatedly adding a given element to the current one.
+* Sequences of integers can also be folded in parallel, as the i-th element of such
+* a sequence can be computed directly, which lets the sequence be split by index.
+* Sums, minimums and maximums of sequences of integers are computed in closed form, and reducing functions
+* that consume blocks receive the elements of such sequences generated by blocks.
 */
 
 #include "../reducers_common.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <utility>
 #include <type_traits>
 
+#include "../reduced.h"
+#include "../size_hint.h"
+#include "../detail/block_reduce.h"
+#include "../detail/indexed_reducible.h"
+#include "../detail/reducible_element.h"
+#include "../detail/parallel_reduce.h"
+#include "../executors/thread_pool.h"
+
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
+namespace detail
+{
+	/**
+    * @internal
+    * Trait to determine whether a sequence of the given element and offset types can be split by index.
+	*/
+	template<typename ElementType, typename OffsetType>
+	struct is_indexable_sequence
+	{
+		static const bool value = std::is_integral<ElementType>::value && std::is_integral<OffsetType>::value;
+	};
+
+	/**
+    * @internal
+    * Computes the reduction of the elements of an increasing sequence of integers over a built-in operation in closed form.
+    * The sequence is given by its first element, offset and number of elements, which must be positive.
+	*/
+	template<typename Operation>
+	struct sequence_closed_form
+	{
+		static const bool value = false;
+	};
+
+	template<typename T>
+	struct sequence_closed_form<std::plus<T>>
+	{
+		static const bool value = true;
+
+		template<typename OffsetType>
+		static T reduce(T first, OffsetType offset, std::size_t count)
+		{
+			// the sum of the offsets is offset * count * (count - 1) / 2, where the even factor is halved before
+			// the product, so that the sum wraps around in unsigned arithmetic exactly as the sequential one would.
+			typedef typename std::make_unsigned<typename std::common_type<T, OffsetType>::type>::type unsigned_t;
+			unsigned_t triangle = count % 2 == 0
+				? static_cast<unsigned_t>(count / 2) * static_cast<unsigned_t>(count - 1)
+				: static_cast<unsigned_t>(count) * static_cast<unsigned_t>((count - 1) / 2);
+			unsigned_t sum = static_cast<unsigned_t>(count) * static_cast<unsigned_t>(first) + triangle * static_cast<unsigned_t>(offset);
+			return static_cast<T>(sum);
+		}
+	};
+
+	template<typename T>
+	struct sequence_closed_form<min_operation<T>>
+	{
+		static const bool value = true;
+
+		template<typename OffsetType>
+		static T reduce(T first, OffsetType, std::size_t)
+		{
+			return first;
+		}
+	};
+
+	template<typename T>
+	struct sequence_closed_form<max_operation<T>>
+	{
+		static const bool value = true;
+
+		template<typename OffsetType>
+		static T reduce(T first, OffsetType offset, std::size_t count)
+		{
+			typedef typename std::make_unsigned<typename std::common_type<T, OffsetType>::type>::type unsigned_t;
+			return static_cast<T>(static_cast<unsigned_t>(first) + static_cast<unsigned_t>(count - 1) * static_cast<unsigned_t>(offset));
+		}
+	};
+
+	template<typename Operation>
+	struct sequence_closed_form<block_operation<Operation>>
+		: sequence_closed_form<Operation>
+	{};
+
+	/**
+    * @internal
+    * Tags selecting how a sequence is reduced: element by element, by generated blocks, or in closed form.
+	*/
+	struct sequence_loop_tag {};
+	struct sequence_block_tag {};
+	struct sequence_closed_form_tag {};
+
+	template<typename ElementType, typename OffsetType, typename Function, typename Seed>
+	struct sequence_reduce_tag
+	{
+		typedef typename std::decay<Function>::type function_t;
+
+		static const bool indexable = is_indexable_sequence<ElementType, OffsetType>::value;
+		static const bool closed_form =
+			indexable &&
+			sequence_closed_form<function_t>::value &&
+			std::is_same<Seed, ElementType>::value &&
+			std::is_same<ElementType, typename simd_operation_traits<function_t>::element_t>::value;
+		static const bool block = indexable && has_reduce_block_member_function<function_t, Seed, ElementType>::value;
+
+		typedef typename std::conditional<
+			closed_form,
+			sequence_closed_form_tag,
+			typename std::conditional<block, sequence_block_tag, sequence_loop_tag>::type
+		>::type type;
+	};
+}
+
 /**
 * This class implements a reducible that when corresponds to reducing over a sequence.
+* If the elements and the offset are integers, the sequence is also foldable: it is then
+* split by index, so that the folds run in parallel without materializing the sequence.
 */
 template<typename ElementType, typename OffsetType>
 class sequence_reducible
@@ -34,17 +152,193 @@ public:
 	*/
     template<typename Function, typename Seed>
 	Seed reduce(Function&& function, Seed seed) const
+	{
+		typedef typename detail::sequence_reduce_tag<ElementType, OffsetType, Function, Seed>::type tag_t;
+		return reduce_sequence(function, std::move(seed), tag_t());
+	}
+
+	/**
+    * Returns the number of elements in this sequence, which is also its exact size hint.
+    * The offset must be positive for the sequence to be non-empty.
+	*/
+	template<typename E = ElementType>
+	typename std::enable_if<detail::is_indexable_sequence<E, OffsetType>::value, std::size_t>::type
+	size() const
+	{
+		if (!(start < end) || !(offset > 0))
+		{
+			return 0;
+		}
+
+		// compute in unsigned arithmetic, so that the distance of signed sequences cannot overflow.
+		typedef typename std::make_unsigned<typename std::common_type<ElementType, OffsetType>::type>::type unsigned_t;
+		unsigned_t distance = static_cast<unsigned_t>(end) - static_cast<unsigned_t>(start);
+		unsigned_t step = static_cast<unsigned_t>(offset);
+		return static_cast<std::size_t>(distance / step + (distance % step != 0 ? 1 : 0));
+	}
+
+	/**
+    * Returns the size hint of this sequence, which is exact when its elements can be indexed.
+	*/
+	template<typename E = ElementType>
+	typename std::enable_if<detail::is_indexable_sequence<E, OffsetType>::value, size_hint>::type
+	get_size_hint() const
+	{
+		return size_hint(size_hint::exact, size());
+	}
+
+	/**
+    * Returns the element of this sequence at the given index.
+	*/
+	template<typename E = ElementType>
+	typename std::enable_if<detail::is_indexable_sequence<E, OffsetType>::value, ElementType>::type
+	at(std::size_t index) const
+	{
+		typedef typename std::make_unsigned<typename std::common_type<ElementType, OffsetType>::type>::type unsigned_t;
+		return static_cast<ElementType>(static_cast<unsigned_t>(start) + static_cast<unsigned_t>(index) * static_cast<unsigned_t>(offset));
+	}
+
+	/**
+    * Folds over this sequence with the given functions on the given executor.
+    * The sequence is split into subranges of indices, which are reduced in parallel.
+	*/
+	template<typename ReduceFunction, typename CombineFunction, typename Executor, typename E = ElementType>
+	typename std::enable_if<
+		detail::is_indexable_sequence<E, OffsetType>::value,
+		typename std::decay<typename std::result_of<CombineFunction()>::type>::type
+	>::type
+	fold(ReduceFunction&& reduce, CombineFunction&& combine, Executor& executor) const
+	{
+		typedef typename std::decay<typename std::result_of<CombineFunction()>::type>::type value_t;
+
+		typedef typename detail::sequence_reduce_tag<ElementType, OffsetType, ReduceFunction, value_t>::type tag_t;
+
+		auto leaf = [&](std::size_t first, std::size_t last, value_t seed) -> value_t
+		{
+			return reduce_indices(reduce, std::move(seed), first, last, tag_t());
+		};
+
+		return detail::parallel_reduce_index(0, size(), combine(), leaf, combine, executor);
+	}
+
+	/**
+    * Folds over this sequence with the given functions on the @ref default_thread_pool().
+	*/
+	template<typename ReduceFunction, typename CombineFunction, typename E = ElementType>
+	typename std::enable_if<
+		detail::is_indexable_sequence<E, OffsetType>::value,
+		typename std::decay<typename std::result_of<CombineFunction()>::type>::type
+	>::type
+	fold(ReduceFunction&& reduce, CombineFunction&& combine) const
+	{
+		return fold(std::forward<ReduceFunction>(reduce), std::forward<CombineFunction>(combine), default_thread_pool());
+	}
+
+private:
+	template<typename Function, typename Seed>
+	Seed reduce_sequence(Function& function, Seed seed, detail::sequence_loop_tag) const
 	{
 		auto val = start;
 
 		while (val < end)
 		{
-			seed = function(std::move(seed), val);
+			detail::accumulate_into(function, seed, val);
+
+			if (detail::is_reduced(seed))
+			{
+				break;
+			}
+
 			val = val + offset;
 		}
 
 		return seed;
 	}
+
+	template<typename Function, typename Seed, typename Tag>
+	Seed reduce_sequence(Function& function, Seed seed, Tag tag) const
+	{
+		return reduce_indices(function, std::move(seed), 0, size(), tag);
+	}
+
+	/**
+    * Reduces the elements of this sequence whose indices are in [first, last), one by one.
+	*/
+	template<typename Function, typename Seed>
+	Seed reduce_indices(Function& function, Seed seed, std::size_t first, std::size_t last, detail::sequence_loop_tag) const
+	{
+		if (first == last)
+		{
+			return seed;
+		}
+
+		auto val = at(first);
+
+		for (std::size_t i = first; i < last; ++i)
+		{
+			detail::accumulate_into(function, seed, val);
+
+			if (detail::is_reduced(seed))
+			{
+				break;
+			}
+
+			if (i + 1 < last)
+			{
+				val = val + offset;
+			}
+		}
+
+		return seed;
+	}
+
+	/**
+    * Reduces the elements of this sequence whose indices are in [first, last), by generating them into
+    * blocks that the function consumes.
+	*/
+	template<typename Function, typename Seed>
+	Seed reduce_indices(Function& function, Seed seed, std::size_t first, std::size_t last, detail::sequence_block_tag) const
+	{
+		typedef typename std::make_unsigned<typename std::common_type<ElementType, OffsetType>::type>::type unsigned_t;
+		ElementType buffer[detail::block_size];
+
+		while (first != last)
+		{
+			std::size_t count = (std::min)(detail::block_size, last - first);
+
+			// each element is computed from the first one of the block, so that the iterations are independent and vectorize.
+			unsigned_t base = static_cast<unsigned_t>(at(first));
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				buffer[i] = static_cast<ElementType>(base + static_cast<unsigned_t>(i) * static_cast<unsigned_t>(offset));
+			}
+
+			seed = function.reduce_block(std::move(seed), static_cast<ElementType const*>(buffer), static_cast<ElementType const*>(buffer + count));
+			first += count;
+
+			if (detail::is_reduced(seed))
+			{
+				break;
+			}
+		}
+
+		return seed;
+	}
+
+	/**
+    * Reduces the elements of this sequence whose indices are in [first, last) in closed form.
+	*/
+	template<typename Function, typename Seed>
+	Seed reduce_indices(Function& function, Seed seed, std::size_t first, std::size_t last, detail::sequence_closed_form_tag) const
+	{
+		if (first == last)
+		{
+			return seed;
+		}
+
+		typedef detail::sequence_closed_form<typename std::decay<Function>::type> closed_form_t;
+		return function(std::move(seed), closed_form_t::reduce(at(first), offset, last - first));
+	}
 };
 
 /**
@@ -65,6 +359,35 @@ make_sequence_reducible(Elem1&& start, Elem2&& end, OffsetType&& offset)
 	return return_t(std::forward<Elem1>(start), std::forward<Elem2>(end), std::forward<OffsetType>(offset));
 }
 
+namespace detail
+{
+	template<typename ElementType, typename OffsetType>
+	struct indexed_reducible<sequence_reducible<ElementType, OffsetType>, typename std::enable_if<is_indexable_sequence<ElementType, OffsetType>::value>::type>
+	{
+		typedef ElementType element_t;
+
+		static const bool value = true;
+
+		static std::size_t size(sequence_reducible<ElementType, OffsetType> const& sequence)
+		{
+			return sequence.size();
+		}
+
+		static element_t at(sequence_reducible<ElementType, OffsetType> const& sequence, std::size_t index)
+		{
+			return sequence.at(index);
+		}
+	};
+
+	template<typename ElementType, typename OffsetType>
+	struct reducible_element<sequence_reducible<ElementType, OffsetType>>
+	{
+		typedef ElementType type;
+
+		static const bool value = true;
+	};
+}
+
 WENDA_REDUCERS_NAMESPACE_END
 
 #endif // WENDA_REDUCERS_REDUCIBLES_SEQUENCE_REDUCIBLE_H_INCLUDED
\ No newline at end of file
@@ -0,0 +1,196 @@
+#ifndef WENDA_REDUCERS_SIZE_HINT_H_INCLUDED
+#define WENDA_REDUCERS_SIZE_HINT_H_INCLUDED
+
+/**
+* @file size_hint.h
+* This file contains the @ref size_hint type, which reports how many elements a reducible has before it is reduced,
+* and the get_size_hint() function that returns it.
+* Hints are exact for ranges, integer sequences and iterator pairs of random access iterators, and transformers propagate them:
+* map() preserves the hint of its source, filter(), take_while() and drop_while() turn it into an upper bound,
+* take() and drop() adjust its count, and collect() does not know how many elements it has.
+*/
+
+#include "reducers_common.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "detail/is_range.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+/**
+* This class describes the number of elements of a reducible, which is either exactly known, known not to exceed a bound, or unknown.
+*/
+struct size_hint
+{
+	/**
+    * The kinds of size hints.
+	*/
+	enum kind_t
+	{
+		unknown,     ///< nothing is known about the number of elements.
+		upper_bound, ///< the reducible has at most count elements.
+		exact        ///< the reducible has exactly count elements.
+	};
+
+	kind_t kind;       ///< the kind of this hint.
+	std::size_t count; ///< the number of elements, or their upper bound.
+
+	explicit size_hint(kind_t kind = unknown, std::size_t count = 0)
+		: kind(kind), count(kind == unknown ? 0 : count)
+	{}
+
+	/**
+    * Returns whether the number of elements is exactly known.
+	*/
+	bool is_exact() const
+	{
+		return kind == exact;
+	}
+
+	/**
+    * Returns whether the number of elements is bounded, that is, whether it is either exactly known or has an upper bound.
+	*/
+	bool is_bounded() const
+	{
+		return kind != unknown;
+	}
+
+	/**
+    * Returns the hint of a subset of the elements, which is bounded by this hint.
+	*/
+	size_hint as_upper_bound() const
+	{
+		return size_hint(kind == unknown ? unknown : upper_bound, count);
+	}
+
+	/**
+    * Returns the hint of at most the given number of first elements.
+	*/
+	size_hint limit(std::size_t maximum) const
+	{
+		return kind == unknown ? size_hint(upper_bound, maximum) : size_hint(kind, (std::min)(count, maximum));
+	}
+
+	/**
+    * Returns the hint of the elements that follow the given number of first elements.
+	*/
+	size_hint skip(std::size_t skipped) const
+	{
+		return size_hint(kind, count > skipped ? count - skipped : 0);
+	}
+};
+
+namespace detail
+{
+	/**
+    * @internal
+    * Trait to determine whether a reducible reports its own size hint through a get_size_hint() member function.
+	*/
+	template<typename T>
+	class has_size_hint_member_function
+	{
+		template<typename U> static std::true_type test(
+			typename std::enable_if<std::is_convertible<decltype(std::declval<U const&>().get_size_hint()), size_hint>::value, int>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<T>(0)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Trait to determine whether a range has a size() member function, such as the standard containers.
+    * Only ranges count, since the size() of other reducibles, such as splittable reducibles, may be an estimate.
+	*/
+	template<typename T>
+	class has_size_member_function
+	{
+		template<typename U> static std::true_type test(
+			typename std::enable_if<is_range<U const&>::value && std::is_convertible<decltype(std::declval<U const&>().size()), std::size_t>::value, int>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<T>(0)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Tags selecting how the size hint of a reducible is determined.
+	*/
+	struct size_hint_member_tag {};
+	struct size_member_tag {};
+	struct random_access_range_tag {};
+	struct unknown_size_tag {};
+
+	template<typename T>
+	struct size_hint_tag
+	{
+		typedef typename std::conditional<
+			has_size_hint_member_function<T>::value,
+			size_hint_member_tag,
+			typename std::conditional<
+				has_size_member_function<T>::value,
+				size_member_tag,
+				typename std::conditional<is_random_access_range<T>::value, random_access_range_tag, unknown_size_tag>::type
+			>::type
+		>::type type;
+	};
+
+	template<typename Reducible>
+	size_hint default_size_hint(Reducible const& reducible, size_hint_member_tag)
+	{
+		return reducible.get_size_hint();
+	}
+
+	template<typename Reducible>
+	size_hint default_size_hint(Reducible const& reducible, size_member_tag)
+	{
+		return size_hint(size_hint::exact, static_cast<std::size_t>(reducible.size()));
+	}
+
+	template<typename Reducible>
+	size_hint default_size_hint(Reducible const& reducible, random_access_range_tag)
+	{
+		using std::begin;
+		using std::end;
+		return size_hint(size_hint::exact, static_cast<std::size_t>(std::distance(begin(reducible), end(reducible))));
+	}
+
+	template<typename Reducible>
+	size_hint default_size_hint(Reducible const&, unknown_size_tag)
+	{
+		return size_hint();
+	}
+
+	/**
+    * @internal
+    * Returns the size hint of a reducible from its members, or from its iterators if it is a random access range.
+	*/
+	template<typename Reducible>
+	size_hint default_size_hint(Reducible const& reducible)
+	{
+		return default_size_hint(reducible, typename size_hint_tag<Reducible>::type());
+	}
+}
+
+/**
+* Returns what is known of the number of elements of the given reducible before it is reduced.
+* Reducibles may report it through a get_size_hint() member function or an overload of this function, and otherwise
+* have an exact hint if they are ranges with a size() member function or random access ranges.
+* Other reducibles, including splittable reducibles whose size() is only an estimate, have an unknown size.
+* This function is overloaded for the transformers of the library.
+*/
+template<typename Reducible>
+size_hint get_size_hint(Reducible const& reducible)
+{
+	return detail::default_size_hint(reducible);
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_SIZE_HINT_H_INCLUDED
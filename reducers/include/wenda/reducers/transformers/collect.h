@@ -4,6 +4,9 @@
 /**
 * @file collect.h
 * This file implements the collect() transformer for reducibles.
+* When a collected reducible is folded, the expanded reducibles are themselves folded on the same
+* executor whenever they are foldable, so that pipelines with a few large inner sequences still use all workers.
+* Sink-style expanders emit their elements directly into the reduction instead, which avoids creating a container per element.
 */
 
 #include "../reducers_common.h"
@@ -13,11 +16,77 @@
 
 #include "../reduce.h"
 #include "../fold.h"
+#include "../size_hint.h"
+#include "../reduced.h"
+#include "../detail/stored_reducible.h"
+#include "../detail/reducible_element.h"
+#include "../detail/parallel_reduce.h"
+#include "../executors/partitioners.h"
+#include "../executors/thread_pool.h"
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
 namespace detail
 {
+	/**
+    * @internal
+    * The sink that collect() passes to sink-style expanders.
+    * It reduces each element that it is called with into the seed of the current reduction,
+    * and returns whether the reduction continues, so that the expander may stop once it has terminated.
+	*/
+	template<typename Reducer, typename Seed>
+	struct collect_sink
+	{
+		Reducer const& reducer;
+		Seed& seed;
+
+		collect_sink(Reducer const& reducer, Seed& seed)
+			: reducer(reducer), seed(seed)
+		{
+		}
+
+		template<typename Value>
+		bool operator()(Value&& value)
+		{
+			if (!is_reduced(seed))
+			{
+				accumulate_into(reducer, seed, std::forward<Value>(value));
+			}
+
+			return !is_reduced(seed);
+		}
+	};
+
+	/**
+    * @internal
+    * Trait to determine whether an expander is sink-style, that is, whether it can be invoked with a value and a sink.
+	*/
+	template<typename Expander, typename Value, typename Sink>
+	class is_sink_expander
+	{
+		template<typename U> static std::true_type test(
+			typename std::add_pointer<decltype(std::declval<U const&>()(std::declval<Value>(), std::declval<Sink&>()))>::type);
+		template<typename U> static std::false_type test(...);
+	public:
+		typedef decltype(test<Expander>(nullptr)) type;
+		static const bool value = type::value;
+	};
+
+	/**
+    * @internal
+    * Reduces the elements that a sink-style expander emits for the given value into the seed.
+	*/
+	template<typename Reducer, typename Expander, typename Seed, typename Value>
+	typename std::decay<Seed>::type expand_into_sink(Reducer const& reducer, Expander const& expander, Seed&& seed, Value&& value)
+	{
+		typedef typename std::decay<Seed>::type seed_t;
+
+		seed_t current(std::forward<Seed>(seed));
+		collect_sink<Reducer, seed_t> sink(reducer, current);
+		expander(std::forward<Value>(value), sink);
+		return current;
+	}
+
     template<typename Reducer, typename Expander>
 	struct collect_reducing_function
 	{
@@ -29,11 +98,100 @@ namespace detail
 		{
 		}
 
+		template<typename Seed, typename Value>
+		typename std::decay<Seed>::type expand(Seed&& seed, Value&& value, std::true_type) const
+		{
+			return expand_into_sink(reducer, expander, std::forward<Seed>(seed), std::forward<Value>(value));
+		}
+
+		template<typename Seed, typename Value>
+		typename std::decay<Seed>::type expand(Seed&& seed, Value&& value, std::false_type) const
+		{
+			return expander(std::forward<Value>(value))
+				   | reduce(reducer, std::forward<Seed>(seed));
+		}
+
         template<typename Value, typename Seed>
 		typename std::decay<Seed>::type operator()(Seed&& seed, Value&& value) const
 		{
-			return expander(std::forward<Value>(value)) 
-				   | reduce(reducer, std::forward<Seed>(seed));
+			typedef collect_sink<Reducer, typename std::decay<Seed>::type> sink_t;
+			typedef typename is_sink_expander<Expander, Value, sink_t>::type is_sink_t;
+			return expand(std::forward<Seed>(seed), std::forward<Value>(value), is_sink_t());
+		}
+	};
+
+	/**
+    * @internal
+    * Returns the executor on which the inner reducibles of a collect are folded.
+    * Unless a partitioner was chosen explicitly, they are split lazily, so that an inner fold only
+    * exposes work when some workers are idle, and short inner reducibles are not split needlessly.
+	*/
+	template<typename Executor>
+	typename std::enable_if<has_partitioner<Executor>::value, Executor&>::type
+	nested_executor(Executor& executor)
+	{
+		return executor;
+	}
+
+	template<typename Executor>
+	typename std::enable_if<!has_partitioner<Executor>::value, partitioned_executor<Executor&, lazy_partitioner>>::type
+	nested_executor(Executor& executor)
+	{
+		return with_partitioner(executor, lazy_partitioner());
+	}
+
+	/**
+    * @internal
+    * This struct implements the functor type used when folding a collected reducible.
+    * Each expanded reducible is folded on the executor if it is foldable, and reduced sequentially otherwise.
+	*/
+	template<typename Reducer, typename Combine, typename Expander, typename Executor>
+	struct collect_folding_function
+	{
+		Reducer const& reducer;
+		Combine const& combine;
+		Expander const& expander;
+		Executor& executor;
+
+		collect_folding_function(Reducer const& reducer, Combine const& combine, Expander const& expander, Executor& executor)
+			: reducer(reducer), combine(combine), expander(expander), executor(executor)
+		{
+		}
+
+		template<typename Seed, typename Inner>
+		typename std::decay<Seed>::type fold_inner(Seed&& seed, Inner&& inner, std::true_type) const
+		{
+			typedef typename std::decay<Seed>::type value_t;
+			auto innerExecutor = nested_executor(executor);
+			return combine_in_order(combine, value_t(std::forward<Seed>(seed)), value_t(fold(std::forward<Inner>(inner), reducer, combine, innerExecutor)));
+		}
+
+		template<typename Seed, typename Inner>
+		typename std::decay<Seed>::type fold_inner(Seed&& seed, Inner&& inner, std::false_type) const
+		{
+			return std::forward<Inner>(inner) | reduce(reducer, std::forward<Seed>(seed));
+		}
+
+		template<typename Seed, typename Value>
+		typename std::decay<Seed>::type expand(Seed&& seed, Value&& value, std::true_type) const
+		{
+			return expand_into_sink(reducer, expander, std::forward<Seed>(seed), std::forward<Value>(value));
+		}
+
+		template<typename Seed, typename Value>
+		typename std::decay<Seed>::type expand(Seed&& seed, Value&& value, std::false_type) const
+		{
+			typedef typename std::decay<decltype(expander(std::forward<Value>(value)))>::type inner_t;
+			typedef std::integral_constant<bool, is_executor_foldable<inner_t, Reducer const&, Combine const&, Executor>::value> foldable_t;
+			return fold_inner(std::forward<Seed>(seed), expander(std::forward<Value>(value)), foldable_t());
+		}
+
+		template<typename Value, typename Seed>
+		typename std::decay<Seed>::type operator()(Seed&& seed, Value&& value) const
+		{
+			typedef collect_sink<Reducer, typename std::decay<Seed>::type> sink_t;
+			typedef typename is_sink_expander<Expander, Value, sink_t>::type is_sink_t;
+			return expand(std::forward<Seed>(seed), std::forward<Value>(value), is_sink_t());
 		}
 	};
 
@@ -49,6 +207,38 @@ namespace detail
 	};
 }
 
+/**
+* This class is a reference to the sink that collect() passes to sink-style expanders, for expanders
+* that cannot be generic, such as lambdas before C++14. It refers to the sink without allocating,
+* and forwards the elements to it through a function pointer.
+* Calling it with an element reduces the element, and returns false once the reduction has terminated,
+* in which case the expander may stop emitting.
+* @tparam T The type of the elements that the expander emits.
+*/
+template<typename T>
+class emitter
+{
+	void* sink;
+	bool (*emitFunction)(void*, T const&);
+
+	template<typename Sink>
+	static bool emit_to(void* sink, T const& value)
+	{
+		return (*static_cast<Sink*>(sink))(value);
+	}
+public:
+	template<typename Sink>
+	emitter(Sink& sink, typename std::enable_if<!std::is_same<Sink, emitter>::value>::type* = nullptr)
+		: sink(&sink), emitFunction(&emit_to<Sink>)
+	{
+	}
+
+	bool operator()(T const& value) const
+	{
+		return emitFunction(sink, value);
+	}
+};
+
 /**
 * This class implements a reducible that corresponds to
 * a source reducible that has been mapped through the expand function
@@ -66,6 +256,62 @@ struct collect_reducible
 	}
 };
 
+/**
+* Overloads the get_size_hint() function for reducibles of type @ref collect_reducible,
+* whose number of elements is unknown until the elements of the source are expanded.
+*/
+template<typename Reducible, typename ExpandFunction>
+size_hint get_size_hint(collect_reducible<Reducible, ExpandFunction> const&)
+{
+	return size_hint();
+}
+
+namespace detail
+{
+	template<typename Reducible, typename ExpandFunction, typename ReduceFunction, typename CombineFunction, typename Executor>
+	struct is_executor_foldable<collect_reducible<Reducible, ExpandFunction>, ReduceFunction, CombineFunction, Executor>
+		: is_executor_foldable<Reducible, ReduceFunction, CombineFunction, Executor>
+	{};
+
+	/**
+    * @internal
+    * The elements of the reducibles that an expander returns for elements of the given type, if they are known.
+    * Sink-style expanders return no reducible, and the type of their elements is not known.
+	*/
+	template<typename ExpandFunction, typename Source, typename Enable = void>
+	struct expanded_element
+	{
+		static const bool value = false;
+	};
+
+	template<typename ExpandFunction, typename Source>
+	struct expanded_element<ExpandFunction, Source, typename std::enable_if<
+		reducible_element<typename std::decay<decltype(std::declval<ExpandFunction const&>()(std::declval<Source const&>()))>::type>::value
+	>::type>
+		: reducible_element<typename std::decay<decltype(std::declval<ExpandFunction const&>()(std::declval<Source const&>()))>::type>
+	{};
+
+	/**
+    * @internal
+    * The elements of a collect are those of the expanded reducibles, if the elements of its source are known.
+	*/
+	template<typename Reducible, typename ExpandFunction, bool Known = reducible_element<typename std::remove_cv<typename std::remove_reference<Reducible>::type>::type>::value>
+	struct collect_element
+	{
+		static const bool value = false;
+	};
+
+	template<typename Reducible, typename ExpandFunction>
+	struct collect_element<Reducible, ExpandFunction, true>
+		: expanded_element<ExpandFunction, typename reducible_element<typename std::remove_cv<typename std::remove_reference<Reducible>::type>::type>::type>
+	{};
+
+	template<typename Reducible, typename ExpandFunction>
+	struct reducible_element<collect_reducible<Reducible, ExpandFunction>>
+		: collect_element<Reducible, ExpandFunction>
+	{};
+}
+
 /**
 * Overload the reduce() function for references to @ref collect_reducible.
 */
@@ -94,47 +340,81 @@ typename std::decay<Seed>::type reduce(collect_reducible<Reducible, ExpandFuncti
 
 /**
 * Overload the fold() function for references to @ref collect_reducible.
+* The expanded reducibles are folded on the @ref default_thread_pool().
 */
 template<typename Foldable, typename ExpandFunction, typename Reduce, typename Combine>
 typename detail::fold_return_type<collect_reducible<Foldable, ExpandFunction>, Reduce, Combine>::type
 fold(collect_reducible<Foldable, ExpandFunction> const& foldable, Reduce&& reduce, Combine&& combine)
 {
-	typedef detail::collect_reducing_function<typename std::decay<Reduce>::type, ExpandFunction> collect_reducer_t;
+	typedef detail::collect_folding_function<typename std::decay<Reduce>::type, typename std::decay<Combine>::type, ExpandFunction, thread_pool> collect_folder_t;
 	return fold(
 		foldable.reducible,
-		collect_reducer_t(std::forward<Reduce>(reduce), foldable.expandFunction), 
-		std::forward<Combine>(combine));
+		collect_folder_t(reduce, combine, foldable.expandFunction, default_thread_pool()),
+		combine);
 }
 
 /**
 * Overload the fold() function for r-value references to @ref collect_reducible.
+* The expanded reducibles are folded on the @ref default_thread_pool().
 */
 template<typename Foldable, typename ExpandFunction, typename Reduce, typename Combine>
 typename detail::fold_return_type<collect_reducible<Foldable, ExpandFunction>, Reduce, Combine>::type
 fold(collect_reducible<Foldable, ExpandFunction>&& foldable, Reduce&& reduce, Combine&& combine)
 {
-	typedef detail::collect_reducing_function<typename std::decay<Reduce>::type, ExpandFunction> collect_reducer_t;
+	typedef detail::collect_folding_function<typename std::decay<Reduce>::type, typename std::decay<Combine>::type, ExpandFunction, thread_pool> collect_folder_t;
+	return fold(
+		std::move(foldable.reducible),
+		collect_folder_t(reduce, combine, foldable.expandFunction, default_thread_pool()),
+		combine);
+}
+
+/**
+* Overload the fold() function for references to @ref collect_reducible, running on the given executor.
+* The expanded reducibles are folded on the same executor.
+*/
+template<typename Foldable, typename ExpandFunction, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<collect_reducible<Foldable, ExpandFunction>, Reduce, Combine>::type
+fold(collect_reducible<Foldable, ExpandFunction> const& foldable, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	typedef detail::collect_folding_function<typename std::decay<Reduce>::type, typename std::decay<Combine>::type, ExpandFunction, typename std::remove_reference<Executor>::type> collect_folder_t;
+	return fold(
+		foldable.reducible,
+		collect_folder_t(reduce, combine, foldable.expandFunction, executor),
+		combine,
+		executor);
+}
+
+/**
+* Overload the fold() function for r-value references to @ref collect_reducible, running on the given executor.
+* The expanded reducibles are folded on the same executor.
+*/
+template<typename Foldable, typename ExpandFunction, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<collect_reducible<Foldable, ExpandFunction>, Reduce, Combine>::type
+fold(collect_reducible<Foldable, ExpandFunction>&& foldable, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	typedef detail::collect_folding_function<typename std::decay<Reduce>::type, typename std::decay<Combine>::type, ExpandFunction, typename std::remove_reference<Executor>::type> collect_folder_t;
 	return fold(
 		std::move(foldable.reducible),
-		collect_reducer_t(std::forward<Reduce>(reduce), std::move(foldable.expandFunction)), 
-		std::forward<Combine>(combine));
+		collect_folder_t(reduce, combine, foldable.expandFunction, executor),
+		combine,
+		executor);
 }
 
 namespace detail
 {
     template<typename Reducible, typename ExpandFunction>
-    collect_reducible<typename std::decay<Reducible>::type, ExpandFunction>
+    collect_reducible<typename detail::stored_reducible<Reducible>::type, ExpandFunction>
 	operator|(Reducible&& reducible, collect_reducible_expression<ExpandFunction> const& expr)
 	{
-		typedef collect_reducible<typename std::decay<Reducible>::type, ExpandFunction> return_t;
+		typedef collect_reducible<typename detail::stored_reducible<Reducible>::type, ExpandFunction> return_t;
 		return return_t(std::forward<Reducible>(reducible), expr.expandFunction);
 	}
 
     template<typename Reducible, typename ExpandFunction>
-    collect_reducible<typename std::decay<Reducible>::type, ExpandFunction>
+    collect_reducible<typename detail::stored_reducible<Reducible>::type, ExpandFunction>
 	operator|(Reducible&& reducible, collect_reducible_expression<ExpandFunction>&& expr)
 	{
-		typedef collect_reducible<typename std::decay<Reducible>::type, ExpandFunction> return_t;
+		typedef collect_reducible<typename detail::stored_reducible<Reducible>::type, ExpandFunction> return_t;
 		return return_t(std::forward<Reducible>(reducible), std::move(expr.expandFunction));
 	}
 }
@@ -144,15 +424,18 @@ namespace detail
 * with each element expanded to a reducible by the expansion function,
 * and subsequently flattened.
 * It corresponds to SelectMany in C#, or the monadic bind in sequence monads.
+* The expansion function may also be sink-style, with signature (Value, Sink&) -> void: it then calls the sink
+* with each element of the expansion, which is reduced immediately, so that no inner reducible is created.
+* The sink can be taken as an @ref emitter of the element type by expanders that cannot be generic.
 * @param reducible The reducible to collect
-* @param expandFunction The expansion function. It must have signature (Value) -> Reducible.
+* @param expandFunction The expansion function. It must have signature (Value) -> Reducible, or be sink-style.
 * @returns A reducible object implementing the indicated behaviour.
 */
 template<typename Reducible, typename ExpandFunction>
-collect_reducible<typename std::decay<Reducible>::type, typename std::decay<ExpandFunction>::type>
+collect_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<ExpandFunction>::type>
 collect(Reducible&& reducible, ExpandFunction&& expandFunction)
 {
-	typedef collect_reducible<typename std::decay<Reducible>::type, typename std::decay<ExpandFunction>::type> return_type;
+	typedef collect_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<ExpandFunction>::type> return_type;
 	return return_type(std::forward<Reducible>(reducible), std::forward<ExpandFunction>(expandFunction));
 }
 
@@ -160,7 +443,7 @@ collect(Reducible&& reducible, ExpandFunction&& expandFunction)
 * Expands and flattens the given reducible with the given expansion function.
 * This is similar to the two-argument version, except that the reducible should
 * be passed in by pipeing.
-* @param expandFunction The expansion function. It must have signature (Value) -> Reducible.
+* @param expandFunction The expansion function. It must have signature (Value) -> Reducible, or be sink-style.
 */
 template<typename ExpandFunction>
 detail::collect_reducible_expression<typename std::decay<ExpandFunction>::type>
@@ -13,11 +13,41 @@
 
 #include "../reduce.h"
 #include "../fold.h"
+#include "../size_hint.h"
+#include "../detail/stored_reducible.h"
+#include "../detail/reducible_element.h"
+#include "../detail/accumulate.h"
+#include "../detail/block_reduce.h"
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
 namespace detail
 {
+	/**
+    * @internal
+    * Determines how a filtered reducer consumes blocks of arithmetic elements of type T.
+    * Blocks are masked when the reducer is a built-in operation over T with a known unit,
+    * and they are compacted when the reducer otherwise consumes blocks.
+	*/
+	template<typename Predicate, typename Reducer, typename Seed, typename T>
+	struct filter_block_traits
+	{
+		static const bool applies =
+			std::is_arithmetic<T>::value &&
+			!std::is_void<typename block_result<Predicate, T>::type>::value;
+
+		static const bool masked =
+			applies &&
+			masked_operation<Reducer>::value &&
+			std::is_same<Seed, T>::value &&
+			std::is_same<T, typename simd_operation_traits<typename masked_operation<Reducer>::operation_t>::element_t>::value;
+
+		static const bool compacted =
+			applies &&
+			!masked &&
+			has_reduce_block_member_function<Reducer, Seed, T>::value;
+	};
+
     template<typename Predicate, typename Reducer>
 	struct filter_reducible_function
 	{
@@ -30,17 +60,101 @@ namespace detail
 		}
 
         template<typename Seed, typename Value>
-		typename std::decay<Seed>::type operator ()(Seed&& seed, Value&& value) const
+		typename std::enable_if<
+			!is_in_place_reducer<Reducer const, typename std::decay<Seed>::type, Value>::value,
+			typename std::decay<Seed>::type
+		>::type
+		operator ()(Seed&& seed, Value&& value) const
 		{
 			if (predicate(value))
 			{
-				return reducer(std::forward<Value>(seed), std::forward<Seed>(value));
+				return reducer(std::forward<Seed>(seed), std::forward<Value>(value));
 			}
 			else
 			{
 				return std::forward<Seed>(seed);
 			}
 		}
+
+		/**
+        * Reduces an element in place if it satisfies the predicate, when the reducer reduces in place.
+		*/
+        template<typename Seed, typename Value>
+		typename std::enable_if<is_in_place_reducer<Reducer const, Seed, Value>::value>::type
+		operator ()(Seed& seed, Value&& value) const
+		{
+			if (predicate(value))
+			{
+				reducer(seed, std::forward<Value>(value));
+			}
+		}
+
+		/**
+        * Reduces an element in place into a seed passed by value if it satisfies the predicate, when the reducer reduces in place.
+		*/
+        template<typename Seed, typename Value>
+		typename std::enable_if<!std::is_reference<Seed>::value && is_in_place_reducer<Reducer const, Seed, Value>::value, Seed>::type
+		operator ()(Seed&& seed, Value&& value) const
+		{
+			if (predicate(value))
+			{
+				reducer(seed, std::forward<Value>(value));
+			}
+
+			return std::move(seed);
+		}
+
+		/**
+        * Reduces a block of arithmetic elements into a built-in operation with a known unit,
+        * by replacing the elements that do not satisfy the predicate with the unit, so that the
+        * masked block is reduced by the kernels without branching, whatever the selectivity of the predicate.
+		*/
+		template<typename Seed, typename T>
+		typename std::enable_if<filter_block_traits<Predicate, Reducer, Seed, T>::masked, Seed>::type
+		reduce_block(Seed seed, T const* first, T const* last) const
+		{
+			typedef typename masked_operation<Reducer>::operation_t operation_t;
+			typedef typename masked_operation<Reducer>::block_t block_t;
+
+			T const unit = operation_unit<operation_t>();
+
+			auto transform = [this, unit](T const* values, std::size_t count, T* buffer) -> std::size_t
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					buffer[i] = predicate(values[i]) ? values[i] : unit;
+				}
+
+				return count;
+			};
+
+			return reduce_buffered_blocks<T>(first, last, std::move(seed), transform, block_t());
+		}
+
+		/**
+        * Reduces a block of arithmetic elements, by compacting the elements that satisfy the predicate
+        * into a buffer that the reducer reduces as a block.
+		*/
+		template<typename Seed, typename T>
+		typename std::enable_if<filter_block_traits<Predicate, Reducer, Seed, T>::compacted, Seed>::type
+		reduce_block(Seed seed, T const* first, T const* last) const
+		{
+			auto transform = [this](T const* values, std::size_t count, T* buffer) -> std::size_t
+			{
+				std::size_t kept = 0;
+
+				// every value is written, and only kept if it satisfies the predicate, which avoids branching.
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					buffer[kept] = values[i];
+					kept += predicate(values[i]) ? 1 : 0;
+				}
+
+				return kept;
+			};
+
+			return reduce_buffered_blocks<T>(first, last, std::move(seed), transform, reducer);
+		}
 	};
 }
 
@@ -61,6 +175,28 @@ struct filter_reducible
 	}
 };
 
+/**
+* Overloads the get_size_hint() function for reducibles of type @ref filter_reducible, whose number of elements is bounded by that of their source.
+*/
+template<typename Reducible, typename Predicate>
+size_hint get_size_hint(filter_reducible<Reducible, Predicate> const& reducible)
+{
+	return get_size_hint(reducible.reducible).as_upper_bound();
+}
+
+namespace detail
+{
+	template<typename Reducible, typename Predicate, typename ReduceFunction, typename CombineFunction, typename Executor>
+	struct is_executor_foldable<filter_reducible<Reducible, Predicate>, ReduceFunction, CombineFunction, Executor>
+		: is_executor_foldable<Reducible, ReduceFunction, CombineFunction, Executor>
+	{};
+
+	template<typename Reducible, typename Predicate>
+	struct reducible_element<filter_reducible<Reducible, Predicate>>
+		: reducible_element<typename std::remove_cv<typename std::remove_reference<Reducible>::type>::type>
+	{};
+}
+
 /**
 * Overloads the reduce() function to reduce reducibles of type @ref filter_reducible.
 */
@@ -117,6 +253,38 @@ fold(filter_reducible<Foldable, Predicate>&& foldable, Reduce&& reduce, Combine&
 		std::forward<Combine>(combine));
 }
 
+/**
+* Overloads the fold() function to fold @ref filter_reducible on the given executor.
+*/
+template<typename Foldable, typename Predicate, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<filter_reducible<Foldable, Predicate>, Reduce, Combine>::type
+fold(filter_reducible<Foldable, Predicate> const& foldable, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	typedef detail::filter_reducible_function<Predicate, typename std::decay<Reduce>::type> filter_fold_t;
+
+	return fold(
+		foldable.reducible,
+		filter_fold_t(foldable.predicate, std::forward<Reduce>(reduce)),
+		std::forward<Combine>(combine),
+		executor);
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref filter_reducible on the given executor.
+*/
+template<typename Foldable, typename Predicate, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<filter_reducible<Foldable, Predicate>, Reduce, Combine>::type
+fold(filter_reducible<Foldable, Predicate>&& foldable, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	typedef detail::filter_reducible_function<Predicate, typename std::decay<Reduce>::type> filter_fold_t;
+
+	return fold(
+		std::move(foldable.reducible),
+		filter_fold_t(std::move(foldable.predicate), std::forward<Reduce>(reduce)),
+		std::forward<Combine>(combine),
+		executor);
+}
+
 namespace detail
 {
 	template<typename Predicate>
@@ -139,10 +307,10 @@ namespace detail
 * @returns A new reducible that implements the filtering reduce behaviour.
 */
 template<typename Reducible, typename Predicate>
-filter_reducible<typename std::decay<Reducible>::type, typename std::decay<Predicate>::type> 
+filter_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<Predicate>::type> 
 filter(Reducible&& reducible, Predicate&& predicate)
 {
-	typedef filter_reducible<typename std::decay<Reducible>::type, typename std::decay<Predicate>::type> return_type;
+	typedef filter_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<Predicate>::type> return_type;
 	return return_type(std::forward<Reducible>(reducible), std::forward<Predicate>(predicate));
 }
 
@@ -164,18 +332,18 @@ filter(Predicate&& predicate)
 namespace detail
 {
     template<typename Reducible, typename Predicate>
-    filter_reducible<typename std::decay<Reducible>::type, Predicate>
+    filter_reducible<typename detail::stored_reducible<Reducible>::type, Predicate>
 	operator|(Reducible&& reducible, filter_reducible_expression<Predicate> const& expr)
 	{
-		typedef filter_reducible<typename std::decay<Reducible>::type, Predicate> return_t;
+		typedef filter_reducible<typename detail::stored_reducible<Reducible>::type, Predicate> return_t;
 		return return_t(std::forward<Reducible>(reducible), expr.predicate);
 	}
 
     template<typename Reducible, typename Predicate>
-    filter_reducible<typename std::decay<Reducible>::type, Predicate>
+    filter_reducible<typename detail::stored_reducible<Reducible>::type, Predicate>
 	operator|(Reducible&& reducible, filter_reducible_expression<Predicate>&& expr)
 	{
-		typedef filter_reducible<typename std::decay<Reducible>::type, Predicate> return_t;
+		typedef filter_reducible<typename detail::stored_reducible<Reducible>::type, Predicate> return_t;
 		return return_t(std::forward<Reducible>(reducible), std::move(expr.predicate));
 	}
 }
@@ -8,11 +8,18 @@
 
 #include "../reducers_common.h"
 
+#include <cstddef>
 #include <utility>
 #include <type_traits>
 
 #include "../reduce.h"
 #include "../fold.h"
+#include "../size_hint.h"
+#include "../detail/stored_reducible.h"
+#include "../detail/indexed_reducible.h"
+#include "../detail/reducible_element.h"
+#include "../detail/accumulate.h"
+#include "../detail/block_reduce.h"
 
 WENDA_REDUCERS_NAMESPACE_BEGIN
 
@@ -20,6 +27,21 @@ namespace detail
 {
 	/**
     * @internal
+    * Trait to determine whether a map can transform blocks of elements of type T, which requires
+    * the mapped values to be arithmetic and the reducer to support blocks of them.
+	*/
+	template<typename MapFunction, typename Reducer, typename Seed, typename T>
+	struct enable_map_block
+	{
+		typedef typename block_result<MapFunction, T>::type mapped_t;
+
+		static const bool value =
+			std::is_arithmetic<mapped_t>::value &&
+			has_reduce_block_member_function<Reducer, Seed, mapped_t>::value;
+	};
+
+	/**
+    * @internal
     * This struct implements the functor type used when reducing
     * a reducible as transformed by a map() transformer.
 	*/
@@ -35,10 +57,64 @@ namespace detail
 		}
 
         template<typename Value, typename Seed>
-		typename std::decay<Seed>::type operator()(Seed&& seed, Value&& value) const
+		typename std::enable_if<
+			!is_in_place_reducer<Reducer const, typename std::decay<Seed>::type, typename std::result_of<MapFunction const&(Value)>::type>::value,
+			typename std::decay<Seed>::type
+		>::type
+		operator()(Seed&& seed, Value&& value) const
 		{
 			return reducer(std::forward<Seed>(seed), mapFunction(std::forward<Value>(value)));
 		}
+
+		/**
+        * Reduces a mapped element in place, when the reducer does.
+		*/
+        template<typename Value, typename Seed>
+		typename std::enable_if<
+			is_in_place_reducer<Reducer const, Seed, typename std::result_of<MapFunction const&(Value)>::type>::value
+		>::type
+		operator()(Seed& seed, Value&& value) const
+		{
+			reducer(seed, mapFunction(std::forward<Value>(value)));
+		}
+
+		/**
+        * Reduces a mapped element in place into a seed passed by value, when the reducer reduces in place,
+        * so that the mapped reducer may be used by reducibles that accumulate by value.
+		*/
+        template<typename Value, typename Seed>
+		typename std::enable_if<
+			!std::is_reference<Seed>::value &&
+			is_in_place_reducer<Reducer const, Seed, typename std::result_of<MapFunction const&(Value)>::type>::value,
+			Seed
+		>::type
+		operator()(Seed&& seed, Value&& value) const
+		{
+			reducer(seed, mapFunction(std::forward<Value>(value)));
+			return std::move(seed);
+		}
+
+		/**
+        * Reduces a block of elements, by mapping them into a buffer that the reducer reduces as a block.
+		*/
+		template<typename Seed, typename T>
+		typename std::enable_if<enable_map_block<MapFunction, Reducer, Seed, T>::value, Seed>::type
+		reduce_block(Seed seed, T const* first, T const* last) const
+		{
+			typedef typename enable_map_block<MapFunction, Reducer, Seed, T>::mapped_t mapped_t;
+
+			auto transform = [this](T const* values, std::size_t count, mapped_t* buffer) -> std::size_t
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					buffer[i] = mapFunction(values[i]);
+				}
+
+				return count;
+			};
+
+			return reduce_buffered_blocks<mapped_t>(first, last, std::move(seed), transform, reducer);
+		}
 	};
 }
 
@@ -61,6 +137,81 @@ struct map_reducible
 	}
 };
 
+/**
+* Overloads the get_size_hint() function for reducibles of type @ref map_reducible, which have as many elements as their source.
+*/
+template<typename MapFunction, typename Reducible>
+size_hint get_size_hint(map_reducible<MapFunction, Reducible> const& reducible)
+{
+	return get_size_hint(reducible.reducible);
+}
+
+namespace detail
+{
+	template<typename MapFunction, typename Reducible, typename ReduceFunction, typename CombineFunction, typename Executor>
+	struct is_executor_foldable<map_reducible<MapFunction, Reducible>, ReduceFunction, CombineFunction, Executor>
+		: is_executor_foldable<Reducible, ReduceFunction, CombineFunction, Executor>
+	{};
+
+	/**
+    * @internal
+    * Maps the elements of the source of a map by index, if the source can be accessed by index.
+	*/
+	template<typename MapFunction, typename Reducible, bool Indexed = indexed_reducible<typename std::decay<Reducible>::type>::value>
+	struct indexed_map
+	{
+		static const bool value = false;
+	};
+
+	template<typename MapFunction, typename Reducible>
+	struct indexed_map<MapFunction, Reducible, true>
+	{
+		typedef indexed_reducible<typename std::decay<Reducible>::type> source_t;
+		typedef typename std::result_of<MapFunction const&(typename source_t::element_t)>::type element_t;
+
+		static const bool value = true;
+
+		static std::size_t size(map_reducible<MapFunction, Reducible> const& reducible)
+		{
+			return source_t::size(reducible.reducible);
+		}
+
+		static element_t at(map_reducible<MapFunction, Reducible> const& reducible, std::size_t index)
+		{
+			return reducible.mapFunction(source_t::at(reducible.reducible, index));
+		}
+	};
+
+	template<typename MapFunction, typename Reducible>
+	struct indexed_reducible<map_reducible<MapFunction, Reducible>>
+		: indexed_map<MapFunction, Reducible>
+	{};
+
+	/**
+    * @internal
+    * The elements of a map are the results of the mapping function, if the elements of its source are known.
+	*/
+	template<typename MapFunction, typename Reducible, bool Known = reducible_element<typename std::remove_cv<typename std::remove_reference<Reducible>::type>::type>::value>
+	struct map_element
+	{
+		static const bool value = false;
+	};
+
+	template<typename MapFunction, typename Reducible>
+	struct map_element<MapFunction, Reducible, true>
+	{
+		typedef typename reducible_element<typename std::remove_cv<typename std::remove_reference<Reducible>::type>::type>::type source_t;
+		typedef typename std::decay<typename std::result_of<MapFunction const&(source_t const&)>::type>::type type;
+
+		static const bool value = true;
+	};
+
+	template<typename MapFunction, typename Reducible>
+	struct reducible_element<map_reducible<MapFunction, Reducible>>
+		: map_element<MapFunction, Reducible>
+	{};
+}
+
 /**
 * Overloads the reduce() function to reduce reducibles of type @ref map_reducible.
 * @param reducible The instance of @ref map_reducible to be reduced.
@@ -121,6 +272,36 @@ fold(map_reducible<MapFunction, Foldable>&& foldable, Reduce&& reduce, Combine&&
 		std::forward<Combine>(combine));
 }
 
+/**
+* Overloads the fold() function to fold values of type @ref map_reducible on the given executor.
+*/
+template<typename Foldable, typename MapFunction, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<Foldable, Reduce, Combine>::type 
+fold(map_reducible<MapFunction, Foldable> const& foldable, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	typedef detail::map_reducing_function<MapFunction, typename std::decay<Reduce>::type> map_function_t;
+	return fold(
+		foldable.reducible,
+		map_function_t(foldable.mapFunction, std::forward<Reduce>(reduce)),
+		std::forward<Combine>(combine),
+		executor);
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref map_reducible on the given executor.
+*/
+template<typename Foldable, typename MapFunction, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<Foldable, Reduce, Combine>::type 
+fold(map_reducible<MapFunction, Foldable>&& foldable, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	typedef detail::map_reducing_function<MapFunction, typename std::decay<Reduce>::type> map_function_t;
+	return fold(
+		std::move(foldable.reducible),
+		map_function_t(std::move(foldable.mapFunction), std::forward<Reduce>(reduce)),
+		std::forward<Combine>(combine),
+		executor);
+}
+
 namespace detail
 {
 	/**
@@ -149,10 +330,10 @@ namespace detail
     * Operator overload to enable the use of \ref map_reducible_expression in pipe expressions.
 	*/
 	template<typename Reducible, typename MapFunction>
-	map_reducible<typename std::decay<MapFunction>::type, typename std::decay<Reducible>::type>
+	map_reducible<typename std::decay<MapFunction>::type, typename detail::stored_reducible<Reducible>::type>
 	operator|(Reducible&& reducible, map_reducible_expression<MapFunction>&& mapExpression)
 	{
-		typedef map_reducible<typename std::decay<MapFunction>::type, typename std::decay<Reducible>::type> return_t;
+		typedef map_reducible<typename std::decay<MapFunction>::type, typename detail::stored_reducible<Reducible>::type> return_t;
 		return return_t(std::move(mapExpression.mapFunction), std::forward<Reducible>(reducible));
 	}
 
@@ -161,10 +342,10 @@ namespace detail
     * Operator overload to enable the use of r-value references to \ref map_reducible_expression in pipe expressions.
 	*/
     template<typename Reducible, typename MapFunction>
-    map_reducible<typename std::decay<MapFunction>::type, typename std::decay<Reducible>::type>
+    map_reducible<typename std::decay<MapFunction>::type, typename detail::stored_reducible<Reducible>::type>
 	operator|(Reducible&& reducible, map_reducible_expression<MapFunction> const& mapExpression)
 	{
-		typedef map_reducible<typename std::decay<MapFunction>::type, typename std::decay<Reducible>::type> return_t;
+		typedef map_reducible<typename std::decay<MapFunction>::type, typename detail::stored_reducible<Reducible>::type> return_t;
 		return return_t(mapExpression.mapFunction, std::forward<Reducible>(reducible));
 	}
 }
@@ -182,10 +363,10 @@ namespace detail
 * @sa map()
 */
 template<typename MapFunction, typename Reducible>
-map_reducible<typename std::decay<MapFunction>::type, typename std::decay<Reducible>::type>
+map_reducible<typename std::decay<MapFunction>::type, typename detail::stored_reducible<Reducible>::type>
 map(Reducible&& reducible, MapFunction&& mapFunction)
 {
-	typedef map_reducible<typename std::decay<MapFunction>::type, typename std::decay<Reducible>::type> return_type;
+	typedef map_reducible<typename std::decay<MapFunction>::type, typename detail::stored_reducible<Reducible>::type> return_type;
 	return return_type(std::forward<MapFunction>(mapFunction), std::forward<Reducible>(reducible));
 }
 
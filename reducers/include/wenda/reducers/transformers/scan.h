@@ -0,0 +1,505 @@
+#ifndef WENDA_REDUCERS_TRANSFORMERS_SCAN_H_INCLUDED
+#define WENDA_REDUCERS_TRANSFORMERS_SCAN_H_INCLUDED
+
+/**
+* @file scan.h
+* This file implements the scan() reducible transformer, which reduces the running aggregates of the original reducible,
+* that is, its prefix sums for an additive operation.
+* @code
+* auto offsets = sizes | scan(std::plus<std::size_t>(), std::size_t(0)) | into_container<std::vector<std::size_t>>();
+* @endcode
+* Reducing a scan is sequential. Folding it runs a two-pass parallel scan: the totals of blocks of elements
+* are reduced in parallel, scanned in order, and each block is then scanned again from the total that precedes it.
+* Reducibles whose elements are accessible by index are scanned in place, and other foldables are first folded into buffers.
+*/
+
+#include "../reducers_common.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <type_traits>
+#include <vector>
+
+#include "../reduce.h"
+#include "../fold.h"
+#include "../fold_into.h"
+#include "../size_hint.h"
+#include "../reduced.h"
+#include "../monoid/monoid.h"
+#include "../detail/stored_reducible.h"
+#include "../detail/accumulate.h"
+#include "../detail/indexed_reducible.h"
+#include "../detail/parallel_reduce.h"
+#include "../detail/reducible_element.h"
+#include "../detail/stateful_seed.h"
+#include "../executors/thread_pool.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	/**
+    * @internal
+    * This struct implements the functor type used when reducing a reducible as transformed by a scan() transformer.
+    * The running aggregate is carried along with the seed, and is reduced after each element.
+	*/
+	template<typename Operation, typename Reducer>
+	struct scan_reducing_function
+	{
+		Operation operation;
+		Reducer reducer;
+
+		scan_reducing_function(Operation operation, Reducer reducer)
+			: operation(std::move(operation)), reducer(std::move(reducer))
+		{
+		}
+
+		template<typename Seed, typename T, typename Value>
+		reduced<stateful_seed<Seed, T>>
+		operator()(reduced<stateful_seed<Seed, T>>&& seed, Value&& value) const
+		{
+			stateful_seed<Seed, T>& current = seed.get();
+			current.state = operation(std::move(current.state), std::forward<Value>(value));
+			accumulate_into(reducer, current.seed, static_cast<T const&>(current.state));
+			return continue_stateful_seed(std::move(current), false);
+		}
+
+		template<typename Seed, typename T, typename Value>
+		typename std::enable_if<is_in_place_reducer<Reducer const, Seed, T const&>::value>::type
+		operator()(reduced<stateful_seed<Seed, T>>& seed, Value&& value) const
+		{
+			stateful_seed<Seed, T>& current = seed.get();
+			current.state = operation(std::move(current.state), std::forward<Value>(value));
+			reducer(current.seed, static_cast<T const&>(current.state));
+			continue_stateful_seed(seed, false);
+		}
+	};
+}
+
+/**
+* This class implements a reducible that, when reduced, reduces the running aggregates
+* of the elements of the original reducible under an operation, starting from an initial value.
+*/
+template<typename Reducible, typename Operation, typename T>
+struct scan_reducible
+{
+	Reducible reducible;
+	Operation operation;
+	T init;
+
+	scan_reducible(Reducible reducible, Operation operation, T init)
+		: reducible(std::move(reducible)), operation(std::move(operation)), init(std::move(init))
+	{
+	}
+};
+
+/**
+* Overloads the get_size_hint() function for reducibles of type @ref scan_reducible, which have one running aggregate per element.
+*/
+template<typename Reducible, typename Operation, typename T>
+size_hint get_size_hint(scan_reducible<Reducible, Operation, T> const& reducible)
+{
+	return get_size_hint(reducible.reducible);
+}
+
+namespace detail
+{
+	template<typename Reducible, typename Operation, typename T, typename ReduceFunction, typename CombineFunction, typename Executor>
+	struct is_executor_foldable<scan_reducible<Reducible, Operation, T>, ReduceFunction, CombineFunction, Executor>
+		: is_executor_foldable<Reducible, ReduceFunction, CombineFunction, Executor>
+	{};
+
+	template<typename Reducible, typename Operation, typename T>
+	struct reducible_element<scan_reducible<Reducible, Operation, T>>
+	{
+		typedef T type;
+
+		static const bool value = true;
+	};
+
+	/**
+    * @internal
+    * The minimum number of elements in a block of a parallel scan, below which scanning twice costs more than it saves.
+	*/
+	const std::size_t scan_min_block_size = 1024;
+
+	/**
+    * @internal
+    * Returns the number of blocks of a parallel scan of the given number of elements: a few per thread so that they balance,
+    * or a single one, which is scanned once, if the executor does not run in parallel.
+	*/
+	template<typename Partitioner>
+	std::size_t scan_block_count(std::size_t size, std::size_t concurrency, Partitioner const&)
+	{
+		if (concurrency <= 1)
+		{
+			return 1;
+		}
+
+		return (std::min)((std::max)(size / scan_min_block_size, std::size_t(1)), 4 * concurrency);
+	}
+
+	/**
+    * @internal
+    * Returns the number of blocks of a deterministic parallel scan, which only depends on the grain of the partitioner,
+    * as the running aggregates of operations that are not exactly associative depend on where the blocks start.
+	*/
+	inline std::size_t scan_block_count(std::size_t size, std::size_t concurrency, deterministic_partitioner const& partitioner)
+	{
+		std::size_t grain = partitioner.grain_size(size, concurrency);
+		return (std::max)((size + grain - 1) / grain, std::size_t(1));
+	}
+
+	/**
+    * @internal
+    * The blocks of a parallel scan of a reducible whose elements are accessible by index, which are consecutive ranges of indices.
+	*/
+	template<typename Reducible>
+	struct indexed_scan_blocks
+	{
+		typedef indexed_reducible<Reducible> indexed_t;
+
+		Reducible const& reducible;
+		std::size_t total;
+		std::size_t length;
+
+		template<typename Partitioner>
+		indexed_scan_blocks(Reducible const& reducible, std::size_t concurrency, Partitioner const& partitioner)
+			: reducible(reducible), total(indexed_t::size(reducible))
+		{
+			std::size_t blocks = scan_block_count(total, concurrency, partitioner);
+			length = (std::max)((total + blocks - 1) / blocks, std::size_t(1));
+		}
+
+		std::size_t count() const
+		{
+			return (total + length - 1) / length;
+		}
+
+		std::size_t size(std::size_t block) const
+		{
+			return (std::min)(length, total - block * length);
+		}
+
+		typename indexed_t::element_t at(std::size_t block, std::size_t index) const
+		{
+			return indexed_t::at(reducible, block * length + index);
+		}
+	};
+
+	/**
+    * @internal
+    * The blocks of a parallel scan of a foldable that was folded into buffers, which are the buffers themselves.
+	*/
+	template<typename T>
+	struct buffered_scan_blocks
+	{
+		std::vector<std::vector<T>> const& chunks;
+
+		buffered_scan_blocks(std::vector<std::vector<T>> const& chunks)
+			: chunks(chunks)
+		{
+		}
+
+		std::size_t count() const
+		{
+			return chunks.size();
+		}
+
+		std::size_t size(std::size_t block) const
+		{
+			return chunks[block].size();
+		}
+
+		T const& at(std::size_t block, std::size_t index) const
+		{
+			return chunks[block][index];
+		}
+	};
+
+	/**
+    * @internal
+    * Folds the running aggregates of the given non-empty blocks of elements in two passes on the executor.
+    * The totals of all blocks but the last are reduced in parallel, and scanned into the running value that precedes each block.
+    * The blocks are then scanned again from these values in parallel, and the running aggregates are reduced and combined in order.
+    * This requires the operation to be associative, and the elements to be convertible to its type.
+	*/
+	template<typename Blocks, typename Operation, typename T, typename Reduce, typename Combine, typename Executor>
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+	scan_blocks(Blocks const& blocks, Operation const& operation, T const& init, Reduce& reduce, Combine& combine, Executor& executor)
+	{
+		typedef typename std::decay<typename std::result_of<Combine()>::type>::type seed_t;
+
+		std::size_t count = blocks.count();
+		std::vector<T> prefixes((std::max)(count, std::size_t(1)), init);
+
+		auto total_leaf = [&](std::size_t first, std::size_t last, std::size_t totalled) -> std::size_t
+		{
+			for (std::size_t block = first; block < last; ++block)
+			{
+				std::size_t size = blocks.size(block);
+				T total(blocks.at(block, 0));
+
+				for (std::size_t i = 1; i < size; ++i)
+				{
+					total = operation(std::move(total), blocks.at(block, i));
+				}
+
+				prefixes[block + 1] = std::move(total);
+			}
+
+			return totalled + (last - first);
+		};
+
+		// no block starts after the last one, so its total is not needed.
+		if (count > 1)
+		{
+			parallel_reduce_index(0, count - 1, std::size_t(0), total_leaf, std::plus<std::size_t>(), executor);
+		}
+
+		for (std::size_t block = 1; block < count; ++block)
+		{
+			prefixes[block] = operation(prefixes[block - 1], std::move(prefixes[block]));
+		}
+
+		auto scan_leaf = [&](std::size_t first, std::size_t last, seed_t seed) -> seed_t
+		{
+			for (std::size_t block = first; block < last; ++block)
+			{
+				std::size_t size = blocks.size(block);
+				T running = prefixes[block];
+
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					running = operation(std::move(running), blocks.at(block, i));
+					accumulate_into(reduce, seed, static_cast<T const&>(running));
+
+					if (is_reduced(seed))
+					{
+						return seed;
+					}
+				}
+			}
+
+			return seed;
+		};
+
+		return parallel_reduce_index(0, count, combine(), scan_leaf, combine, executor);
+	}
+
+	/**
+    * @internal
+    * Folds the scan of a reducible whose elements are accessible by index, by scanning blocks of indices in place.
+	*/
+	template<typename Reducible, typename Operation, typename T, typename Reduce, typename Combine, typename Executor>
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+	fold_scan(Reducible const& reducible, Operation const& operation, T const& init, Reduce& reduce, Combine& combine, Executor& executor, std::true_type)
+	{
+		indexed_scan_blocks<Reducible> blocks(reducible, executor.concurrency(), partitioner_of(executor));
+		return scan_blocks(blocks, operation, init, reduce, combine, executor);
+	}
+
+	/**
+    * @internal
+    * Folds the scan of any other foldable, by first folding it into buffers per chunk, which are then scanned as blocks.
+	*/
+	template<typename Foldable, typename Operation, typename T, typename Reduce, typename Combine, typename Executor>
+	typename std::decay<typename std::result_of<Combine()>::type>::type
+	fold_scan(Foldable&& foldable, Operation const& operation, T const& init, Reduce& reduce, Combine& combine, Executor& executor, std::false_type)
+	{
+		into_chunks<T> buffered = fold(std::forward<Foldable>(foldable), into_chunks_reducer<T>(), into_chunks_combine<T>(), executor);
+
+		if (!buffered.last.empty())
+		{
+			buffered.complete.push_back(std::move(buffered.last));
+		}
+
+		return scan_blocks(buffered_scan_blocks<T>(buffered.complete), operation, init, reduce, combine, executor);
+	}
+}
+
+/**
+* Overloads the reduce() function to reduce reducibles of type @ref scan_reducible.
+* The running aggregate is updated with each element of the original reducible, and then reduced.
+*/
+template<typename Reducible, typename Operation, typename T, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(scan_reducible<Reducible, Operation, T> const& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef detail::scan_reducing_function<Operation, typename std::decay<Reducer>::type> scan_reducer_t;
+
+	auto result = reduce(
+		reducible.reducible,
+		scan_reducer_t(reducible.operation, std::forward<Reducer>(reducer)),
+		detail::make_stateful_seed(std::forward<Seed>(seed), reducible.init));
+	return std::move(result.get().seed);
+}
+
+/**
+* Overloads the reduce() function to reduce r-value references to reducibles of type @ref scan_reducible.
+*/
+template<typename Reducible, typename Operation, typename T, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(scan_reducible<Reducible, Operation, T>&& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef detail::scan_reducing_function<Operation, typename std::decay<Reducer>::type> scan_reducer_t;
+
+	auto result = reduce(
+		std::move(reducible.reducible),
+		scan_reducer_t(std::move(reducible.operation), std::forward<Reducer>(reducer)),
+		detail::make_stateful_seed(std::forward<Seed>(seed), std::move(reducible.init)));
+	return std::move(result.get().seed);
+}
+
+/**
+* Overloads the fold() function to fold @ref scan_reducible on the given executor, by a two-pass parallel scan.
+* The operation must be associative, and the elements of the original reducible convertible to its type.
+*/
+template<typename Reducible, typename Operation, typename T, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<scan_reducible<Reducible, Operation, T>, Reduce, Combine>::type
+fold(scan_reducible<Reducible, Operation, T> const& foldable, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	typedef detail::indexed_reducible<typename std::decay<Reducible>::type> indexed_t;
+
+	return detail::fold_scan(
+		foldable.reducible, foldable.operation, foldable.init,
+		reduce, combine, executor, std::integral_constant<bool, indexed_t::value>());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref scan_reducible on the given executor.
+*/
+template<typename Reducible, typename Operation, typename T, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<scan_reducible<Reducible, Operation, T>, Reduce, Combine>::type
+fold(scan_reducible<Reducible, Operation, T>&& foldable, Reduce&& reduce, Combine&& combine, Executor&& executor)
+{
+	typedef detail::indexed_reducible<typename std::decay<Reducible>::type> indexed_t;
+
+	return detail::fold_scan(
+		std::move(foldable.reducible), foldable.operation, foldable.init,
+		reduce, combine, executor, std::integral_constant<bool, indexed_t::value>());
+}
+
+/**
+* Overloads the fold() function to fold @ref scan_reducible on the @ref default_thread_pool().
+*/
+template<typename Reducible, typename Operation, typename T, typename Reduce, typename Combine>
+typename detail::fold_return_type<scan_reducible<Reducible, Operation, T>, Reduce, Combine>::type
+fold(scan_reducible<Reducible, Operation, T> const& foldable, Reduce&& reduce, Combine&& combine)
+{
+	return fold(foldable, std::forward<Reduce>(reduce), std::forward<Combine>(combine), default_thread_pool());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref scan_reducible on the @ref default_thread_pool().
+*/
+template<typename Reducible, typename Operation, typename T, typename Reduce, typename Combine>
+typename detail::fold_return_type<scan_reducible<Reducible, Operation, T>, Reduce, Combine>::type
+fold(scan_reducible<Reducible, Operation, T>&& foldable, Reduce&& reduce, Combine&& combine)
+{
+	return fold(std::move(foldable), std::forward<Reduce>(reduce), std::forward<Combine>(combine), default_thread_pool());
+}
+
+namespace detail
+{
+	template<typename Operation, typename T>
+	struct scan_reducible_expression
+	{
+		Operation operation;
+		T init;
+
+		scan_reducible_expression(Operation operation, T init)
+			: operation(std::move(operation)), init(std::move(init))
+		{
+		}
+	};
+}
+
+/**
+* Creates a new reducible that when reduced, reduces the running aggregates of the original reducible.
+* The first reduced value is operation(init, x0), the second operation(operation(init, x0), x1), and so on.
+* @param reducible The original reducible.
+* @param operation The operation, of signature (T, Value) -> T. To fold the scan, it must be associative.
+* @param init The initial value of the running aggregate.
+* @returns A new reducible that implements the scanning reduce behaviour.
+*/
+template<typename Reducible, typename Operation, typename T>
+scan_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<Operation>::type, typename std::decay<T>::type>
+scan(Reducible&& reducible, Operation&& operation, T&& init)
+{
+	typedef scan_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<Operation>::type, typename std::decay<T>::type> return_t;
+	return return_t(std::forward<Reducible>(reducible), std::forward<Operation>(operation), std::forward<T>(init));
+}
+
+/**
+* Scans the given reducible with an operation and initial value.
+* This function is similar to the three-argument version, but should have
+* the reducible passed in by pipeing.
+* @code
+* std::vector<int> running;
+* data | scan(std::plus<int>(), 0) | into(std::back_inserter(running));
+* @endcode
+* @param operation The operation, of signature (T, Value) -> T.
+* @param init The initial value of the running aggregate.
+* @returns A implementation helper object that enables pipeing.
+*/
+template<typename Operation, typename T>
+detail::scan_reducible_expression<typename std::decay<Operation>::type, typename std::decay<T>::type>
+scan(Operation&& operation, T&& init)
+{
+	typedef detail::scan_reducible_expression<typename std::decay<Operation>::type, typename std::decay<T>::type> return_t;
+	return return_t(std::forward<Operation>(operation), std::forward<T>(init));
+}
+
+/**
+* Creates a new reducible that when reduced, reduces the running aggregates of the original reducible under the given monoid,
+* starting from its unit.
+* @tparam Monoid The monoid, as described by @ref monoid_traits.
+* @param reducible The original reducible.
+*/
+template<typename Monoid, typename Reducible>
+scan_reducible<typename detail::stored_reducible<Reducible>::type, typename monoid_traits<Monoid>::operation_t, typename monoid_traits<Monoid>::element_t>
+scan(Reducible&& reducible)
+{
+	typedef monoid_traits<Monoid> monoid_t;
+	typedef scan_reducible<typename detail::stored_reducible<Reducible>::type, typename monoid_t::operation_t, typename monoid_t::element_t> return_t;
+	return return_t(std::forward<Reducible>(reducible), typename monoid_t::operation_t(), monoid_t::unit());
+}
+
+/**
+* Scans the given reducible under the given monoid, in pipe expressions.
+* @code
+* auto prefixSums = data | scan<additive_monoid<long long>>() | into_container<std::vector<long long>>();
+* @endcode
+*/
+template<typename Monoid>
+detail::scan_reducible_expression<typename monoid_traits<Monoid>::operation_t, typename monoid_traits<Monoid>::element_t>
+scan()
+{
+	typedef monoid_traits<Monoid> monoid_t;
+	typedef detail::scan_reducible_expression<typename monoid_t::operation_t, typename monoid_t::element_t> return_t;
+	return return_t(typename monoid_t::operation_t(), monoid_t::unit());
+}
+
+namespace detail
+{
+	template<typename Reducible, typename Operation, typename T>
+	scan_reducible<typename detail::stored_reducible<Reducible>::type, Operation, T>
+	operator|(Reducible&& reducible, scan_reducible_expression<Operation, T>&& expr)
+	{
+		typedef scan_reducible<typename detail::stored_reducible<Reducible>::type, Operation, T> return_t;
+		return return_t(std::forward<Reducible>(reducible), std::move(expr.operation), std::move(expr.init));
+	}
+
+	template<typename Reducible, typename Operation, typename T>
+	scan_reducible<typename detail::stored_reducible<Reducible>::type, Operation, T>
+	operator|(Reducible&& reducible, scan_reducible_expression<Operation, T> const& expr)
+	{
+		typedef scan_reducible<typename detail::stored_reducible<Reducible>::type, Operation, T> return_t;
+		return return_t(std::forward<Reducible>(reducible), expr.operation, expr.init);
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_TRANSFORMERS_SCAN_H_INCLUDED
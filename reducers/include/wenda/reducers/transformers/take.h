@@ -0,0 +1,448 @@
+#ifndef WENDA_REDUCERS_TRANSFORMERS_TAKE_H_INCLUDED
+#define WENDA_REDUCERS_TRANSFORMERS_TAKE_H_INCLUDED
+
+/**
+* @file take.h
+* This file implements the take() and drop() reducible transformers.
+* take() stops the reduction of the original reducible as soon as enough elements were taken,
+* hence it can be used to sample the first elements of very large reducibles.
+*/
+
+#include "../reducers_common.h"
+
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "../reduce.h"
+#include "../fold.h"
+#include "../size_hint.h"
+#include "../reduced.h"
+#include "../detail/stored_reducible.h"
+#include "../detail/accumulate.h"
+#include "../detail/reducible_element.h"
+#include "../detail/stateful_seed.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	template<typename Reducer>
+	struct take_reducing_function
+	{
+		Reducer reducer;
+
+		take_reducing_function(Reducer reducer)
+			: reducer(std::move(reducer))
+		{
+		}
+
+		template<typename Seed, typename Value>
+		reduced<stateful_seed<Seed, std::size_t>>
+		operator()(reduced<stateful_seed<Seed, std::size_t>>&& seed, Value&& value) const
+		{
+			stateful_seed<Seed, std::size_t>& current = seed.get();
+
+			if (seed.is_reduced() || current.state == 0)
+			{
+				return std::move(seed);
+			}
+
+			accumulate_into(reducer, current.seed, std::forward<Value>(value));
+			--current.state;
+			return continue_stateful_seed(std::move(current), current.state == 0);
+		}
+
+		template<typename Seed, typename Value>
+		typename std::enable_if<is_in_place_reducer<Reducer const, Seed, Value>::value>::type
+		operator()(reduced<stateful_seed<Seed, std::size_t>>& seed, Value&& value) const
+		{
+			stateful_seed<Seed, std::size_t>& current = seed.get();
+
+			if (seed.is_reduced() || current.state == 0)
+			{
+				return;
+			}
+
+			reducer(current.seed, std::forward<Value>(value));
+			--current.state;
+			continue_stateful_seed(seed, current.state == 0);
+		}
+	};
+
+	template<typename Reducer>
+	struct drop_reducing_function
+	{
+		Reducer reducer;
+
+		drop_reducing_function(Reducer reducer)
+			: reducer(std::move(reducer))
+		{
+		}
+
+		template<typename Seed, typename Value>
+		reduced<stateful_seed<Seed, std::size_t>>
+		operator()(reduced<stateful_seed<Seed, std::size_t>>&& seed, Value&& value) const
+		{
+			stateful_seed<Seed, std::size_t>& current = seed.get();
+
+			if (seed.is_reduced())
+			{
+				return std::move(seed);
+			}
+
+			if (current.state > 0)
+			{
+				--current.state;
+				return std::move(seed);
+			}
+
+			accumulate_into(reducer, current.seed, std::forward<Value>(value));
+			return continue_stateful_seed(std::move(current), false);
+		}
+
+		template<typename Seed, typename Value>
+		typename std::enable_if<is_in_place_reducer<Reducer const, Seed, Value>::value>::type
+		operator()(reduced<stateful_seed<Seed, std::size_t>>& seed, Value&& value) const
+		{
+			stateful_seed<Seed, std::size_t>& current = seed.get();
+
+			if (seed.is_reduced())
+			{
+				return;
+			}
+
+			if (current.state > 0)
+			{
+				--current.state;
+				return;
+			}
+
+			reducer(current.seed, std::forward<Value>(value));
+			continue_stateful_seed(seed, false);
+		}
+	};
+}
+
+/**
+* This class implements a reducible that, when reduced,
+* reduces the first elements of the original reducible, up to a given count.
+*/
+template<typename Reducible>
+struct take_reducible
+{
+	Reducible reducible;
+	std::size_t count;
+
+	take_reducible(Reducible reducible, std::size_t count)
+		: reducible(std::move(reducible)), count(count)
+	{
+	}
+};
+
+/**
+* This class implements a reducible that, when reduced,
+* reduces the elements of the original reducible except a given count of its first elements.
+*/
+template<typename Reducible>
+struct drop_reducible
+{
+	Reducible reducible;
+	std::size_t count;
+
+	drop_reducible(Reducible reducible, std::size_t count)
+		: reducible(std::move(reducible)), count(count)
+	{
+	}
+};
+
+/**
+* Overloads the get_size_hint() function for reducibles of type @ref take_reducible, which have at most their count of elements.
+*/
+template<typename Reducible>
+size_hint get_size_hint(take_reducible<Reducible> const& reducible)
+{
+	return get_size_hint(reducible.reducible).limit(reducible.count);
+}
+
+/**
+* Overloads the get_size_hint() function for reducibles of type @ref drop_reducible.
+*/
+template<typename Reducible>
+size_hint get_size_hint(drop_reducible<Reducible> const& reducible)
+{
+	return get_size_hint(reducible.reducible).skip(reducible.count);
+}
+
+namespace detail
+{
+	template<typename Reducible>
+	struct reducible_element<take_reducible<Reducible>>
+		: reducible_element<typename std::remove_cv<typename std::remove_reference<Reducible>::type>::type>
+	{};
+
+	template<typename Reducible>
+	struct reducible_element<drop_reducible<Reducible>>
+		: reducible_element<typename std::remove_cv<typename std::remove_reference<Reducible>::type>::type>
+	{};
+}
+
+/**
+* Overloads the reduce() function to reduce reducibles of type @ref take_reducible.
+* The reduction of the original reducible is terminated once the count of elements has been reduced.
+*/
+template<typename Reducible, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(take_reducible<Reducible> const& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef detail::take_reducing_function<typename std::decay<Reducer>::type> take_reducer_t;
+
+	if (reducible.count == 0)
+	{
+		return std::forward<Seed>(seed);
+	}
+
+	auto result = reduce(
+		reducible.reducible,
+		take_reducer_t(std::forward<Reducer>(reducer)),
+		detail::make_stateful_seed(std::forward<Seed>(seed), reducible.count));
+	return std::move(result.get().seed);
+}
+
+/**
+* Overloads the reduce() function to reduce r-value references to reducibles of type @ref take_reducible.
+*/
+template<typename Reducible, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(take_reducible<Reducible>&& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef detail::take_reducing_function<typename std::decay<Reducer>::type> take_reducer_t;
+
+	if (reducible.count == 0)
+	{
+		return std::forward<Seed>(seed);
+	}
+
+	auto result = reduce(
+		std::move(reducible.reducible),
+		take_reducer_t(std::forward<Reducer>(reducer)),
+		detail::make_stateful_seed(std::forward<Seed>(seed), reducible.count));
+	return std::move(result.get().seed);
+}
+
+/**
+* Overloads the reduce() function to reduce reducibles of type @ref drop_reducible.
+*/
+template<typename Reducible, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(drop_reducible<Reducible> const& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef detail::drop_reducing_function<typename std::decay<Reducer>::type> drop_reducer_t;
+
+	auto result = reduce(
+		reducible.reducible,
+		drop_reducer_t(std::forward<Reducer>(reducer)),
+		detail::make_stateful_seed(std::forward<Seed>(seed), reducible.count));
+	return std::move(result.get().seed);
+}
+
+/**
+* Overloads the reduce() function to reduce r-value references to reducibles of type @ref drop_reducible.
+*/
+template<typename Reducible, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(drop_reducible<Reducible>&& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef detail::drop_reducing_function<typename std::decay<Reducer>::type> drop_reducer_t;
+
+	auto result = reduce(
+		std::move(reducible.reducible),
+		drop_reducer_t(std::forward<Reducer>(reducer)),
+		detail::make_stateful_seed(std::forward<Seed>(seed), reducible.count));
+	return std::move(result.get().seed);
+}
+
+/**
+* Overloads the fold() function to fold @ref take_reducible.
+* Which elements are taken depends on their position, hence the reducible is reduced sequentially,
+* which still stops the original reducible early.
+*/
+template<typename Reducible, typename Reduce, typename Combine>
+typename detail::fold_return_type<take_reducible<Reducible>, Reduce, Combine>::type
+fold(take_reducible<Reducible> const& foldable, Reduce&& reducer, Combine&& combine)
+{
+	return reduce(foldable, std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref take_reducible.
+*/
+template<typename Reducible, typename Reduce, typename Combine>
+typename detail::fold_return_type<take_reducible<Reducible>, Reduce, Combine>::type
+fold(take_reducible<Reducible>&& foldable, Reduce&& reducer, Combine&& combine)
+{
+	return reduce(std::move(foldable), std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold @ref take_reducible on the given executor.
+* The reducible is reduced sequentially on the calling thread, as for the three argument version.
+*/
+template<typename Reducible, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<take_reducible<Reducible>, Reduce, Combine>::type
+fold(take_reducible<Reducible> const& foldable, Reduce&& reducer, Combine&& combine, Executor&&)
+{
+	return reduce(foldable, std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref take_reducible on the given executor.
+*/
+template<typename Reducible, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<take_reducible<Reducible>, Reduce, Combine>::type
+fold(take_reducible<Reducible>&& foldable, Reduce&& reducer, Combine&& combine, Executor&&)
+{
+	return reduce(std::move(foldable), std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold @ref drop_reducible.
+* Which elements are dropped depends on their position, hence the reducible is reduced sequentially.
+*/
+template<typename Reducible, typename Reduce, typename Combine>
+typename detail::fold_return_type<drop_reducible<Reducible>, Reduce, Combine>::type
+fold(drop_reducible<Reducible> const& foldable, Reduce&& reducer, Combine&& combine)
+{
+	return reduce(foldable, std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref drop_reducible.
+*/
+template<typename Reducible, typename Reduce, typename Combine>
+typename detail::fold_return_type<drop_reducible<Reducible>, Reduce, Combine>::type
+fold(drop_reducible<Reducible>&& foldable, Reduce&& reducer, Combine&& combine)
+{
+	return reduce(std::move(foldable), std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold @ref drop_reducible on the given executor.
+* The reducible is reduced sequentially on the calling thread, as for the three argument version.
+*/
+template<typename Reducible, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<drop_reducible<Reducible>, Reduce, Combine>::type
+fold(drop_reducible<Reducible> const& foldable, Reduce&& reducer, Combine&& combine, Executor&&)
+{
+	return reduce(foldable, std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref drop_reducible on the given executor.
+*/
+template<typename Reducible, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<drop_reducible<Reducible>, Reduce, Combine>::type
+fold(drop_reducible<Reducible>&& foldable, Reduce&& reducer, Combine&& combine, Executor&&)
+{
+	return reduce(std::move(foldable), std::forward<Reduce>(reducer), combine());
+}
+
+namespace detail
+{
+	struct take_reducible_expression
+	{
+		std::size_t count;
+
+		take_reducible_expression(std::size_t count)
+			: count(count)
+		{
+		}
+	};
+
+	struct drop_reducible_expression
+	{
+		std::size_t count;
+
+		drop_reducible_expression(std::size_t count)
+			: count(count)
+		{
+		}
+	};
+}
+
+/**
+* Creates a new reducible that when reduced, reduces at most the first @p count elements of the original reducible,
+* and then terminates the reduction of the original reducible.
+* @param reducible The original reducible.
+* @param count The number of elements to take.
+* @returns A new reducible that implements the taking reduce behaviour.
+*/
+template<typename Reducible>
+take_reducible<typename detail::stored_reducible<Reducible>::type>
+take(Reducible&& reducible, std::size_t count)
+{
+	typedef take_reducible<typename detail::stored_reducible<Reducible>::type> return_t;
+	return return_t(std::forward<Reducible>(reducible), count);
+}
+
+/**
+* Takes the first elements of the given reducible.
+* This function is similar to the two-argument version, but should have
+* the reducible passed in by pipeing.
+* @code
+* std::vector<int> firstTen;
+* data | filter(matches) | take(10) | into(std::back_inserter(firstTen));
+* @endcode
+* @param count The number of elements to take.
+* @returns A implementation helper object that enables pipeing.
+*/
+inline detail::take_reducible_expression take(std::size_t count)
+{
+	return detail::take_reducible_expression(count);
+}
+
+/**
+* Creates a new reducible that when reduced, reduces the elements of the original reducible
+* except its first @p count elements.
+* @param reducible The original reducible.
+* @param count The number of elements to drop.
+* @returns A new reducible that implements the dropping reduce behaviour.
+*/
+template<typename Reducible>
+drop_reducible<typename detail::stored_reducible<Reducible>::type>
+drop(Reducible&& reducible, std::size_t count)
+{
+	typedef drop_reducible<typename detail::stored_reducible<Reducible>::type> return_t;
+	return return_t(std::forward<Reducible>(reducible), count);
+}
+
+/**
+* Drops the first elements of the given reducible.
+* This function is similar to the two-argument version, but should have
+* the reducible passed in by pipeing.
+* @param count The number of elements to drop.
+* @returns A implementation helper object that enables pipeing.
+*/
+inline detail::drop_reducible_expression drop(std::size_t count)
+{
+	return detail::drop_reducible_expression(count);
+}
+
+namespace detail
+{
+	template<typename Reducible>
+	take_reducible<typename detail::stored_reducible<Reducible>::type>
+	operator|(Reducible&& reducible, take_reducible_expression const& expr)
+	{
+		typedef take_reducible<typename detail::stored_reducible<Reducible>::type> return_t;
+		return return_t(std::forward<Reducible>(reducible), expr.count);
+	}
+
+	template<typename Reducible>
+	drop_reducible<typename detail::stored_reducible<Reducible>::type>
+	operator|(Reducible&& reducible, drop_reducible_expression const& expr)
+	{
+		typedef drop_reducible<typename detail::stored_reducible<Reducible>::type> return_t;
+		return return_t(std::forward<Reducible>(reducible), expr.count);
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_TRANSFORMERS_TAKE_H_INCLUDED
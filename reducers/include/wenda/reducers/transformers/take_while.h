@@ -0,0 +1,458 @@
+#ifndef WENDA_REDUCERS_TRANSFORMERS_TAKE_WHILE_H_INCLUDED
+#define WENDA_REDUCERS_TRANSFORMERS_TAKE_WHILE_H_INCLUDED
+
+/**
+* @file take_while.h
+* This file implements the take_while() and drop_while() reducible transformers.
+* take_while() stops the reduction of the original reducible at the first element that does not satisfy its predicate.
+*/
+
+#include "../reducers_common.h"
+
+#include <utility>
+#include <type_traits>
+
+#include "../reduce.h"
+#include "../fold.h"
+#include "../size_hint.h"
+#include "../reduced.h"
+#include "../detail/stored_reducible.h"
+#include "../detail/accumulate.h"
+#include "../detail/reducible_element.h"
+#include "../detail/stateful_seed.h"
+
+WENDA_REDUCERS_NAMESPACE_BEGIN
+
+namespace detail
+{
+	template<typename Predicate, typename Reducer>
+	struct take_while_reducing_function
+	{
+		Predicate predicate;
+		Reducer reducer;
+
+		take_while_reducing_function(Predicate predicate, Reducer reducer)
+			: predicate(std::move(predicate)), reducer(std::move(reducer))
+		{
+		}
+
+		template<typename Seed, typename Value>
+		reduced<Seed> operator()(reduced<Seed>&& seed, Value&& value) const
+		{
+			if (seed.is_reduced())
+			{
+				return std::move(seed);
+			}
+
+			if (!predicate(value))
+			{
+				return reduced<Seed>(std::move(seed.get()), true);
+			}
+
+			accumulate_into(reducer, seed.get(), std::forward<Value>(value));
+			bool done = is_reduced(seed.get());
+			return reduced<Seed>(std::move(seed.get()), done);
+		}
+
+		template<typename Seed, typename Value>
+		typename std::enable_if<is_in_place_reducer<Reducer const, Seed, Value>::value>::type
+		operator()(reduced<Seed>& seed, Value&& value) const
+		{
+			if (seed.is_reduced())
+			{
+				return;
+			}
+
+			if (predicate(value))
+			{
+				reducer(seed.get(), std::forward<Value>(value));
+
+				if (!is_reduced(seed.get()))
+				{
+					return;
+				}
+			}
+
+			seed = reduced<Seed>(std::move(seed.get()), true);
+		}
+	};
+
+	template<typename Predicate, typename Reducer>
+	struct drop_while_reducing_function
+	{
+		Predicate predicate;
+		Reducer reducer;
+
+		drop_while_reducing_function(Predicate predicate, Reducer reducer)
+			: predicate(std::move(predicate)), reducer(std::move(reducer))
+		{
+		}
+
+		template<typename Seed, typename Value>
+		reduced<stateful_seed<Seed, bool>>
+		operator()(reduced<stateful_seed<Seed, bool>>&& seed, Value&& value) const
+		{
+			stateful_seed<Seed, bool>& current = seed.get();
+
+			if (seed.is_reduced() || (current.state && predicate(value)))
+			{
+				return std::move(seed);
+			}
+
+			current.state = false;
+			accumulate_into(reducer, current.seed, std::forward<Value>(value));
+			return continue_stateful_seed(std::move(current), false);
+		}
+
+		template<typename Seed, typename Value>
+		typename std::enable_if<is_in_place_reducer<Reducer const, Seed, Value>::value>::type
+		operator()(reduced<stateful_seed<Seed, bool>>& seed, Value&& value) const
+		{
+			stateful_seed<Seed, bool>& current = seed.get();
+
+			if (seed.is_reduced() || (current.state && predicate(value)))
+			{
+				return;
+			}
+
+			current.state = false;
+			reducer(current.seed, std::forward<Value>(value));
+			continue_stateful_seed(seed, false);
+		}
+	};
+}
+
+/**
+* This class implements a reducible that, when reduced, reduces the elements of the original reducible
+* up to the first one that does not satisfy a predicate.
+*/
+template<typename Reducible, typename Predicate>
+struct take_while_reducible
+{
+	Reducible reducible;
+	Predicate predicate;
+
+	take_while_reducible(Reducible reducible, Predicate predicate)
+		: reducible(std::move(reducible)), predicate(std::move(predicate))
+	{
+	}
+};
+
+/**
+* This class implements a reducible that, when reduced, reduces the elements of the original reducible
+* from the first one that does not satisfy a predicate.
+*/
+template<typename Reducible, typename Predicate>
+struct drop_while_reducible
+{
+	Reducible reducible;
+	Predicate predicate;
+
+	drop_while_reducible(Reducible reducible, Predicate predicate)
+		: reducible(std::move(reducible)), predicate(std::move(predicate))
+	{
+	}
+};
+
+/**
+* Overloads the get_size_hint() function for reducibles of type @ref take_while_reducible, whose number of elements is bounded by that of their source.
+*/
+template<typename Reducible, typename Predicate>
+size_hint get_size_hint(take_while_reducible<Reducible, Predicate> const& reducible)
+{
+	return get_size_hint(reducible.reducible).as_upper_bound();
+}
+
+/**
+* Overloads the get_size_hint() function for reducibles of type @ref drop_while_reducible, whose number of elements is bounded by that of their source.
+*/
+template<typename Reducible, typename Predicate>
+size_hint get_size_hint(drop_while_reducible<Reducible, Predicate> const& reducible)
+{
+	return get_size_hint(reducible.reducible).as_upper_bound();
+}
+
+namespace detail
+{
+	template<typename Reducible, typename Predicate>
+	struct reducible_element<take_while_reducible<Reducible, Predicate>>
+		: reducible_element<typename std::remove_cv<typename std::remove_reference<Reducible>::type>::type>
+	{};
+
+	template<typename Reducible, typename Predicate>
+	struct reducible_element<drop_while_reducible<Reducible, Predicate>>
+		: reducible_element<typename std::remove_cv<typename std::remove_reference<Reducible>::type>::type>
+	{};
+}
+
+/**
+* Overloads the reduce() function to reduce reducibles of type @ref take_while_reducible.
+* The reduction of the original reducible is terminated at the first element that does not satisfy the predicate.
+*/
+template<typename Reducible, typename Predicate, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(take_while_reducible<Reducible, Predicate> const& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef typename std::decay<Seed>::type seed_t;
+	typedef detail::take_while_reducing_function<Predicate, typename std::decay<Reducer>::type> take_while_reducer_t;
+
+	auto result = reduce(
+		reducible.reducible,
+		take_while_reducer_t(reducible.predicate, std::forward<Reducer>(reducer)),
+		reduced<seed_t>(std::forward<Seed>(seed)));
+	return std::move(result.get());
+}
+
+/**
+* Overloads the reduce() function to reduce r-value references to reducibles of type @ref take_while_reducible.
+*/
+template<typename Reducible, typename Predicate, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(take_while_reducible<Reducible, Predicate>&& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef typename std::decay<Seed>::type seed_t;
+	typedef detail::take_while_reducing_function<Predicate, typename std::decay<Reducer>::type> take_while_reducer_t;
+
+	auto result = reduce(
+		std::move(reducible.reducible),
+		take_while_reducer_t(std::move(reducible.predicate), std::forward<Reducer>(reducer)),
+		reduced<seed_t>(std::forward<Seed>(seed)));
+	return std::move(result.get());
+}
+
+/**
+* Overloads the reduce() function to reduce reducibles of type @ref drop_while_reducible.
+*/
+template<typename Reducible, typename Predicate, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(drop_while_reducible<Reducible, Predicate> const& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef detail::drop_while_reducing_function<Predicate, typename std::decay<Reducer>::type> drop_while_reducer_t;
+
+	auto result = reduce(
+		reducible.reducible,
+		drop_while_reducer_t(reducible.predicate, std::forward<Reducer>(reducer)),
+		detail::make_stateful_seed(std::forward<Seed>(seed), true));
+	return std::move(result.get().seed);
+}
+
+/**
+* Overloads the reduce() function to reduce r-value references to reducibles of type @ref drop_while_reducible.
+*/
+template<typename Reducible, typename Predicate, typename Reducer, typename Seed>
+typename std::decay<Seed>::type reduce(drop_while_reducible<Reducible, Predicate>&& reducible, Reducer&& reducer, Seed&& seed)
+{
+	typedef detail::drop_while_reducing_function<Predicate, typename std::decay<Reducer>::type> drop_while_reducer_t;
+
+	auto result = reduce(
+		std::move(reducible.reducible),
+		drop_while_reducer_t(std::move(reducible.predicate), std::forward<Reducer>(reducer)),
+		detail::make_stateful_seed(std::forward<Seed>(seed), true));
+	return std::move(result.get().seed);
+}
+
+/**
+* Overloads the fold() function to fold @ref take_while_reducible.
+* Which elements are taken depends on the elements before them, hence the reducible is reduced sequentially,
+* which still stops the original reducible early.
+*/
+template<typename Reducible, typename Predicate, typename Reduce, typename Combine>
+typename detail::fold_return_type<take_while_reducible<Reducible, Predicate>, Reduce, Combine>::type
+fold(take_while_reducible<Reducible, Predicate> const& foldable, Reduce&& reducer, Combine&& combine)
+{
+	return reduce(foldable, std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref take_while_reducible.
+*/
+template<typename Reducible, typename Predicate, typename Reduce, typename Combine>
+typename detail::fold_return_type<take_while_reducible<Reducible, Predicate>, Reduce, Combine>::type
+fold(take_while_reducible<Reducible, Predicate>&& foldable, Reduce&& reducer, Combine&& combine)
+{
+	return reduce(std::move(foldable), std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold @ref take_while_reducible on the given executor.
+* The reducible is reduced sequentially on the calling thread, as for the three argument version.
+*/
+template<typename Reducible, typename Predicate, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<take_while_reducible<Reducible, Predicate>, Reduce, Combine>::type
+fold(take_while_reducible<Reducible, Predicate> const& foldable, Reduce&& reducer, Combine&& combine, Executor&&)
+{
+	return reduce(foldable, std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref take_while_reducible on the given executor.
+*/
+template<typename Reducible, typename Predicate, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<take_while_reducible<Reducible, Predicate>, Reduce, Combine>::type
+fold(take_while_reducible<Reducible, Predicate>&& foldable, Reduce&& reducer, Combine&& combine, Executor&&)
+{
+	return reduce(std::move(foldable), std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold @ref drop_while_reducible.
+* Which elements are dropped depends on the elements before them, hence the reducible is reduced sequentially.
+*/
+template<typename Reducible, typename Predicate, typename Reduce, typename Combine>
+typename detail::fold_return_type<drop_while_reducible<Reducible, Predicate>, Reduce, Combine>::type
+fold(drop_while_reducible<Reducible, Predicate> const& foldable, Reduce&& reducer, Combine&& combine)
+{
+	return reduce(foldable, std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref drop_while_reducible.
+*/
+template<typename Reducible, typename Predicate, typename Reduce, typename Combine>
+typename detail::fold_return_type<drop_while_reducible<Reducible, Predicate>, Reduce, Combine>::type
+fold(drop_while_reducible<Reducible, Predicate>&& foldable, Reduce&& reducer, Combine&& combine)
+{
+	return reduce(std::move(foldable), std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold @ref drop_while_reducible on the given executor.
+* The reducible is reduced sequentially on the calling thread, as for the three argument version.
+*/
+template<typename Reducible, typename Predicate, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<drop_while_reducible<Reducible, Predicate>, Reduce, Combine>::type
+fold(drop_while_reducible<Reducible, Predicate> const& foldable, Reduce&& reducer, Combine&& combine, Executor&&)
+{
+	return reduce(foldable, std::forward<Reduce>(reducer), combine());
+}
+
+/**
+* Overloads the fold() function to fold r-value references to @ref drop_while_reducible on the given executor.
+*/
+template<typename Reducible, typename Predicate, typename Reduce, typename Combine, typename Executor>
+typename detail::fold_return_type<drop_while_reducible<Reducible, Predicate>, Reduce, Combine>::type
+fold(drop_while_reducible<Reducible, Predicate>&& foldable, Reduce&& reducer, Combine&& combine, Executor&&)
+{
+	return reduce(std::move(foldable), std::forward<Reduce>(reducer), combine());
+}
+
+namespace detail
+{
+	template<typename Predicate>
+	struct take_while_reducible_expression
+	{
+		Predicate predicate;
+
+		take_while_reducible_expression(Predicate predicate)
+			: predicate(std::move(predicate))
+		{
+		}
+	};
+
+	template<typename Predicate>
+	struct drop_while_reducible_expression
+	{
+		Predicate predicate;
+
+		drop_while_reducible_expression(Predicate predicate)
+			: predicate(std::move(predicate))
+		{
+		}
+	};
+}
+
+/**
+* Creates a new reducible that when reduced, reduces the elements of the original reducible
+* while they satisfy the given predicate, and then terminates the reduction of the original reducible.
+* @param reducible The original reducible.
+* @param predicate The predicate. It must be a function of signature (Value) -> (convertible-to-bool).
+* @returns A new reducible that implements the taking reduce behaviour.
+*/
+template<typename Reducible, typename Predicate>
+take_while_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<Predicate>::type>
+take_while(Reducible&& reducible, Predicate&& predicate)
+{
+	typedef take_while_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<Predicate>::type> return_t;
+	return return_t(std::forward<Reducible>(reducible), std::forward<Predicate>(predicate));
+}
+
+/**
+* Takes the first elements of the given reducible that satisfy the given predicate.
+* This function is similar to the two-argument version, but should have
+* the reducible passed in by pipeing.
+* @param predicate The predicate. It must be a function of signature (Value) -> (convertible-to-bool).
+* @returns A implementation helper object that enables pipeing.
+*/
+template<typename Predicate>
+detail::take_while_reducible_expression<typename std::decay<Predicate>::type>
+take_while(Predicate&& predicate)
+{
+	typedef detail::take_while_reducible_expression<typename std::decay<Predicate>::type> return_t;
+	return return_t(std::forward<Predicate>(predicate));
+}
+
+/**
+* Creates a new reducible that when reduced, skips the first elements of the original reducible
+* that satisfy the given predicate, and reduces all the elements from the first one that does not.
+* @param reducible The original reducible.
+* @param predicate The predicate. It must be a function of signature (Value) -> (convertible-to-bool).
+* @returns A new reducible that implements the dropping reduce behaviour.
+*/
+template<typename Reducible, typename Predicate>
+drop_while_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<Predicate>::type>
+drop_while(Reducible&& reducible, Predicate&& predicate)
+{
+	typedef drop_while_reducible<typename detail::stored_reducible<Reducible>::type, typename std::decay<Predicate>::type> return_t;
+	return return_t(std::forward<Reducible>(reducible), std::forward<Predicate>(predicate));
+}
+
+/**
+* Drops the first elements of the given reducible that satisfy the given predicate.
+* This function is similar to the two-argument version, but should have
+* the reducible passed in by pipeing.
+* @param predicate The predicate. It must be a function of signature (Value) -> (convertible-to-bool).
+* @returns A implementation helper object that enables pipeing.
+*/
+template<typename Predicate>
+detail::drop_while_reducible_expression<typename std::decay<Predicate>::type>
+drop_while(Predicate&& predicate)
+{
+	typedef detail::drop_while_reducible_expression<typename std::decay<Predicate>::type> return_t;
+	return return_t(std::forward<Predicate>(predicate));
+}
+
+namespace detail
+{
+	template<typename Reducible, typename Predicate>
+	take_while_reducible<typename detail::stored_reducible<Reducible>::type, Predicate>
+	operator|(Reducible&& reducible, take_while_reducible_expression<Predicate> const& expr)
+	{
+		typedef take_while_reducible<typename detail::stored_reducible<Reducible>::type, Predicate> return_t;
+		return return_t(std::forward<Reducible>(reducible), expr.predicate);
+	}
+
+	template<typename Reducible, typename Predicate>
+	take_while_reducible<typename detail::stored_reducible<Reducible>::type, Predicate>
+	operator|(Reducible&& reducible, take_while_reducible_expression<Predicate>&& expr)
+	{
+		typedef take_while_reducible<typename detail::stored_reducible<Reducible>::type, Predicate> return_t;
+		return return_t(std::forward<Reducible>(reducible), std::move(expr.predicate));
+	}
+
+	template<typename Reducible, typename Predicate>
+	drop_while_reducible<typename detail::stored_reducible<Reducible>::type, Predicate>
+	operator|(Reducible&& reducible, drop_while_reducible_expression<Predicate> const& expr)
+	{
+		typedef drop_while_reducible<typename detail::stored_reducible<Reducible>::type, Predicate> return_t;
+		return return_t(std::forward<Reducible>(reducible), expr.predicate);
+	}
+
+	template<typename Reducible, typename Predicate>
+	drop_while_reducible<typename detail::stored_reducible<Reducible>::type, Predicate>
+	operator|(Reducible&& reducible, drop_while_reducible_expression<Predicate>&& expr)
+	{
+		typedef drop_while_reducible<typename detail::stored_reducible<Reducible>::type, Predicate> return_t;
+		return return_t(std::forward<Reducible>(reducible), std::move(expr.predicate));
+	}
+}
+
+WENDA_REDUCERS_NAMESPACE_END
+
+#endif // WENDA_REDUCERS_TRANSFORMERS_TAKE_WHILE_H_INCLUDED
@@ -0,0 +1,137 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/collect.h>
+#include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/reducibles/iterator_pair_reducible.h>
+#include <wenda/reducers/reduce.h>
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/monoid/monoid_reduce.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/executors/thread_pool.h>
+
+#include <numeric>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace
+	{
+		/**
+        * A reducing function that sums its elements and counts how many blocks it consumed.
+		*/
+		struct block_counting_sum
+		{
+			int* blocks;
+
+			long long operator()(long long seed, long long value) const
+			{
+				return seed + value;
+			}
+
+			long long reduce_block(long long seed, long long const* first, long long const* last) const
+			{
+				++*blocks;
+				return std::accumulate(first, last, seed);
+			}
+		};
+	}
+
+	TEST_CLASS(BlockReduceTests)
+	{
+		TEST_METHOD(Contiguous_Ranges_Are_Reduced_In_Blocks)
+		{
+			std::vector<long long> data(1000);
+			std::iota(data.begin(), data.end(), 0LL);
+			int blocks = 0;
+
+			auto result = data | reduce(block_counting_sum{ &blocks }, 0LL);
+
+			Assert::AreEqual(999LL * 1000 / 2, result);
+			Assert::AreEqual(1, blocks);
+		}
+
+		TEST_METHOD(Map_And_Filter_Push_Blocks_To_The_Reducer)
+		{
+			std::vector<long long> data(1000);
+			std::iota(data.begin(), data.end(), 0LL);
+			int blocks = 0;
+
+			auto result =
+				make_iterator_pair_reducible(data.data(), data.data() + data.size())
+				| map([](long long n) { return n * 3; })
+				| filter([](long long n) { return n % 2 == 0; })
+				| reduce(block_counting_sum{ &blocks }, 0LL);
+
+			long long expected = 0;
+
+			for (long long n : data)
+			{
+				expected += (n * 3) % 2 == 0 ? n * 3 : 0;
+			}
+
+			Assert::AreEqual(expected, result);
+			// the transformers buffer at most 256 elements at a time.
+			Assert::AreEqual(4, blocks);
+		}
+
+		TEST_METHOD(Functions_Without_Blocks_Receive_Elements)
+		{
+			std::vector<int> data{ 1, 2, 3, 4 };
+			std::vector<int> visited;
+
+			auto result =
+				make_iterator_pair_reducible(data.data(), data.data() + data.size())
+				| map([](int& n) { return n * 2; })
+				| reduce([&](int acc, int n) { visited.push_back(n); return acc + n; }, 0);
+
+			Assert::AreEqual(20, result);
+			Assert::IsTrue(std::vector<int>{ 2, 4, 6, 8 } == visited);
+		}
+
+		TEST_METHOD(Monoid_Reductions_Consume_Blocks)
+		{
+			std::vector<long long> data(100003);
+			std::iota(data.begin(), data.end(), 0LL);
+			long long expected = 0;
+
+			for (long long n : data)
+			{
+				expected += n % 3 == 0 ? n / 2 : 0;
+			}
+
+			auto reduced =
+				data
+				| filter([](long long n) { return n % 3 == 0; })
+				| map([](long long n) { return n / 2; })
+				| reduce<additive_monoid<long long>>();
+
+			thread_pool pool(3);
+			auto folded =
+				data
+				| filter([](long long n) { return n % 3 == 0; })
+				| map([](long long n) { return n / 2; })
+				| fold<additive_monoid<long long>>(pool);
+
+			Assert::AreEqual(expected, reduced);
+			Assert::AreEqual(expected, folded);
+		}
+
+		TEST_METHOD(Blocks_Flow_Through_Collect)
+		{
+			std::vector<std::vector<double>> data{ { 1.0, 2.0 }, { 3.0 }, {}, { 4.0, 5.0, 6.0 } };
+
+			auto result =
+				data
+				| collect([](std::vector<double> const& v) { return v | map([](double x) { return x * x; }); })
+				| reduce<max_monoid<double>>();
+
+			Assert::AreEqual(36.0, result);
+		}
+	};
+}
@@ -7,7 +7,15 @@
 #include <wenda/reducers/fold.h>
 #include <wenda/reducers/monoid/monoid_fold.h>
 #include <wenda/reducers/foldables/range_foldable.h>
-
+#include <wenda/reducers/reducibles/sequence_reducible.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/take.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+
+#include <atomic>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -15,6 +23,32 @@ using namespace WENDA_REDUCERS_NAMESPACE;
 
 namespace tests
 {
+	namespace
+	{
+		/**
+        * A foldable that counts how many times it was folded rather than reduced.
+		*/
+		struct counting_foldable
+		{
+			std::vector<int> const* data;
+			std::atomic<int>* folds;
+
+			template<typename Function, typename Seed>
+			Seed reduce(Function&& function, Seed seed) const
+			{
+				return std::accumulate(data->begin(), data->end(), std::move(seed), function);
+			}
+
+			template<typename Reduce, typename Combine, typename Executor>
+			typename std::decay<typename std::result_of<Combine()>::type>::type
+			fold(Reduce&& reduce, Combine&& combine, Executor&) const
+			{
+				++*folds;
+				return std::accumulate(data->begin(), data->end(), combine(), reduce);
+			}
+		};
+	}
+
 	TEST_CLASS(CollectReducibleTests)
 	{
 		TEST_METHOD(CollectReducible_Returns_Correct_Results)
@@ -77,5 +111,119 @@ namespace tests
 
 			Assert::AreEqual(1 + 2 + 3 + 4 + 5 + 6, result);
 		}
+
+		TEST_METHOD(Collect_Folds_Inner_Reducibles_On_Executor)
+		{
+			std::vector<std::vector<int>> data{ { 1, 2, 3 }, { 4, 5, 6 }, { 7 } };
+			std::atomic<int> folds(0);
+
+			auto result =
+				data
+				| collect([&](std::vector<int> const& d) { return counting_foldable{ &d, &folds }; })
+				| fold<additive_monoid<int>>(inline_executor());
+
+			Assert::AreEqual(28, result);
+			Assert::AreEqual(3, folds.load());
+		}
+
+		TEST_METHOD(Collect_Reduces_Non_Foldable_Inner_Reducibles)
+		{
+			std::vector<std::vector<int>> data{ { 1, 2, 3 }, { 4, 5, 6 } };
+			thread_pool pool(2);
+
+			auto result =
+				data
+				| collect([](std::vector<int> const& d) { return make_range_reducible(d); })
+				| fold<additive_monoid<int>>(pool);
+
+			Assert::AreEqual(1 + 2 + 3 + 4 + 5 + 6, result);
+		}
+
+		TEST_METHOD(Collect_Few_Large_Inner_Sequences_On_Thread_Pool)
+		{
+			thread_pool pool(4);
+			std::vector<long long> shards{ 0, 1, 2 };
+
+			auto result =
+				shards
+				| collect([](long long shard) { return make_sequence_reducible(shard * 1000000, (shard + 1) * 1000000, 1LL); })
+				| map([](long long n) { return n % 10; })
+				| fold<additive_monoid<long long>>(pool);
+
+			Assert::AreEqual(3000000LL / 10 * 45, result);
+		}
+
+		TEST_METHOD(Nested_Collect_Of_Vectors_On_Thread_Pool)
+		{
+			thread_pool pool(3);
+			std::vector<std::vector<std::vector<int>>> data(4, std::vector<std::vector<int>>(3, std::vector<int>(5000, 1)));
+
+			auto result =
+				data
+				| collect([](std::vector<std::vector<int>> const& d) { return d | collect([](std::vector<int> const& v) { return v; }); })
+				| fold<additive_monoid<int>>(pool);
+
+			Assert::AreEqual(4 * 3 * 5000, result);
+		}
+
+		TEST_METHOD(Collect_With_Sink_Expander_Returns_Correct_Results)
+		{
+			std::vector<int> data{ 1, 2, 3, 4 };
+
+			auto result =
+				data
+				| collect([](int n, emitter<int> emit) { for (int i = 0; i < n; ++i) { emit(n); } })
+				| reduce(std::plus<int>(), 0);
+
+			Assert::AreEqual(1 * 1 + 2 * 2 + 3 * 3 + 4 * 4, result);
+		}
+
+		TEST_METHOD(Collect_With_Sink_Expander_Can_Be_Folded)
+		{
+			thread_pool pool(4);
+			std::vector<long long> data(100000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			auto result =
+				data
+				| collect([](long long n, emitter<long long> emit) { emit(n); emit(-2 * n); })
+				| fold<additive_monoid<long long>>(pool);
+
+			Assert::AreEqual(-99999LL * 100000 / 2, result);
+		}
+
+		TEST_METHOD(Collect_With_Sink_Expander_Stops_When_Reduction_Terminates)
+		{
+			std::vector<int> data{ 10, 10, 10 };
+			int emitted = 0;
+
+			auto result =
+				data
+				| collect([&](int n, emitter<int> emit)
+				  {
+					  for (int i = 0; i < n; ++i)
+					  {
+						  ++emitted;
+						  if (!emit(i))
+						  {
+							  return;
+						  }
+					  }
+				  })
+				| take(12)
+				| reduce(std::plus<int>(), 0);
+
+			Assert::AreEqual(45 + 0 + 1, result);
+			Assert::AreEqual(12, emitted);
+		}
+
+		TEST_METHOD(Collect_Holds_LValue_Ranges_By_Reference)
+		{
+			std::vector<std::vector<int>> data{ { 1, 2, 3 }, { 4, 5, 6 } };
+			auto collected = data | collect([](std::vector<int> const& d) { return make_range_reducible(d); });
+
+			Assert::IsTrue(std::is_same<std::vector<std::vector<int>> const&, decltype(collected.reducible)>::value);
+			Assert::IsTrue(&data == &collected.reducible);
+		}
 	};
-}
\ No newline at end of file
+}
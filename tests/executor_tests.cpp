@@ -0,0 +1,150 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/foldables/range_foldable.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/collect.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/submit_executor.h>
+
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace
+	{
+		/**
+        * A minimal external "pool" that starts a thread for every submitted task.
+		*/
+		struct thread_per_task
+		{
+			std::mutex mutex;
+			std::vector<std::thread> threads;
+
+			void submit(std::function<void()> task)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				threads.push_back(std::thread(std::move(task)));
+			}
+
+			~thread_per_task()
+			{
+				for (auto& thread : threads)
+				{
+					thread.join();
+				}
+			}
+		};
+
+		/**
+        * A type with concurrency() and invoke(), but without run(), which does not model an executor.
+		*/
+		struct invoke_only
+		{
+			std::size_t concurrency() const { return 1; }
+
+			template<typename Left, typename Right>
+			void invoke(Left&& left, Right&& right) const
+			{
+				left();
+				right();
+			}
+		};
+	}
+
+	TEST_CLASS(ExecutorTests)
+	{
+		TEST_METHOD(Executors_Model_Executor_Concept)
+		{
+			Assert::IsTrue(detail::is_executor<thread_pool>::value);
+			Assert::IsTrue(detail::is_executor<inline_executor>::value);
+			Assert::IsTrue(detail::is_executor<inline_executor const&>::value);
+			Assert::IsFalse(detail::is_executor<std::vector<int>>::value);
+			Assert::IsFalse(detail::is_executor<invoke_only>::value);
+		}
+
+		TEST_METHOD(Fold_On_Inline_Executor)
+		{
+			std::vector<int> data(1000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto result = fold<additive_monoid<int>>(data, inline_executor());
+
+			Assert::AreEqual(999 * 1000 / 2, result);
+		}
+
+		TEST_METHOD(Fold_On_Thread_Pool)
+		{
+			thread_pool pool(3);
+			std::vector<int> data(1000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto result = fold(data, std::plus<int>(), detail::monoid_combine<additive_monoid<int>>(), pool);
+
+			Assert::AreEqual(999 * 1000 / 2, result);
+		}
+
+		TEST_METHOD(Fold_On_Thread_Pool_In_Pipe_Expression)
+		{
+			thread_pool pool(3);
+			std::vector<int> data(1000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto result =
+				data
+				| map([](int n) { return n * 2; })
+				| filter([](int n) { return n % 4 == 0; })
+				| fold<additive_monoid<int>>(pool);
+
+			Assert::AreEqual(2 * (998 * 500 / 2), result);
+		}
+
+		TEST_METHOD(Fold_With_Functions_In_Pipe_Expression)
+		{
+			thread_pool pool(2);
+			std::vector<int> data(100);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto result = data | fold(std::plus<int>(), detail::monoid_combine<additive_monoid<int>>());
+			auto resultOnPool = data | fold(std::plus<int>(), detail::monoid_combine<additive_monoid<int>>(), pool);
+
+			Assert::AreEqual(99 * 100 / 2, result);
+			Assert::AreEqual(99 * 100 / 2, resultOnPool);
+		}
+
+		TEST_METHOD(Collect_Fold_On_Executor)
+		{
+			std::vector<std::vector<int>> data{ { 1, 2, 3 }, { 4, 5, 6 } };
+
+			auto result =
+				data
+				| collect([](std::vector<int> const& d) { return d; })
+				| fold<additive_monoid<int>>(inline_executor());
+
+			Assert::AreEqual(1 + 2 + 3 + 4 + 5 + 6, result);
+		}
+
+		TEST_METHOD(Fold_On_Submit_Executor)
+		{
+			thread_per_task external;
+			auto executor = make_submit_executor([&](std::function<void()> task) { external.submit(std::move(task)); }, 4);
+			std::vector<int> data(10000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto result = data | map([](int n) { return n % 7; }) | fold<additive_monoid<int>>(executor);
+
+			Assert::AreEqual(std::accumulate(data.begin(), data.end(), 0, [](int acc, int n) { return acc + n % 7; }), result);
+		}
+	};
+}
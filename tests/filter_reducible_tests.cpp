@@ -3,10 +3,15 @@
 
 #include <wenda/reducers/transformers/filter.h>
 #include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/reducibles/iterator_pair_reducible.h>
 #include <wenda/reducers/reduce.h>
 #include <wenda/reducers/foldables/range_foldable.h>
 #include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/monoid/monoid_reduce.h>
+#include <wenda/reducers/executors/thread_pool.h>
 
+#include <numeric>
+#include <type_traits>
 #include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -63,5 +68,91 @@ namespace tests
 
 			Assert::AreEqual(2 + 4, result);
 		}
+
+		TEST_METHOD(Filter_Sums_Contiguous_Elements_At_Any_Selectivity)
+		{
+			std::vector<int> data(1000);
+			std::iota(data.begin(), data.end(), -300);
+
+			for (int modulus = 1; modulus <= 7; ++modulus)
+			{
+				auto predicate = [modulus](int n) { return n % modulus == 0; };
+
+				int expected = 0;
+				for (auto n : data)
+				{
+					expected += predicate(n) ? n : 0;
+				}
+
+				auto fromRange = data | filter(predicate) | reduce(std::plus<int>(), 0);
+				auto fromPointers = make_iterator_pair_reducible(data.data(), data.data() + data.size())
+					| filter(predicate)
+					| reduce(std::plus<int>(), 0);
+
+				Assert::AreEqual(expected, fromRange);
+				Assert::AreEqual(expected, fromPointers);
+			}
+
+			Assert::AreEqual(0, data | filter([](int) { return false; }) | reduce(std::plus<int>(), 0));
+		}
+
+		TEST_METHOD(Filter_Masks_Elements_With_The_Unit_Of_The_Operation)
+		{
+			std::vector<unsigned> data(777);
+			std::iota(data.begin(), data.end(), 1u);
+
+			auto isOdd = [](unsigned n) { return n % 2 == 1; };
+
+			unsigned expectedAnd = ~0u;
+			unsigned expectedXor = 0;
+			for (auto n : data)
+			{
+				expectedAnd &= isOdd(n) ? n : ~0u;
+				expectedXor ^= isOdd(n) ? n : 0u;
+			}
+
+			Assert::AreEqual(expectedAnd, data | filter(isOdd) | reduce(std::bit_and<unsigned>(), ~0u));
+			Assert::AreEqual(expectedXor, data | filter(isOdd) | reduce(std::bit_xor<unsigned>(), 0u));
+		}
+
+		TEST_METHOD(Filter_Masks_Floating_Point_Monoids)
+		{
+			std::vector<double> data(1000);
+			std::iota(data.begin(), data.end(), -500.0);
+
+			auto isPositive = [](double x) { return x > 0; };
+			thread_pool pool(4);
+
+			Assert::AreEqual(1.0, data | filter(isPositive) | reduce<min_monoid<double>>());
+			Assert::AreEqual(1.0, data | filter(isPositive) | fold<min_monoid<double>>(pool));
+			Assert::AreEqual(-500.0, data | filter([](double x) { return x < 0; }) | fold<min_monoid<double>>(pool));
+			Assert::AreEqual(499.0 * 500.0 / 2, data | filter(isPositive) | fold<additive_monoid<double>>(pool));
+		}
+
+		TEST_METHOD(Filter_Keeps_Other_Seed_Types_Exact)
+		{
+			std::vector<int> data(1000, 1 << 30);
+
+			auto result = data
+				| filter([](int n) { return n > 0; })
+				| reduce(std::plus<long long>(), 0LL);
+
+			Assert::AreEqual(1000LL << 30, result);
+		}
+
+		TEST_METHOD(Filter_Holds_LValue_Ranges_By_Reference_And_Copies_Transformers)
+		{
+			std::vector<int> data{ 1, 2, 3, 4 };
+			auto even = [](int n) { return n % 2 == 0; };
+			auto filtered = data | filter(even);
+			auto refiltered = filtered | filter([](int n) { return n > 2; });
+
+			Assert::IsTrue(std::is_same<std::vector<int> const&, decltype(filtered.reducible)>::value);
+			Assert::IsTrue(std::is_same<decltype(filtered), decltype(refiltered.reducible)>::value);
+
+			data.push_back(6);
+			Assert::AreEqual(2 + 4 + 6, filtered | fold<additive_monoid<int>>());
+			Assert::AreEqual(4 + 6, refiltered | reduce(std::plus<int>(), 0));
+		}
 	};
-}
\ No newline at end of file
+}
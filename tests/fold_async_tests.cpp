@@ -0,0 +1,157 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/fold_async.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/submit_executor.h>
+#include <wenda/reducers/executors/partitioners.h>
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	TEST_CLASS(FoldAsyncTests)
+	{
+		TEST_METHOD(Fold_Async_On_Thread_Pool)
+		{
+			thread_pool pool(3);
+			std::vector<long long> data(100000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			std::future<long long> result = fold_async(data, std::plus<long long>(), detail::monoid_combine<additive_monoid<long long>>(), pool);
+
+			Assert::AreEqual(99999LL * 100000LL / 2, result.get());
+		}
+
+		TEST_METHOD(Fold_Async_On_Default_Thread_Pool)
+		{
+			std::vector<long long> data(1000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			auto result = fold_async(data, std::plus<long long>(), detail::monoid_combine<additive_monoid<long long>>());
+			auto monoidResult = fold_async<additive_monoid<long long>>(data);
+
+			Assert::AreEqual(999LL * 1000LL / 2, result.get());
+			Assert::AreEqual(999LL * 1000LL / 2, monoidResult.get());
+		}
+
+		TEST_METHOD(Fold_Async_In_Pipe_Expression)
+		{
+			thread_pool pool(4);
+			std::vector<long long> data(10000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			std::future<long long> result =
+				data
+				| filter([](long long n) { return n % 2 == 0; })
+				| map([](long long n) { return n * 3; })
+				| fold_async<additive_monoid<long long>>(pool);
+
+			auto resultDefault = data | fold_async<additive_monoid<long long>>();
+			auto resultFunctions = data | fold_async(std::plus<long long>(), detail::monoid_combine<additive_monoid<long long>>(), pool);
+
+			Assert::AreEqual(3 * 2 * (4999LL * 5000LL / 2), result.get());
+			Assert::AreEqual(9999LL * 10000LL / 2, resultDefault.get());
+			Assert::AreEqual(9999LL * 10000LL / 2, resultFunctions.get());
+		}
+
+		TEST_METHOD(Fold_Async_Copies_LValue_Range)
+		{
+			thread_pool pool(2);
+			std::vector<long long> data(100000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			auto result = fold_async<additive_monoid<long long>>(data, pool);
+			std::fill(data.begin(), data.end(), 0LL);
+
+			Assert::AreEqual(99999LL * 100000LL / 2, result.get());
+		}
+
+		TEST_METHOD(Fold_Async_Does_Not_Block_Caller)
+		{
+			thread_pool pool(2);
+			std::promise<void> release;
+			std::shared_future<void> released = release.get_future().share();
+			std::vector<long long> data(100);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			// the fold cannot complete before the caller releases it, hence fold_async must return first.
+			auto result =
+				data
+				| map([released](long long n) { released.wait(); return n; })
+				| fold_async<additive_monoid<long long>>(pool);
+
+			Assert::IsTrue(result.wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout);
+			release.set_value();
+			Assert::AreEqual(99LL * 100LL / 2, result.get());
+		}
+
+		TEST_METHOD(Fold_Async_Propagates_Exceptions)
+		{
+			thread_pool pool(2);
+			std::vector<long long> data(1000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			auto result =
+				data
+				| map([](long long n) -> long long { if (n == 500) throw std::runtime_error("failed"); return n; })
+				| fold_async<additive_monoid<long long>>(pool);
+
+			Assert::ExpectException<std::runtime_error>([&] { result.get(); });
+		}
+
+		TEST_METHOD(Fold_Async_On_Inline_Executor_Is_Ready)
+		{
+			std::vector<long long> data(1000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			auto result = data | fold_async<additive_monoid<long long>>(inline_executor());
+
+			Assert::IsTrue(result.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready);
+			Assert::AreEqual(999LL * 1000LL / 2, result.get());
+		}
+
+		TEST_METHOD(Fold_Async_On_Submit_And_Partitioned_Executors)
+		{
+			std::mutex mutex;
+			std::vector<std::thread> threads;
+			auto executor = make_submit_executor([&](std::function<void()> task)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				threads.push_back(std::thread(std::move(task)));
+			}, 2);
+
+			thread_pool pool(3);
+			std::vector<long long> data(10000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			auto submitted = data | fold_async<additive_monoid<long long>>(executor);
+			auto partitioned = data | fold_async<additive_monoid<long long>>(with_partitioner(pool, lazy_partitioner()));
+
+			Assert::AreEqual(9999LL * 10000LL / 2, submitted.get());
+			Assert::AreEqual(9999LL * 10000LL / 2, partitioned.get());
+
+			std::lock_guard<std::mutex> lock(mutex);
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+		}
+	};
+}
@@ -0,0 +1,147 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/fold_into.h>
+#include <wenda/reducers/into.h>
+#include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/reducibles/sequence_reducible.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/collect.h>
+#include <wenda/reducers/transformers/take.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/partitioners.h>
+
+#include <deque>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace splittables
+	{
+		/**
+        * A splittable interval of integers, which accumulates by value.
+		*/
+		struct interval
+		{
+			int low;
+			int high;
+
+			std::size_t size() const
+			{
+				return static_cast<std::size_t>(high - low);
+			}
+
+			std::pair<interval, interval> split() const
+			{
+				int middle = low + (high - low) / 2;
+				interval left = { low, middle };
+				interval right = { middle, high };
+				return std::make_pair(left, right);
+			}
+
+			template<typename Function, typename Seed>
+			Seed reduce(Function&& function, Seed seed) const
+			{
+				for (int n = low; n < high; ++n)
+				{
+					seed = function(std::move(seed), n);
+				}
+
+				return seed;
+			}
+		};
+	}
+
+	TEST_CLASS(FoldIntoTests)
+	{
+		TEST_METHOD(Fold_Into_Writes_Mapped_Ranges_By_Index)
+		{
+			thread_pool pool(4);
+			std::vector<int> data(100000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto mapped = data | map([](int n) { return n * 3LL; });
+			auto result = mapped | fold_into<std::vector<long long>>(pool);
+
+			Assert::IsTrue(detail::indexed_reducible<decltype(mapped)>::value);
+			Assert::AreEqual(data.size(), result.size());
+			for (std::size_t i = 0; i < data.size(); ++i)
+			{
+				Assert::AreEqual(static_cast<long long>(i) * 3, result[i]);
+			}
+		}
+
+		TEST_METHOD(Fold_Into_Writes_Sequences_By_Index)
+		{
+			thread_pool pool(3);
+
+			auto result = make_sequence_reducible(5, 50005, 5) | map([](int n) { return std::to_string(n); }) | fold_into<std::deque<std::string>>(pool);
+
+			Assert::AreEqual(std::size_t(10000), result.size());
+			Assert::AreEqual(std::string("5"), result.front());
+			Assert::AreEqual(std::string("50000"), result.back());
+		}
+
+		TEST_METHOD(Fold_Into_Keeps_Order_Of_Filtered_Elements)
+		{
+			thread_pool pool(4);
+			std::vector<int> data(200000);
+			std::iota(data.begin(), data.end(), 0);
+			auto selective = [](int n) { return n % 7 == 3; };
+
+			auto filtered = data | filter(selective);
+			auto result = filtered | fold_into<std::vector<int>>(pool);
+			auto expected = filtered | into_container<std::vector<int>>();
+
+			Assert::IsFalse(detail::indexed_reducible<decltype(filtered)>::value);
+			Assert::IsTrue(expected == result);
+		}
+
+		TEST_METHOD(Fold_Into_Keeps_Order_Of_Collected_Elements_On_Any_Partitioner)
+		{
+			thread_pool pool(4);
+			std::vector<int> data(3000);
+			std::iota(data.begin(), data.end(), 0);
+			auto expand = [](int n) { return std::vector<int>(n % 5, n); };
+
+			auto expected = data | collect(expand) | into_container<std::vector<int>>();
+
+			Assert::IsTrue(expected == (data | collect(expand) | fold_into<std::vector<int>>(pool)));
+			Assert::IsTrue(expected == (data | collect(expand) | fold_into<std::vector<int>>(with_partitioner(pool, lazy_partitioner()))));
+			Assert::IsTrue(expected == (data | collect(expand) | fold_into<std::vector<int>>(with_partitioner(inline_executor(), deterministic_partitioner(64)))));
+		}
+
+		TEST_METHOD(Fold_Into_Materializes_Non_Indexed_Exact_Pipelines)
+		{
+			std::list<int> data{ 1, 2, 3, 4, 5 };
+
+			auto result = data | take(3) | fold_into<std::vector<int>>();
+
+			Assert::IsTrue(std::vector<int>{ 1, 2, 3 } == result);
+			Assert::IsTrue(fold_into<std::vector<int>>(std::vector<int>()).empty());
+		}
+
+		TEST_METHOD(Fold_Into_Keeps_Order_Of_Splittable_Elements)
+		{
+			thread_pool pool(4);
+			splittables::interval i = { 0, 100000 };
+			std::vector<int> expected(100000);
+			std::iota(expected.begin(), expected.end(), 0);
+
+			auto result = i | fold_into<std::vector<int>>(pool);
+			auto filtered = i | filter([](int n) { return n % 2 == 0; }) | fold_into<std::vector<int>>(with_partitioner(pool, lazy_partitioner(64)));
+
+			Assert::IsTrue(expected == result);
+			Assert::AreEqual(std::size_t(50000), filtered.size());
+			Assert::AreEqual(99998, filtered.back());
+		}
+	};
+}
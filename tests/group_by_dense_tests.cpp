@@ -0,0 +1,116 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/group_by_dense.h>
+#include <wenda/reducers/monoid/monoid.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/foldables/range_foldable.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/partitioners.h>
+
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	enum class channel { web, store, phone };
+
+	TEST_CLASS(GroupByDenseTests)
+	{
+		TEST_METHOD(Group_By_Dense_Folds_Each_Key_Over_The_Monoid)
+		{
+			thread_pool pool(4);
+			std::vector<long long> data(1000000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			auto hour = [](long long n) { return n % 24; };
+			auto totals = data | group_by_dense<additive_monoid<long long>>(hour, 24, with_partitioner(pool, deterministic_partitioner(4096)));
+
+			std::vector<long long> expected(24);
+			for (long long n : data)
+			{
+				expected[n % 24] += n;
+			}
+
+			Assert::IsTrue(expected == totals);
+		}
+
+		TEST_METHOD(Group_By_Dense_Folds_Values_Computed_From_The_Elements)
+		{
+			thread_pool pool(4);
+			std::vector<int> minutes(10000);
+			std::iota(minutes.begin(), minutes.end(), 0);
+
+			auto hour_of = [](int minute) { return (minute / 60) % 24; };
+			auto one = [](int) { return 1; };
+			auto perHour = group_by_dense<additive_monoid<int>>(minutes, hour_of, one, 24, pool);
+			auto sequential = group_by_dense<additive_monoid<int>>(minutes | filter([](int m) { return m < 120; }), hour_of, one, 24);
+
+			std::vector<int> expected(24);
+			for (int minute : minutes)
+			{
+				++expected[hour_of(minute)];
+			}
+
+			Assert::IsTrue(expected == perHour);
+			Assert::AreEqual(60, sequential[0]);
+			Assert::AreEqual(60, sequential[1]);
+			Assert::AreEqual(0, sequential[2]);
+		}
+
+		TEST_METHOD(Group_By_Dense_Composes_With_Map_And_Filter)
+		{
+			thread_pool pool(3);
+			std::vector<int> data(100000);
+			std::iota(data.begin(), data.end(), 0);
+			auto key = [](int n) { return n % 37; };
+
+			auto maxima = data
+				| filter([](int n) { return n % 5 != 0; })
+				| map([](int n) { return n * 2; })
+				| group_by_dense<max_monoid<int>>(key, 40, pool);
+			auto sequential = data
+				| filter([](int n) { return n % 5 != 0; })
+				| map([](int n) { return n * 2; })
+				| group_by_dense<max_monoid<int>>(key, 40, inline_executor());
+
+			Assert::IsTrue(sequential == maxima);
+			Assert::AreEqual(std::size_t(40), maxima.size());
+			Assert::AreEqual(199998, maxima[199998 % 37]);
+			Assert::AreEqual(std::numeric_limits<int>::min(), maxima[39]);
+		}
+
+		TEST_METHOD(Group_By_Dense_Accepts_Enumerations_And_Any_Monoid)
+		{
+			thread_pool pool(4);
+			std::vector<std::string> data;
+			for (int i = 0; i < 3000; ++i)
+			{
+				data.push_back(std::string(1, static_cast<char>('a' + i % 3)));
+			}
+
+			auto channel_of = [](std::string const& s) { return static_cast<channel>(s[0] - 'a'); };
+			auto joined = group_by_dense<additive_monoid<std::string>>(data, channel_of, 3, with_partitioner(pool, deterministic_partitioner(16)));
+
+			Assert::AreEqual(std::size_t(3), joined.size());
+			Assert::AreEqual(std::string(1000, 'b'), joined[static_cast<std::size_t>(channel::store)]);
+		}
+
+		TEST_METHOD(Group_By_Dense_Rejects_Keys_Outside_Of_The_Domain)
+		{
+			std::vector<int> data{ 1, 2, 3, -1 };
+
+			Assert::ExpectException<std::out_of_range>([&] { group_by_dense<additive_monoid<int>>(data, [](int n) { return n; }, 4); });
+			Assert::ExpectException<std::out_of_range>([&] { group_by_dense<additive_monoid<int>>(data, [](int n) { return n + 2; }, 4); });
+		}
+	};
+}
@@ -0,0 +1,184 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/group_by.h>
+#include <wenda/reducers/group_map.h>
+#include <wenda/reducers/monoid/monoid.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/collect.h>
+#include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/foldables/range_foldable.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/partitioners.h>
+
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	struct sale
+	{
+		std::string country;
+		long long amount;
+	};
+
+	namespace
+	{
+		std::vector<std::string> split_words(std::string const& line)
+		{
+			std::istringstream stream(line);
+			std::vector<std::string> words;
+			std::string word;
+
+			while (stream >> word)
+			{
+				words.push_back(word);
+			}
+
+			return words;
+		}
+	}
+
+	TEST_CLASS(GroupByTests)
+	{
+		TEST_METHOD(Group_Map_Inserts_And_Finds_Colliding_Keys)
+		{
+			group_map<long long, int> groups;
+
+			for (int i = 0; i < 20000; ++i)
+			{
+				Assert::IsTrue(groups.insert(std::make_pair(static_cast<long long>(i) << 20, i)).second);
+			}
+
+			Assert::IsFalse(groups.insert(std::make_pair(5LL << 20, -1)).second);
+			Assert::AreEqual(std::size_t(20000), groups.size());
+			Assert::AreEqual(12345, groups.at(12345LL << 20));
+			Assert::AreEqual(std::size_t(0), groups.count(3));
+			Assert::IsTrue(groups.find(3) == groups.end());
+			Assert::ExpectException<std::out_of_range>([&] { groups.at(3); });
+			Assert::AreEqual(19999, (groups.end() - 1)->second);
+		}
+
+		TEST_METHOD(Group_By_Folds_Each_Group_Over_The_Monoid)
+		{
+			thread_pool pool(4);
+			std::vector<int> data(100000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto groups = data | group_by<additive_monoid<long long>>([](long long n) { return n % 97; }, pool);
+
+			std::map<long long, long long> expected;
+			for (int n : data)
+			{
+				expected[n % 97] += n;
+			}
+
+			Assert::AreEqual(expected.size(), groups.size());
+			for (auto const& entry : expected)
+			{
+				Assert::AreEqual(entry.second, groups.at(entry.first));
+			}
+		}
+
+		TEST_METHOD(Group_By_Combines_Groups_In_Order)
+		{
+			thread_pool pool(4);
+			std::vector<std::string> data;
+			for (int i = 0; i < 5000; ++i)
+			{
+				data.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+			}
+
+			auto first_letter = [](std::string const& s) { return s[0]; };
+			auto sequential = group_by<additive_monoid<std::string>>(data, first_letter, inline_executor());
+			auto parallel = group_by<additive_monoid<std::string>>(data, first_letter, with_partitioner(pool, deterministic_partitioner(64)));
+
+			Assert::AreEqual(std::size_t(26), parallel.size());
+			for (auto const& entry : sequential)
+			{
+				Assert::AreEqual(entry.second, parallel.at(entry.first));
+			}
+		}
+
+		TEST_METHOD(Group_By_Aggregates_The_Values_Of_Records)
+		{
+			thread_pool pool(4);
+			char const* countries[] = { "fr", "de", "jp", "br", "ca" };
+			std::vector<sale> sales;
+			for (int i = 0; i < 50000; ++i)
+			{
+				sales.push_back(sale{ countries[i * 7 % 5], i % 1000 });
+			}
+
+			auto country = [](sale const& s) { return s.country; };
+			auto amount = [](sale const& s) { return s.amount; };
+			auto totals = group_by<additive_monoid<long long>>(sales, country, amount, pool);
+			auto large = group_by<additive_monoid<long long>>(sales | filter([](sale const& s) { return s.amount >= 500; }), country, amount);
+
+			std::map<std::string, long long> expected;
+			std::map<std::string, long long> expected_large;
+			for (sale const& s : sales)
+			{
+				expected[s.country] += s.amount;
+				if (s.amount >= 500)
+				{
+					expected_large[s.country] += s.amount;
+				}
+			}
+
+			Assert::AreEqual(expected.size(), totals.size());
+			Assert::AreEqual(expected_large.size(), large.size());
+			for (auto const& entry : expected)
+			{
+				Assert::AreEqual(entry.second, totals.at(entry.first));
+				Assert::AreEqual(expected_large.at(entry.first), large.at(entry.first));
+			}
+		}
+
+		TEST_METHOD(Group_By_Composes_With_Transformers)
+		{
+			std::vector<int> data(10000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto groups = data
+				| filter([](int n) { return n % 2 == 0; })
+				| map([](int n) { return n / 2; })
+				| group_by<additive_monoid<int>>([](int n) { return n % 3 == 0 ? std::string("fizz") : std::string("other"); });
+
+			Assert::AreEqual(std::size_t(2), groups.size());
+			Assert::AreEqual(4165833, groups.at("fizz"));
+			Assert::AreEqual(12497500, groups.at("fizz") + groups.at("other"));
+			Assert::IsTrue((std::vector<int>() | group_by<additive_monoid<int>>([](int n) { return n; })).empty());
+		}
+
+		TEST_METHOD(Group_By_Keys_Collected_Elements_Of_Another_Type_Than_The_Monoid)
+		{
+			thread_pool pool(4);
+			std::vector<std::string> lines{ "the quick fox", "the lazy dog", "a quick dog", "the end" };
+			auto word = [](std::string const& w) { return w; };
+			auto one = [](std::string const&) { return 1; };
+
+			auto counts = group_by<additive_monoid<int>>(lines | collect(split_words), word, one, pool);
+			auto emitted = lines | collect([](std::string const& line, emitter<std::string> emit) { for (auto const& w : split_words(line)) { emit(w); } });
+			auto sunk = group_by<additive_monoid<int>, std::string>(emitted, word, one, pool);
+
+			Assert::AreEqual(std::size_t(7), counts.size());
+			Assert::AreEqual(3, counts.at("the"));
+			Assert::AreEqual(2, counts.at("quick"));
+			Assert::AreEqual(2, counts.at("dog"));
+			Assert::AreEqual(1, counts.at("end"));
+			Assert::AreEqual(std::size_t(7), sunk.size());
+			Assert::AreEqual(3, sunk.at("the"));
+			Assert::AreEqual(2, sunk.at("dog"));
+		}
+	};
+}
@@ -4,7 +4,15 @@
 #include <wenda/reducers/into.h>
 #include <wenda/reducers/reduce.h>
 #include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/reducibles/sequence_reducible.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/collect.h>
 
+#include <deque>
+#include <list>
+#include <numeric>
+#include <string>
 #include <vector>
 #include <set>
 
@@ -13,6 +21,62 @@ using namespace WENDA_REDUCERS_NAMESPACE;
 
 namespace tests
 {
+	namespace hinted
+	{
+		/**
+        * A splittable view over a part of a buffer, whose size() is an estimate that under-reports its elements.
+		*/
+		struct underestimated_view
+		{
+			int const* first;
+			int const* last;
+
+			std::size_t size() const
+			{
+				return static_cast<std::size_t>(last - first) / 2;
+			}
+
+			std::pair<underestimated_view, underestimated_view> split() const
+			{
+				int const* middle = first + (last - first) / 2;
+				underestimated_view left = { first, middle };
+				underestimated_view right = { middle, last };
+				return std::make_pair(left, right);
+			}
+
+			template<typename Function, typename Seed>
+			Seed reduce(Function&& function, Seed seed) const
+			{
+				for (int const* it = first; it != last; ++it)
+				{
+					seed = function(std::move(seed), *it);
+				}
+
+				return seed;
+			}
+		};
+
+		/**
+        * A reducible over a vector, which reports the given size hint rather than its own.
+		*/
+		struct misreported
+		{
+			std::vector<int> const& data;
+			size_hint hint;
+
+			size_hint get_size_hint() const
+			{
+				return hint;
+			}
+
+			template<typename Function, typename Seed>
+			Seed reduce(Function&& function, Seed seed) const
+			{
+				return make_range_reducible(data).reduce(function, std::move(seed));
+			}
+		};
+	}
+
 	TEST_CLASS(IntoTests)
 	{
 		TEST_METHOD(Into_Can_Accumulate_To_Vector)
@@ -38,5 +102,68 @@ namespace tests
 			Assert::IsTrue(result.find(1) != result.end());
 			Assert::IsTrue(result.find(2) != result.end());
 		}
+
+		TEST_METHOD(Into_Container_Allocates_Exactly_Sized_Vector_Once)
+		{
+			std::vector<int> data(1000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto result = data | map([](int n) { return n * 2; }) | into_container<std::vector<int>>();
+
+			Assert::AreEqual(std::size_t(1000), result.size());
+			Assert::AreEqual(std::size_t(1000), result.capacity());
+			for (int i = 0; i < 1000; ++i)
+			{
+				Assert::AreEqual(i * 2, result[i]);
+			}
+		}
+
+		TEST_METHOD(Into_Container_Appends_Elements_Without_Exact_Size)
+		{
+			std::vector<std::vector<int>> nested{ { 1, 2 }, { 3 }, { 4, 5, 6 } };
+
+			auto filtered = make_sequence_reducible(0, 20, 1) | filter([](int n) { return n % 3 == 0; }) | into_container<std::vector<int>>();
+			auto collected = nested | collect([](std::vector<int> const& d) { return d; }) | into_container<std::vector<int>>();
+
+			Assert::IsTrue(std::vector<int>{ 0, 3, 6, 9, 12, 15, 18 } == filtered);
+			Assert::IsTrue(std::vector<int>{ 1, 2, 3, 4, 5, 6 } == collected);
+		}
+
+		TEST_METHOD(Into_Container_Does_Not_Trust_Estimated_Sizes)
+		{
+			std::vector<int> data(100);
+			std::iota(data.begin(), data.end(), 0);
+			hinted::underestimated_view view = { data.data(), data.data() + data.size() };
+
+			auto result = into_container<std::vector<int>>(view);
+
+			Assert::IsFalse(get_size_hint(view).is_bounded());
+			Assert::IsTrue(data == result);
+		}
+
+		TEST_METHOD(Into_Container_Fills_Vector_Despite_Wrong_Exact_Hint)
+		{
+			std::vector<int> data(100);
+			std::iota(data.begin(), data.end(), 0);
+			hinted::misreported under = { data, size_hint(size_hint::exact, 10) };
+			hinted::misreported over = { data, size_hint(size_hint::exact, 1000) };
+
+			Assert::IsTrue(data == into_container<std::vector<int>>(under));
+			Assert::IsTrue(data == into_container<std::vector<int>>(over));
+			Assert::IsTrue(std::deque<int>(data.begin(), data.end()) == into_container<std::deque<int>>(under));
+		}
+
+		TEST_METHOD(Into_Container_Supports_Other_Sequence_Containers)
+		{
+			std::vector<int> data{ 1, 2, 3, 4 };
+
+			auto deque = into_container<std::deque<int>>(data);
+			auto list = into_container<std::list<int>>(data);
+			auto text = data | map([](int n) { return static_cast<char>('a' + n); }) | into_container<std::string>();
+
+			Assert::IsTrue(std::equal(data.begin(), data.end(), deque.begin()));
+			Assert::IsTrue(std::equal(data.begin(), data.end(), list.begin()));
+			Assert::AreEqual(std::string("bcde"), text);
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/reducibles/iterator_pair_reducible.h>
+#include <wenda/reducers/reduce.h>
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/executors/thread_pool.h>
+
+#include <forward_list>
+#include <numeric>
+#include <sstream>
+#include <iterator>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	TEST_CLASS(IteratorPairReducibleTests)
+	{
+		TEST_METHOD(iterator_pair_reducible_reduce_is_correct)
+		{
+			int data[] = { 1, 2, 3, 4, 5 };
+
+			auto result = make_iterator_pair_reducible(data, data + 5) | reduce(std::plus<int>(), 0);
+
+			Assert::AreEqual(15, result);
+		}
+
+		TEST_METHOD(iterator_pair_reducible_fold_of_raw_buffer_is_correct)
+		{
+			thread_pool pool(4);
+			std::vector<long long> buffer(100000);
+			std::iota(buffer.begin(), buffer.end(), 0LL);
+			long long* data = buffer.data();
+
+			auto result =
+				make_iterator_pair_reducible(data, data + buffer.size())
+				| fold<additive_monoid<long long>>(pool);
+
+			Assert::AreEqual(99999LL * 100000LL / 2, result);
+		}
+
+		TEST_METHOD(iterator_pair_reducible_fold_in_pipeline_is_correct)
+		{
+			std::vector<int> buffer(1000);
+			std::iota(buffer.begin(), buffer.end(), 0);
+			int const* data = buffer.data();
+
+			auto result =
+				make_iterator_pair_reducible(data, data + buffer.size())
+				| filter([](int n) { return n % 2 == 0; })
+				| fold<additive_monoid<int>>();
+
+			Assert::AreEqual(2 * (499 * 500 / 2), result);
+		}
+
+		TEST_METHOD(iterator_pair_reducible_fold_of_forward_iterators_is_correct)
+		{
+			thread_pool pool(3);
+			std::forward_list<int> list;
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				list.push_front(i);
+			}
+
+			auto result = make_iterator_pair_reducible(list.begin(), list.end()) | fold<additive_monoid<int>>(pool);
+
+			Assert::AreEqual(999 * 1000 / 2, result);
+		}
+
+		TEST_METHOD(iterator_pair_reducible_fold_of_input_iterators_is_correct)
+		{
+			std::istringstream stream("1 2 3 4 5");
+
+			auto result =
+				make_iterator_pair_reducible(std::istream_iterator<int>(stream), std::istream_iterator<int>())
+				| fold<additive_monoid<int>>();
+
+			Assert::AreEqual(15, result);
+		}
+
+		TEST_METHOD(iterator_pair_reducible_fold_of_empty_range_is_identity)
+		{
+			int* data = nullptr;
+
+			auto result = make_iterator_pair_reducible(data, data) | fold<additive_monoid<int>>();
+
+			Assert::AreEqual(0, result);
+		}
+	};
+}
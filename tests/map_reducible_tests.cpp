@@ -7,6 +7,7 @@
 #include <wenda/reducers/foldables/range_foldable.h>
 #include <wenda/reducers/monoid/monoid_fold.h>
 
+#include <type_traits>
 #include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -70,5 +71,29 @@ namespace tests
 
 			Assert::AreEqual((1 + 2 + 3 + 4 + 5 + 6) * 2, result);
 		}
+
+		TEST_METHOD(Map_Holds_LValue_Ranges_By_Reference)
+		{
+			std::vector<int> data{ 1, 2, 3 };
+			auto mapped = data | map([](int n) { return n * 2; });
+
+			typedef decltype(mapped.reducible) stored_t;
+			Assert::IsTrue(std::is_same<std::vector<int> const&, stored_t>::value);
+
+			data.push_back(4);
+			Assert::AreEqual((1 + 2 + 3 + 4) * 2, mapped | reduce(std::plus<int>(), 0));
+		}
+
+		TEST_METHOD(Map_Moves_RValue_Ranges_And_Keeps_Arrays_As_Ranges)
+		{
+			int array[] = { 1, 2, 3 };
+			auto fromArray = array | map([](int n) { return n * 2; });
+			auto fromVector = std::vector<int>{ 1, 2, 3 } | map([](int n) { return n * 2; });
+
+			Assert::IsTrue(std::is_same<int const(&)[3], decltype(fromArray.reducible)>::value);
+			Assert::IsTrue(std::is_same<std::vector<int>, decltype(fromVector.reducible)>::value);
+			Assert::AreEqual(12, fromArray | fold<additive_monoid<int>>());
+			Assert::AreEqual(12, fromVector | fold<additive_monoid<int>>());
+		}
 	};
-}
\ No newline at end of file
+}
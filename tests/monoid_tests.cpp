@@ -2,15 +2,37 @@
 #include <CppUnitTest.h>
 
 #include <wenda/reducers/monoid/monoid_reduce.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
 #include <wenda/reducers/reducibles/range_reducible.h>
-
+#include <wenda/reducers/foldables/range_foldable.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/executors/thread_pool.h>
+
+#include <cmath>
+#include <deque>
+#include <numeric>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 namespace r = WENDA_REDUCERS_NAMESPACE;
 
 namespace tests
 {
+	namespace
+	{
+		/**
+        * A monoid that is associative but not commutative, which checks that reductions keep the order of the elements.
+		*/
+		struct concatenation_monoid
+		{
+			typedef std::string element_t;
+			typedef std::plus<std::string> operation_t;
+			static element_t unit() { return std::string(); }
+		};
+	}
+
 	TEST_CLASS(MonoidTests)
 	{
 		TEST_METHOD(AdditiveMonoid_Has_Correct_Element_Type)
@@ -55,5 +77,123 @@ namespace tests
 
 			Assert::AreEqual(1 + 2 + 3 + 4 + 5, result);
 		}
+
+		TEST_METHOD(Reduce_Over_Monoid_Keeps_Order_Of_Random_Access_Ranges)
+		{
+			using r::reduce;
+
+			std::string const alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMN";
+
+			for (std::size_t size = 0; size < alphabet.size(); ++size)
+			{
+				auto letters = alphabet.substr(0, size);
+				std::vector<std::string> vector;
+				std::deque<std::string> deque;
+
+				for (auto c : letters)
+				{
+					vector.push_back(std::string(1, c));
+					deque.push_back(std::string(1, c));
+				}
+
+				Assert::AreEqual(letters, reduce<concatenation_monoid>(vector));
+				Assert::AreEqual(letters, reduce<concatenation_monoid>(deque));
+				Assert::AreEqual(letters, r::make_range_reducible(vector) | reduce<concatenation_monoid>());
+			}
+		}
+
+		TEST_METHOD(Fold_Over_Monoid_Keeps_Order_Of_Blocks)
+		{
+			using r::fold;
+			r::thread_pool pool(4);
+
+			std::string letters;
+
+			for (int i = 0; i < 200; ++i)
+			{
+				letters += "abcdefghijklmnopqrstuvwxyz";
+			}
+
+			std::vector<std::string> pieces;
+			for (auto c : letters)
+			{
+				pieces.push_back(std::string(1, c));
+			}
+
+			auto mapped = letters
+				| r::map([](char c) { return std::string(1, c); })
+				| fold<concatenation_monoid>(pool);
+
+			Assert::AreEqual(letters, pieces | fold<concatenation_monoid>(pool));
+			Assert::AreEqual(letters, mapped);
+		}
+
+		TEST_METHOD(Reduce_Over_Monoid_Of_Other_Element_Type)
+		{
+			using r::reduce;
+			std::deque<int> data;
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				data.push_back(1 << 30);
+			}
+
+			Assert::AreEqual(1000LL << 30, reduce<r::additive_monoid<long long>>(data));
+		}
+
+		TEST_METHOD(Kahan_Monoid_Compensates_Rounding_Errors)
+		{
+			using r::reduce;
+			using r::fold;
+			r::thread_pool pool(4);
+
+			// 1 followed by many values that are each too small to change it, so that a naive sum loses them.
+			std::vector<double> data(1000001, 1e-16);
+			data[0] = 1.0;
+			std::deque<double> deque(data.begin(), data.end());
+			double const expected = 1.0 + 1e-10;
+
+			double naive = std::accumulate(data.begin(), data.end(), 0.0);
+			double compensated = reduce<r::kahan_monoid<double>>(data);
+			double fromDeque = reduce<r::kahan_monoid<double>>(deque);
+			double folded = data | fold<r::kahan_monoid<double>>(pool);
+			double mapped = data | r::map([](double x) { return x; }) | fold<r::kahan_monoid<double>>(pool);
+
+			Assert::IsTrue(std::abs(naive - expected) > 1e-12);
+			Assert::AreEqual(expected, compensated, 1e-15);
+			Assert::AreEqual(expected, fromDeque, 1e-15);
+			Assert::AreEqual(expected, folded, 1e-15);
+			Assert::AreEqual(expected, mapped, 1e-15);
+		}
+
+		TEST_METHOD(Kahan_Monoid_Merges_Compensated_Sums)
+		{
+			r::kahan_monoid<double>::operation_t op;
+
+			auto left = op(op(r::kahan_monoid<double>::unit(), 1.0), 1e-16);
+			auto right = op(r::kahan_monoid<double>::unit(), 1e-16);
+
+			Assert::AreEqual(1.0 + 2e-16, op(left, right).value(), 1e-31);
+		}
+
+		TEST_METHOD(Pairwise_Sum_Monoid_Bounds_Rounding_Errors)
+		{
+			using r::reduce;
+			using r::fold;
+			r::thread_pool pool(4);
+
+			std::vector<double> data(1000001, 1e-16);
+			data[0] = 1.0;
+			double const expected = 1.0 + 1e-10;
+
+			Assert::AreEqual(expected, reduce<r::pairwise_sum_monoid<double>>(data), 1e-13);
+			Assert::AreEqual(expected, data | fold<r::pairwise_sum_monoid<double>>(pool), 1e-13);
+
+			std::vector<float> tenths(1 << 20, 0.1f);
+			float const expectedTenths = static_cast<float>((1 << 20) * static_cast<double>(0.1f));
+
+			Assert::AreEqual(expectedTenths, reduce<r::pairwise_sum_monoid<float>>(tenths), 0.05f);
+			Assert::IsTrue(std::abs(std::accumulate(tenths.begin(), tenths.end(), 0.0f) - expectedTenths) > 1.0f);
+		}
 	};
 }
\ No newline at end of file
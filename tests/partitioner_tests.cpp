@@ -0,0 +1,239 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/foldables/range_foldable.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/partitioners.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace
+	{
+		long long expensive(long long n)
+		{
+			long long result = n;
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				result = (result * 31 + i) % 1000003;
+			}
+
+			return result;
+		}
+
+		// reduces the indices [0, size) on the given executor, and returns the sizes of the leaves in ascending order.
+		template<typename Executor>
+		std::vector<std::size_t> record_leaves(std::size_t size, Executor&& executor)
+		{
+			std::mutex mutex;
+			std::vector<std::size_t> leaves;
+
+			auto leaf = [&](std::size_t first, std::size_t last, long long seed)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				leaves.push_back(last - first);
+				return seed + static_cast<long long>(last - first);
+			};
+
+			auto total = detail::parallel_reduce_index(0, size, 0LL, leaf, std::plus<long long>(), executor);
+
+			Assert::AreEqual(static_cast<long long>(size), total);
+			std::sort(leaves.begin(), leaves.end());
+			return leaves;
+		}
+
+		// adds partial sums, and counts the combinations.
+		struct counting_combine
+		{
+			std::atomic<int>* count;
+
+			explicit counting_combine(std::atomic<int>& count)
+				: count(&count)
+			{}
+
+			long long operator()() const
+			{
+				return 0;
+			}
+
+			long long operator()(long long left, long long right) const
+			{
+				++*count;
+				return left + right;
+			}
+		};
+	}
+
+	TEST_CLASS(PartitionerTests)
+	{
+		TEST_METHOD(Partitioners_Compute_Grain_Sizes)
+		{
+			Assert::AreEqual(std::size_t(16), fixed_partitioner(16).grain_size(1000, 4));
+			Assert::AreEqual(std::size_t(1), fixed_partitioner(0).grain_size(1000, 4));
+			Assert::AreEqual(std::size_t(1000 / 32), auto_partitioner().grain_size(1000, 4));
+			Assert::AreEqual(std::size_t(1), auto_partitioner().grain_size(10, 4));
+			Assert::AreEqual(std::size_t(100000 / 256), lazy_partitioner().grain_size(100000, 4));
+			Assert::AreEqual(std::size_t(7), lazy_partitioner(7).grain_size(100000, 4));
+		}
+
+		TEST_METHOD(Partitioned_Executor_Models_Executor_Concept)
+		{
+			thread_pool pool(2);
+			auto executor = with_partitioner(pool, lazy_partitioner());
+
+			Assert::IsTrue(detail::is_executor<decltype(executor)>::value);
+			Assert::AreEqual(std::size_t(2), executor.concurrency());
+		}
+
+		TEST_METHOD(Fixed_Partitioner_Splits_Down_To_Its_Grain)
+		{
+			thread_pool pool(4);
+
+			auto fine = record_leaves(10000, with_partitioner(pool, fixed_partitioner(100)));
+			auto coarse = record_leaves(10000, with_partitioner(pool, fixed_partitioner(10000)));
+
+			Assert::AreEqual(std::size_t(128), fine.size());
+			Assert::IsTrue(fine.back() <= 100);
+			Assert::AreEqual(std::size_t(10000), std::accumulate(fine.begin(), fine.end(), std::size_t(0)));
+			Assert::AreEqual(std::size_t(1), coarse.size());
+		}
+
+		TEST_METHOD(Auto_Partitioner_Is_The_Default)
+		{
+			thread_pool pool(4);
+
+			auto attached = record_leaves(10000, with_partitioner(pool, auto_partitioner()));
+			auto unattached = record_leaves(10000, pool);
+
+			// the grain is 10000 / 32 = 312, so the 16 pieces of 625 elements are split into 312 and 313, and the latter once more.
+			Assert::AreEqual(std::size_t(48), attached.size());
+			Assert::IsTrue(attached == unattached);
+		}
+
+		TEST_METHOD(Lazy_Partitioner_Reduces_In_Chunks)
+		{
+			thread_pool pool(4);
+
+			auto leaves = record_leaves(1000, with_partitioner(pool, lazy_partitioner(7)));
+
+			Assert::IsTrue(leaves.size() >= 1000 / 7);
+			Assert::AreEqual(std::size_t(7), leaves.back());
+			Assert::AreEqual(std::size_t(1000), std::accumulate(leaves.begin(), leaves.end(), std::size_t(0)));
+		}
+
+		TEST_METHOD(Fold_Splits_With_Attached_Partitioner)
+		{
+			thread_pool pool(4);
+			std::vector<long long> data(100000);
+			std::iota(data.begin(), data.end(), 0LL);
+			std::atomic<int> combinations(0);
+
+			auto result = fold(data, std::plus<long long>(), counting_combine(combinations), with_partitioner(pool, fixed_partitioner(100)));
+
+			// 100000 elements are split in halves 10 times, into 1024 leaves of at most 100 elements.
+			Assert::AreEqual(99999LL * 100000LL / 2, result);
+			Assert::AreEqual(1023, combinations.load());
+		}
+
+		TEST_METHOD(Fold_Skewed_Pipeline_With_Lazy_Partitioner)
+		{
+			thread_pool pool(4);
+			std::vector<long long> data(20000);
+			std::iota(data.begin(), data.end(), 0LL);
+
+			// only the last tenth of the input is expensive to process.
+			auto pipeline = [](std::vector<long long> const& d) {
+				return d
+					| filter([](long long n) { return n >= 18000; })
+					| map([](long long n) { return expensive(n); });
+			};
+
+			long long expected = 0;
+
+			for (long long n = 18000; n < 20000; ++n)
+			{
+				expected += expensive(n);
+			}
+
+			Assert::AreEqual(expected, pipeline(data) | fold<additive_monoid<long long>>(with_partitioner(pool, lazy_partitioner())));
+			Assert::AreEqual(expected, pipeline(data) | fold<additive_monoid<long long>>(with_partitioner(pool, fixed_partitioner(64))));
+		}
+
+		TEST_METHOD(Fold_List_Splits_With_Attached_Partitioner)
+		{
+			thread_pool pool(3);
+			std::vector<long long> data(10000);
+			std::iota(data.begin(), data.end(), 0LL);
+			std::list<long long> list(data.begin(), data.end());
+			std::atomic<int> combinations(0);
+
+			auto result = fold(list, std::plus<long long>(), counting_combine(combinations), with_partitioner(pool, fixed_partitioner(10)));
+
+			// the list is cut into 1000 chunks of 10 elements, each of which is a leaf.
+			Assert::AreEqual(9999LL * 10000LL / 2, result);
+			Assert::AreEqual(999, combinations.load());
+		}
+
+		TEST_METHOD(Partitioned_Inline_Executor_Reduces_Sequentially)
+		{
+			auto leaves = record_leaves(1000, with_partitioner(inline_executor(), lazy_partitioner(7)));
+
+			Assert::AreEqual(std::size_t(1), leaves.size());
+			Assert::AreEqual(std::size_t(1000), leaves.front());
+		}
+
+		TEST_METHOD(Deterministic_Partitioner_Grain_Size_Is_Fixed)
+		{
+			Assert::AreEqual(std::size_t(1024), deterministic_partitioner().grain_size(100000, 4));
+			Assert::AreEqual(std::size_t(1024), deterministic_partitioner().grain_size(100000, 64));
+			Assert::AreEqual(std::size_t(1), deterministic_partitioner(0).grain_size(100000, 4));
+		}
+
+		TEST_METHOD(Deterministic_Fold_Does_Not_Depend_On_Concurrency)
+		{
+			// values of very different magnitudes, so that the result depends on the order of the additions.
+			std::vector<double> data{ 1e16, 1.0, -0.5, 3.0, -1e16, 0.25, 1e8, -2.0, 0.125, 1e16, -1.0, 7.0, -3e15, 0.5, 2.0, -1e8 };
+
+			auto reference = data | fold<additive_monoid<double>>(with_partitioner(inline_executor(), deterministic_partitioner(1)));
+
+			for (std::size_t concurrency = 1; concurrency <= 5; ++concurrency)
+			{
+				thread_pool pool(concurrency);
+
+				for (int run = 0; run < 3; ++run)
+				{
+					auto result = data | fold<additive_monoid<double>>(with_partitioner(pool, deterministic_partitioner(1)));
+					Assert::IsTrue(reference == result);
+				}
+			}
+		}
+
+		TEST_METHOD(Deterministic_Fold_Of_List_Does_Not_Depend_On_Concurrency)
+		{
+			std::list<double> list{ 1e16, 1.0, -0.5, 3.0, -1e16, 0.25, 1e8, -2.0, 0.125, 1e16, -1.0, 7.0, -3e15, 0.5, 2.0, -1e8 };
+
+			auto reference = list | fold<additive_monoid<double>>(with_partitioner(inline_executor(), deterministic_partitioner(2)));
+
+			thread_pool pool(3);
+			auto result = list | fold<additive_monoid<double>>(with_partitioner(pool, deterministic_partitioner(2)));
+
+			Assert::IsTrue(reference == result);
+		}
+	};
+}
\ No newline at end of file
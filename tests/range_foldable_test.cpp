@@ -6,6 +6,8 @@
 #include <wenda/reducers/monoid/monoid_fold.h>
 
 #include <vector>
+#include <list>
+#include <numeric>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 namespace r = WENDA_REDUCERS_NAMESPACE;
@@ -31,5 +33,33 @@ namespace tests
 
 			Assert::AreEqual(1 + 2 + 3 + 4 + 5, result);
 		}
+
+		TEST_METHOD(CanFoldEmptyVector)
+		{
+			std::vector<int> data;
+
+			auto result = data | r::fold<r::additive_monoid<int>>();
+
+			Assert::AreEqual(0, result);
+		}
+
+		TEST_METHOD(CanFoldLargeVector)
+		{
+			std::vector<long long> data(100000);
+			std::iota(data.begin(), data.end(), 1);
+
+			auto result = data | r::fold<r::additive_monoid<long long>>();
+
+			Assert::AreEqual(100000LL * 100001LL / 2, result);
+		}
+
+		TEST_METHOD(CanFoldList)
+		{
+			std::list<int> data(1000, 2);
+
+			auto result = data | r::fold<r::additive_monoid<int>>();
+
+			Assert::AreEqual(2000, result);
+		}
 	};
 }
\ No newline at end of file
@@ -2,8 +2,21 @@
 #include <CppUnitTest.h>
 
 #include <wenda/reducers/reduce.h>
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/into.h>
 #include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/reducibles/sequence_reducible.h>
+#include <wenda/reducers/foldables/range_foldable.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/take.h>
+#include <wenda/reducers/transformers/take_while.h>
+#include <wenda/reducers/executors/thread_pool.h>
 
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <string>
 #include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -11,6 +24,88 @@ using namespace WENDA_REDUCERS_NAMESPACE;
 
 namespace tests
 {
+	namespace
+	{
+		/**
+        * A seed that counts how many times it was copied or moved.
+		*/
+		struct counted_seed
+		{
+			std::vector<int> values;
+			int transfers;
+
+			counted_seed()
+				: transfers(0)
+			{}
+
+			counted_seed(counted_seed const& other)
+				: values(other.values), transfers(other.transfers + 1)
+			{}
+
+			counted_seed(counted_seed&& other)
+				: values(std::move(other.values)), transfers(other.transfers + 1)
+			{}
+
+			counted_seed& operator=(counted_seed const& other)
+			{
+				values = other.values;
+				transfers = other.transfers + 1;
+				return *this;
+			}
+
+			counted_seed& operator=(counted_seed&& other)
+			{
+				values = std::move(other.values);
+				transfers = other.transfers + 1;
+				return *this;
+			}
+		};
+
+		struct append_in_place
+		{
+			void operator()(counted_seed& seed, int value) const
+			{
+				seed.values.push_back(value);
+			}
+		};
+
+		struct concatenate_combine
+		{
+			std::vector<int> operator()() const
+			{
+				return std::vector<int>();
+			}
+
+			std::vector<int> operator()(std::vector<int> left, std::vector<int> const& right) const
+			{
+				left.insert(left.end(), right.begin(), right.end());
+				return left;
+			}
+		};
+	}
+
+	namespace value_reducibles
+	{
+		/**
+        * A reducible of the first integers that accumulates by value, passing the seed to the function and assigning it the result.
+		*/
+		struct counter
+		{
+			int count;
+		};
+
+		template<typename Function, typename Seed>
+		Seed reduce(counter const& reducible, Function&& function, Seed seed)
+		{
+			for (int n = 0; n < reducible.count && !detail::is_reduced(seed); ++n)
+			{
+				seed = function(std::move(seed), n);
+			}
+
+			return seed;
+		}
+	}
+
 	TEST_CLASS(Reduce_Tests)
 	{
 		TEST_METHOD(Can_Reduce_With_Pipe_Expression)
@@ -31,5 +126,108 @@ namespace tests
 			auto value = detail::has_reducible_member_function<std::vector<int>, std::plus<int>, int>::value;
 			Assert::IsFalse(value);
 		}
+
+		TEST_METHOD(Is_In_Place_Reducer_Detects_Void_Functions_Taking_Seed_By_Reference)
+		{
+			Assert::IsTrue(detail::is_in_place_reducer<append_in_place const, counted_seed, int>::value);
+			Assert::IsFalse(detail::is_in_place_reducer<std::plus<int> const, int, int>::value);
+		}
+
+		TEST_METHOD(Reduce_With_In_Place_Reducer_Does_Not_Transfer_Seed_Per_Element)
+		{
+			std::vector<int> small(10), large(1000);
+			std::iota(small.begin(), small.end(), 0);
+			std::iota(large.begin(), large.end(), 0);
+			std::list<int> smallList(small.begin(), small.end()), largeList(large.begin(), large.end());
+
+			auto contiguous = large | reduce(append_in_place(), counted_seed());
+			auto sequential = largeList | reduce(append_in_place(), counted_seed());
+			auto sequence = make_sequence_reducible(0, 1000, 1) | reduce(append_in_place(), counted_seed());
+
+			Assert::IsTrue(large == contiguous.values);
+			Assert::IsTrue(large == sequential.values);
+			Assert::IsTrue(large == sequence.values);
+
+			// the seed is only moved along the calls into the reducible, whatever the number of elements.
+			Assert::AreEqual((small | reduce(append_in_place(), counted_seed())).transfers, contiguous.transfers);
+			Assert::AreEqual((smallList | reduce(append_in_place(), counted_seed())).transfers, sequential.transfers);
+			Assert::AreEqual((make_sequence_reducible(0, 10, 1) | reduce(append_in_place(), counted_seed())).transfers, sequence.transfers);
+		}
+
+		TEST_METHOD(Reduce_With_In_Place_Reducer_Through_Transformers)
+		{
+			std::vector<int> data(1000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto pipeline = [&](std::size_t count)
+			{
+				return data
+					| map([](int n) { return n * 2; })
+					| filter([](int n) { return n % 3 == 0; })
+					| drop_while([](int n) { return n < 30; })
+					| take_while([](int n) { return n < 900; })
+					| take(count)
+					| reduce(append_in_place(), counted_seed());
+			};
+
+			auto result = pipeline(50);
+
+			std::vector<int> expected;
+			for (int n = 30; expected.size() < 50; n += 6)
+			{
+				expected.push_back(n);
+			}
+
+			Assert::IsTrue(expected == result.values);
+			Assert::AreEqual(pipeline(100).transfers, result.transfers);
+		}
+
+		TEST_METHOD(Fold_With_In_Place_Reducer_On_Thread_Pool)
+		{
+			thread_pool pool(4);
+			std::vector<int> data(100000);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto result = data | fold([](std::vector<int>& acc, int n) { acc.push_back(n); }, concatenate_combine(), pool);
+
+			Assert::IsTrue(data == result);
+		}
+
+		TEST_METHOD(In_Place_Reducers_Accept_Reducibles_That_Accumulate_By_Value)
+		{
+			value_reducibles::counter source = { 100 };
+			std::vector<int> data(100);
+			std::iota(data.begin(), data.end(), 0);
+
+			auto pipeline = [](value_reducibles::counter const& r)
+			{
+				return r
+					| map([](int n) { return n * 2; })
+					| filter([](int n) { return n % 3 == 0; })
+					| drop(2)
+					| take_while([](int n) { return n < 150; })
+					| take(10)
+					| reduce(append_in_place(), counted_seed());
+			};
+
+			std::vector<int> expected{ 12, 18, 24, 30, 36, 42, 48, 54, 60, 66 };
+			std::vector<int> written;
+			source | filter([](int n) { return n % 2 == 0; }) | into(std::back_inserter(written));
+
+			Assert::IsTrue(expected == pipeline(source).values);
+			Assert::AreEqual(50, static_cast<int>(written.size()));
+			Assert::IsTrue(data == into_container<std::vector<int>>(source));
+		}
+
+		TEST_METHOD(Into_Advances_Iterator_In_Place)
+		{
+			std::vector<int> data{ 1, 2, 3, 4 };
+			std::string result;
+
+			auto end = data | map([](int n) { return static_cast<char>('0' + n); }) | into(std::back_inserter(result));
+			*end = '5';
+
+			Assert::AreEqual(std::string("12345"), result);
+		}
 	};
-}
\ No newline at end of file
+}
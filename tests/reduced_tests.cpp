@@ -0,0 +1,302 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/reduced.h>
+#include <wenda/reducers/reduce.h>
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/reducibles/iterator_pair_reducible.h>
+#include <wenda/reducers/reducibles/sequence_reducible.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/collect.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/partitioners.h>
+
+#include <atomic>
+#include <list>
+#include <numeric>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace
+	{
+		/**
+        * Reducing function that finds the first element equal to the target.
+		*/
+		struct find_value
+		{
+			long long target;
+
+			reduced<long long> operator()(reduced<long long> acc, long long n) const
+			{
+				return n == target ? make_reduced(n) : acc;
+			}
+		};
+
+		/**
+        * Combination function for searches, which keeps the first value found.
+		*/
+		struct first_found_combine
+		{
+			reduced<long long> operator()() const
+			{
+				return reduced<long long>(-1);
+			}
+
+			reduced<long long> operator()(reduced<long long> left, reduced<long long> right) const
+			{
+				return left.get() >= 0 ? left : right;
+			}
+		};
+
+		/**
+        * Combination function for sums that may have been terminated.
+		*/
+		struct sum_combine
+		{
+			reduced<long long> operator()() const
+			{
+				return reduced<long long>(0);
+			}
+
+			reduced<long long> operator()(reduced<long long> left, reduced<long long> right) const
+			{
+				return reduced<long long>(left.get() + right.get());
+			}
+		};
+
+		/**
+        * A splittable interval of integers.
+		*/
+		struct interval
+		{
+			long long low;
+			long long high;
+
+			std::size_t size() const
+			{
+				return static_cast<std::size_t>(high - low);
+			}
+
+			std::pair<interval, interval> split() const
+			{
+				long long middle = low + (high - low) / 2;
+				interval left = { low, middle };
+				interval right = { middle, high };
+				return std::make_pair(left, right);
+			}
+
+			template<typename Function, typename Seed>
+			Seed reduce(Function&& function, Seed seed) const
+			{
+				return make_sequence_reducible(low, high, 1LL).reduce(function, std::move(seed));
+			}
+		};
+
+		/**
+        * A splittable interval of integers whose halves are estimated to be nearly as large as the whole,
+        * so that the estimated sizes of its pieces do not add up.
+		*/
+		struct overestimated_interval
+		{
+			long long low;
+			long long high;
+			std::size_t estimate;
+
+			std::size_t size() const
+			{
+				return high - low <= 1 ? static_cast<std::size_t>(high - low) : estimate;
+			}
+
+			std::pair<overestimated_interval, overestimated_interval> split() const
+			{
+				long long middle = low + (high - low) / 2;
+				overestimated_interval left = { low, middle, estimate - 1 };
+				overestimated_interval right = { middle, high, estimate - 1 };
+				return std::make_pair(left, right);
+			}
+
+			template<typename Function, typename Seed>
+			Seed reduce(Function&& function, Seed seed) const
+			{
+				return make_sequence_reducible(low, high, 1LL).reduce(function, std::move(seed));
+			}
+		};
+
+		/**
+        * An executor that runs the right operand of invoke() before the left one.
+		*/
+		struct right_first_executor
+		{
+			std::size_t concurrency() const { return 2; }
+
+			template<typename Function>
+			void run(Function&& function) const
+			{
+				function();
+			}
+
+			template<typename Left, typename Right>
+			void invoke(Left&& left, Right&& right) const
+			{
+				right();
+				left();
+			}
+		};
+	}
+
+	TEST_CLASS(ReducedTests)
+	{
+		TEST_METHOD(Reduce_Range_Stops_Early)
+		{
+			std::vector<long long> data(1000);
+			std::iota(data.begin(), data.end(), 0LL);
+			int visited = 0;
+
+			auto result =
+				data
+				| map([&](long long n) { ++visited; return n; })
+				| reduce(find_value{ 10 }, reduced<long long>(-1));
+
+			Assert::IsTrue(result.is_reduced());
+			Assert::AreEqual(10LL, unreduced(result));
+			Assert::AreEqual(11, visited);
+		}
+
+		TEST_METHOD(Reduce_Iterator_Pair_And_Sequence_Stop_Early)
+		{
+			std::list<long long> data{ 1, 2, 3, 4, 5 };
+			int visited = 0;
+
+			auto pairResult =
+				make_iterator_pair_reducible(data.begin(), data.end())
+				| map([&](long long n) { ++visited; return n; })
+				| reduce(find_value{ 2 }, reduced<long long>(-1));
+
+			auto sequenceResult = make_sequence_reducible(0LL, 1000000000LL, 1LL) | reduce(find_value{ 42 }, reduced<long long>(-1));
+
+			Assert::AreEqual(2LL, unreduced(pairResult));
+			Assert::AreEqual(2, visited);
+			Assert::AreEqual(42LL, unreduced(sequenceResult));
+		}
+
+		TEST_METHOD(Reduce_Not_Found_Is_Not_Reduced)
+		{
+			std::vector<long long> data{ 1, 2, 3 };
+
+			auto result = data | reduce(find_value{ 7 }, reduced<long long>(-1));
+
+			Assert::IsFalse(result.is_reduced());
+			Assert::AreEqual(-1LL, unreduced(result));
+		}
+
+		TEST_METHOD(Reduce_Filter_And_Collect_Stop_Early)
+		{
+			std::vector<std::vector<long long>> data{ { 1, 2 }, { 3, 4 }, { 5, 6 } };
+			int expanded = 0;
+
+			auto result =
+				data
+				| collect([&](std::vector<long long> const& v) { ++expanded; return v; })
+				| filter([](long long n) { return n % 2 == 1; })
+				| reduce(find_value{ 3 }, reduced<long long>(-1));
+
+			Assert::AreEqual(3LL, unreduced(result));
+			Assert::AreEqual(2, expanded);
+		}
+
+		TEST_METHOD(Fold_Finds_First_Match)
+		{
+			thread_pool pool(4);
+			std::vector<long long> data(1000000, 0);
+			data[123457] = 1;
+			data[900000] = 1;
+
+			auto findAny = [](reduced<long long>, long long i) { return make_reduced(i); };
+
+			for (int run = 0; run < 5; ++run)
+			{
+				auto result =
+					make_sequence_reducible(0LL, static_cast<long long>(data.size()), 1LL)
+					| filter([&](long long i) { return data[static_cast<std::size_t>(i)] == 1; })
+					| fold(findAny, first_found_combine(), pool);
+
+				Assert::IsTrue(result.is_reduced());
+				Assert::AreEqual(123457LL, unreduced(result));
+			}
+		}
+
+		TEST_METHOD(Fold_Stops_Early)
+		{
+			thread_pool pool(4);
+			std::vector<long long> data(10000000);
+			std::iota(data.begin(), data.end(), 0LL);
+			std::atomic<long long> visited(0);
+
+			auto result =
+				data
+				| map([&](long long n) { visited.fetch_add(1, std::memory_order_relaxed); return n; })
+				| fold(find_value{ 1000 }, first_found_combine(), pool);
+
+			Assert::AreEqual(1000LL, unreduced(result));
+			Assert::IsTrue(visited.load() < static_cast<long long>(data.size()) / 2);
+		}
+
+		TEST_METHOD(Fold_With_Partitioners_Finds_First_Match)
+		{
+			thread_pool pool(3);
+			std::vector<long long> data(200000);
+			std::iota(data.begin(), data.end(), 0LL);
+			std::list<long long> list(data.begin(), data.end());
+
+			auto lazy = data | fold(find_value{ 150000 }, first_found_combine(), with_partitioner(pool, lazy_partitioner()));
+			auto fixed = data | fold(find_value{ 5 }, first_found_combine(), with_partitioner(pool, fixed_partitioner(100)));
+			auto deterministic = data | fold(find_value{ 77777 }, first_found_combine(), with_partitioner(inline_executor(), deterministic_partitioner(64)));
+			auto fromList = list | fold(find_value{ 199999 }, first_found_combine(), pool);
+			auto missing = data | fold(find_value{ -5 }, first_found_combine(), pool);
+
+			Assert::AreEqual(150000LL, unreduced(lazy));
+			Assert::AreEqual(5LL, unreduced(fixed));
+			Assert::AreEqual(77777LL, unreduced(deterministic));
+			Assert::AreEqual(199999LL, unreduced(fromList));
+			Assert::IsFalse(missing.is_reduced());
+		}
+
+		TEST_METHOD(Fold_Splittable_And_Collect_Find_First_Match)
+		{
+			thread_pool pool(4);
+			interval i = { 0, 1000000 };
+			std::vector<long long> shards{ 0, 1, 2, 3 };
+
+			auto fromSplittable = i | fold(find_value{ 654321 }, first_found_combine(), pool);
+			auto fromLazySplittable = i | fold(find_value{ 654321 }, first_found_combine(), with_partitioner(pool, lazy_partitioner(64)));
+			auto fromCollect =
+				shards
+				| collect([](long long shard) { return make_sequence_reducible(shard * 100000, (shard + 1) * 100000, 1LL); })
+				| fold(find_value{ 250000 }, first_found_combine(), pool);
+
+			Assert::AreEqual(654321LL, unreduced(fromSplittable));
+			Assert::AreEqual(654321LL, unreduced(fromLazySplittable));
+			Assert::AreEqual(250000LL, unreduced(fromCollect));
+			Assert::IsTrue(fromCollect.is_reduced());
+		}
+
+		TEST_METHOD(Fold_Splittable_With_Inexact_Sizes_Keeps_Pieces_Before_The_Stop)
+		{
+			overestimated_interval i = { 0, 16, 100 };
+
+			auto sumUpTo = [](reduced<long long> acc, long long n) { return reduced<long long>(acc.get() + n, n == 8); };
+
+			auto result = i | fold(sumUpTo, sum_combine(), with_partitioner(right_first_executor(), fixed_partitioner(1)));
+
+			Assert::IsTrue(result.is_reduced());
+			Assert::AreEqual(36LL, unreduced(result));
+		}
+	};
+}
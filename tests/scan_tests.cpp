@@ -0,0 +1,128 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/transformers/scan.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/take.h>
+#include <wenda/reducers/fold_into.h>
+#include <wenda/reducers/into.h>
+#include <wenda/reducers/monoid/monoid.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/reducibles/sequence_reducible.h>
+#include <wenda/reducers/foldables/range_foldable.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/partitioners.h>
+
+#include <cstring>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	TEST_CLASS(ScanTests)
+	{
+		TEST_METHOD(Scan_Reduces_Running_Aggregates)
+		{
+			std::vector<int> data{ 1, 2, 3, 4 };
+
+			auto sums = data | scan(std::plus<int>(), 0) | into_container<std::vector<int>>();
+			auto offsets = scan(data, std::plus<int>(), 10) | into_container<std::vector<int>>();
+
+			Assert::IsTrue(std::vector<int>{ 1, 3, 6, 10 } == sums);
+			Assert::IsTrue(std::vector<int>{ 11, 13, 16, 20 } == offsets);
+		}
+
+		TEST_METHOD(Scan_Of_Monoid_Starts_From_Unit)
+		{
+			std::list<int> data{ 5, 1, 4 };
+
+			auto piped = data | scan<additive_monoid<long long>>() | into_container<std::vector<long long>>();
+			auto called = scan<additive_monoid<long long>>(data) | into_container<std::vector<long long>>();
+
+			Assert::IsTrue(std::vector<long long>{ 5, 6, 10 } == piped);
+			Assert::IsTrue(piped == called);
+		}
+
+		TEST_METHOD(Scan_Stops_With_Downstream_Reduction)
+		{
+			std::list<int> data{ 1, 2, 3, 4, 5, 6 };
+			int visited = 0;
+
+			auto counted = data | map([&visited](int n) { ++visited; return n; });
+			auto result = counted | scan(std::plus<int>(), 0) | take(3) | into_container<std::vector<int>>();
+
+			Assert::IsTrue(std::vector<int>{ 1, 3, 6 } == result);
+			Assert::AreEqual(3, visited);
+			Assert::IsTrue(get_size_hint(data | scan(std::plus<int>(), 0)).is_exact());
+		}
+
+		TEST_METHOD(Fold_Of_Scan_Matches_Sequential_Scan_By_Index)
+		{
+			thread_pool pool(4);
+			std::vector<int> data(100000);
+			std::iota(data.begin(), data.end(), -50000);
+
+			auto scanned = data | map([](int n) { return n * 3LL; }) | scan<additive_monoid<long long>>();
+			auto expected = scanned | into_container<std::vector<long long>>();
+
+			Assert::IsTrue(expected == (scanned | fold_into<std::vector<long long>>(pool)));
+			Assert::IsTrue(expected == (scanned | fold_into<std::vector<long long>>(with_partitioner(pool, lazy_partitioner()))));
+			Assert::IsTrue(expected == (scanned | fold_into<std::vector<long long>>(inline_executor())));
+
+			long long total = fold<additive_monoid<long long>>(scanned, pool);
+			Assert::AreEqual(std::accumulate(expected.begin(), expected.end(), 0LL), total);
+		}
+
+		TEST_METHOD(Deterministic_Fold_Of_Scan_Does_Not_Depend_On_The_Executor)
+		{
+			std::vector<double> data(50000);
+			for (std::size_t i = 0; i < data.size(); ++i)
+			{
+				data[i] = (i % 7 == 0 ? 1e8 : 1.0) / static_cast<double>(i % 13 + 1);
+			}
+
+			auto scanned = data | scan<additive_monoid<double>>();
+			double sequential = fold<additive_monoid<double>>(scanned, with_partitioner(inline_executor(), deterministic_partitioner(1000)));
+
+			for (std::size_t threads = 1; threads <= 8; threads *= 2)
+			{
+				thread_pool pool(threads);
+				double parallel = fold<additive_monoid<double>>(scanned, with_partitioner(pool, deterministic_partitioner(1000)));
+				Assert::IsTrue(std::memcmp(&sequential, &parallel, sizeof(double)) == 0);
+			}
+		}
+
+		TEST_METHOD(Fold_Of_Scan_Keeps_Order_On_Buffered_Sources)
+		{
+			thread_pool pool(4);
+			std::vector<int> data(6000);
+			std::iota(data.begin(), data.end(), 0);
+			auto letter = [](int n) { return std::string(1, static_cast<char>('a' + n % 26)); };
+
+			auto scanned = data | filter([](int n) { return n % 3 != 0; }) | map(letter) | scan(std::plus<std::string>(), std::string(">"));
+			auto expected = scanned | into_container<std::vector<std::string>>();
+
+			Assert::AreEqual(std::size_t(4000), expected.size());
+			Assert::IsTrue(expected == (scanned | fold_into<std::vector<std::string>>(pool)));
+			Assert::IsTrue(expected == (scanned | fold_into<std::vector<std::string>>(with_partitioner(pool, deterministic_partitioner(64)))));
+		}
+
+		TEST_METHOD(Fold_Of_Scan_Handles_Empty_And_Short_Sources)
+		{
+			thread_pool pool(4);
+			std::vector<int> empty;
+
+			Assert::IsTrue((empty | scan(std::plus<int>(), 7) | fold_into<std::vector<int>>(pool)).empty());
+			Assert::IsTrue(std::vector<int>{ 8, 10, 13 } == (make_sequence_reducible(1, 4, 1) | scan(std::plus<int>(), 7) | fold_into<std::vector<int>>(pool)));
+		}
+	};
+}
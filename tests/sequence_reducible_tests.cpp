@@ -3,6 +3,15 @@
 
 #include <wenda/reducers/reducibles/sequence_reducible.h>
 #include <wenda/reducers/reduce.h>
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/monoid/monoid_reduce.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+
+#include <limits>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace WENDA_REDUCERS_NAMESPACE;
@@ -28,5 +37,126 @@ namespace tests
 
 			Assert::AreEqual(1 + 3 + 5 + 7 + 9, result);
 		}
+
+		TEST_METHOD(sequence_reducible_size_is_correct)
+		{
+			Assert::AreEqual(std::size_t(6), make_sequence_reducible(1, 7, 1).size());
+			Assert::AreEqual(std::size_t(5), make_sequence_reducible(1, 10, 2).size());
+			Assert::AreEqual(std::size_t(5), make_sequence_reducible(1, 11, 2).size());
+			Assert::AreEqual(std::size_t(0), make_sequence_reducible(5, 5, 1).size());
+			Assert::AreEqual(std::size_t(0), make_sequence_reducible(7, 1, 1).size());
+			Assert::AreEqual(std::size_t(20), make_sequence_reducible(-10, 10, 1).size());
+		}
+
+		TEST_METHOD(sequence_reducible_fold_is_correct)
+		{
+			auto result =
+				make_sequence_reducible(1, 10, 2)
+				| fold<additive_monoid<int>>();
+
+			Assert::AreEqual(1 + 3 + 5 + 7 + 9, result);
+		}
+
+		TEST_METHOD(sequence_reducible_fold_on_thread_pool_is_correct)
+		{
+			thread_pool pool(4);
+
+			auto result =
+				make_sequence_reducible(0LL, 1000000LL, 3LL)
+				| map([](long long n) { return n % 11; })
+				| fold<additive_monoid<long long>>(pool);
+
+			long long expected = 0;
+
+			for (long long n = 0; n < 1000000; n += 3)
+			{
+				expected += n % 11;
+			}
+
+			Assert::AreEqual(expected, result);
+		}
+
+		TEST_METHOD(sequence_reducible_fold_with_negative_start_is_correct)
+		{
+			auto result =
+				make_sequence_reducible(-1000, 1001, 1)
+				| filter([](int n) { return n > 0; })
+				| fold<additive_monoid<int>>(inline_executor());
+
+			Assert::AreEqual(1000 * 1001 / 2, result);
+		}
+
+		TEST_METHOD(sequence_reducible_fold_of_empty_sequence_is_identity)
+		{
+			thread_pool pool(2);
+
+			auto result = make_sequence_reducible(10, 0, 1) | fold<additive_monoid<int>>(pool);
+
+			Assert::AreEqual(0, result);
+		}
+
+		TEST_METHOD(sequence_reducible_sums_in_closed_form)
+		{
+			int const starts[] = { -1000, -7, 0, 3 };
+			int const steps[] = { 1, 2, 7, 300 };
+
+			for (auto start : starts)
+			{
+				for (auto step : steps)
+				{
+					int expected = 5;
+					for (int n = start; n < 1000; n += step)
+					{
+						expected += n;
+					}
+
+					Assert::AreEqual(expected, make_sequence_reducible(start, 1000, step) | reduce(std::plus<int>(), 5));
+				}
+			}
+
+			// the closed form does not depend on the number of elements.
+			long long count = 3000000000LL;
+			Assert::AreEqual(count * (count - 1) / 2, make_sequence_reducible(0LL, count, 1LL) | reduce<additive_monoid<long long>>());
+		}
+
+		TEST_METHOD(sequence_reducible_min_and_max_in_closed_form)
+		{
+			thread_pool pool(4);
+			auto sequence = make_sequence_reducible(-50, 1000, 7);
+
+			Assert::AreEqual(-50, sequence | reduce<min_monoid<int>>());
+			Assert::AreEqual(-50 + 149 * 7, sequence | reduce<max_monoid<int>>());
+			Assert::AreEqual(-50, sequence | fold<min_monoid<int>>(pool));
+			Assert::AreEqual(-50 + 149 * 7, sequence | fold<max_monoid<int>>(pool));
+			Assert::AreEqual((std::numeric_limits<int>::max)(), make_sequence_reducible(0, 0, 1) | reduce<min_monoid<int>>());
+		}
+
+		TEST_METHOD(sequence_reducible_fold_sums_in_closed_form)
+		{
+			thread_pool pool(4);
+
+			auto result = make_sequence_reducible(-100000, 1000000, 3) | fold<additive_monoid<long long>>(pool);
+			auto expected = make_sequence_reducible(-100000LL, 1000000LL, 3LL) | reduce([](long long seed, long long n) { return seed + n; }, 0LL);
+
+			Assert::AreEqual(expected, result);
+		}
+
+		TEST_METHOD(sequence_reducible_generates_blocks_for_transformed_elements)
+		{
+			thread_pool pool(4);
+			auto squares = make_sequence_reducible(-1000LL, 2001LL, 3LL) | map([](long long n) { return n * n; });
+
+			long long expectedSum = 0;
+			long long expectedXor = 0;
+			for (long long n = -1000; n < 2001; n += 3)
+			{
+				expectedSum += n * n;
+				expectedXor ^= n * n;
+			}
+
+			Assert::AreEqual(expectedSum, squares | reduce<additive_monoid<long long>>());
+			Assert::AreEqual(expectedSum, squares | fold<additive_monoid<long long>>(pool));
+			Assert::AreEqual(expectedXor, make_sequence_reducible(-1000LL, 2001LL, 3LL) | map([](long long n) { return n * n; }) | reduce<bitwise_xor_monoid<long long>>());
+		}
 	};
 }
\ No newline at end of file
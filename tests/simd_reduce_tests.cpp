@@ -0,0 +1,178 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/monoid/monoid.h>
+#include <wenda/reducers/monoid/monoid_reduce.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/fold_async.h>
+#include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/partitioners.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace
+	{
+		const std::size_t sizes[] = { 0, 1, 7, 31, 33, 64, 100, 1000, 100003 };
+
+		template<typename Monoid>
+		typename Monoid::element_t sequential(std::vector<typename Monoid::element_t> const& data)
+		{
+			typename Monoid::operation_t op;
+			auto result = Monoid::unit();
+
+			for (auto value : data)
+			{
+				result = op(result, value);
+			}
+
+			return result;
+		}
+
+		// folds the data along the tree of a deterministic partitioner, with the given scalar reduction of the leaves.
+		template<typename T, typename Seed, typename Leaf, typename Combine>
+		Seed deterministic_reference(std::vector<T> const& data, Seed identity, Leaf leaf, Combine combine, std::size_t grain)
+		{
+			auto executor = with_partitioner(inline_executor(), deterministic_partitioner(grain));
+			auto pieces = [&](std::size_t first, std::size_t last, Seed seed) { return leaf(data.data() + first, data.data() + last, seed); };
+			return detail::parallel_reduce_index(0, data.size(), identity, pieces, combine, executor);
+		}
+
+		template<typename Monoid>
+		void check_monoid(thread_pool& pool)
+		{
+			typedef typename Monoid::element_t element_t;
+
+			for (std::size_t size : sizes)
+			{
+				std::vector<element_t> data(size);
+
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					data[i] = static_cast<element_t>(static_cast<int>(i * 37 % 64) - 20);
+				}
+
+				auto const& constData = data;
+				auto expected = sequential<Monoid>(data);
+
+				Assert::IsTrue(expected == reduce<Monoid>(data));
+				Assert::IsTrue(expected == (constData | reduce<Monoid>()));
+				Assert::IsTrue(expected == fold<Monoid>(data, pool));
+				Assert::IsTrue(expected == (data | fold<Monoid>(with_partitioner(pool, lazy_partitioner()))));
+				Assert::IsTrue(expected == fold<Monoid>(data, with_partitioner(inline_executor(), deterministic_partitioner(256))));
+			}
+		}
+	}
+
+	TEST_CLASS(SimdReduceTests)
+	{
+		TEST_METHOD(Additive_Monoids_Match_Sequential_Reduction)
+		{
+			thread_pool pool(3);
+
+			check_monoid<additive_monoid<int>>(pool);
+			check_monoid<additive_monoid<unsigned int>>(pool);
+			check_monoid<additive_monoid<long long>>(pool);
+			check_monoid<additive_monoid<short>>(pool);
+			check_monoid<additive_monoid<unsigned char>>(pool);
+			check_monoid<additive_monoid<float>>(pool);
+			check_monoid<additive_monoid<double>>(pool);
+		}
+
+		TEST_METHOD(Min_Max_Monoids_Match_Sequential_Reduction)
+		{
+			thread_pool pool(3);
+
+			check_monoid<min_monoid<int>>(pool);
+			check_monoid<max_monoid<int>>(pool);
+			check_monoid<min_monoid<unsigned int>>(pool);
+			check_monoid<max_monoid<long long>>(pool);
+			check_monoid<min_monoid<float>>(pool);
+			check_monoid<max_monoid<float>>(pool);
+			check_monoid<min_monoid<double>>(pool);
+			check_monoid<max_monoid<double>>(pool);
+		}
+
+		TEST_METHOD(Bitwise_Monoids_Match_Sequential_Reduction)
+		{
+			thread_pool pool(3);
+
+			check_monoid<bitwise_and_monoid<int>>(pool);
+			check_monoid<bitwise_or_monoid<unsigned short>>(pool);
+			check_monoid<bitwise_xor_monoid<std::uint64_t>>(pool);
+			check_monoid<bitwise_xor_monoid<signed char>>(pool);
+		}
+
+		TEST_METHOD(Monoid_Units_Are_Identities)
+		{
+			Assert::AreEqual(2147483647, min_monoid<int>::unit());
+			Assert::IsTrue(max_monoid<double>::unit() < -1e308);
+			Assert::AreEqual(-1, bitwise_and_monoid<int>::unit());
+			Assert::AreEqual(0u, bitwise_or_monoid<unsigned>::unit());
+		}
+
+		TEST_METHOD(Contiguous_Ranges_Are_Reduced_With_Kernels)
+		{
+			int array[] = { 5, 3, 8, 1, 9, 2, 7, 4, 6, 10 };
+			std::array<float, 10> floats = { { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 } };
+			std::vector<long long> converted{ 1, 2, 3 };
+
+			Assert::AreEqual(55, reduce<additive_monoid<int>>(array));
+			Assert::AreEqual(1, reduce<min_monoid<int>>(array));
+			Assert::AreEqual(10.0f, floats | reduce<max_monoid<float>>());
+			Assert::AreEqual(55.0f, fold<additive_monoid<float>>(floats, inline_executor()));
+			// element types that differ from the monoid use the generic path.
+			Assert::AreEqual(6.0, reduce<additive_monoid<double>>(converted));
+		}
+
+		TEST_METHOD(Large_Float_Sum_Is_Exact_For_Integral_Values)
+		{
+			thread_pool pool(4);
+			std::vector<float> data(10000000, 1.0f);
+
+			Assert::AreEqual(10000000.0f, data | fold<additive_monoid<float>>(pool));
+			Assert::AreEqual(10000000.0f, reduce<additive_monoid<float>>(data));
+		}
+
+		TEST_METHOD(Deterministic_Folds_Match_The_Scalar_Kernels_Bit_For_Bit)
+		{
+			thread_pool pool(3);
+			std::vector<double> doubles(100003);
+
+			for (std::size_t i = 0; i < doubles.size(); ++i)
+			{
+				doubles[i] = (i % 3 == 0 ? 1e12 : 1.0) / (1 + i % 17) * (i % 2 == 0 ? 1 : -1);
+			}
+
+			std::vector<float> floats(doubles.begin(), doubles.end());
+			auto executor = with_partitioner(pool, deterministic_partitioner(1000));
+
+			auto sum = [](double const* first, double const* last, double seed) { return detail::reduce_unrolled(first, last, seed, std::plus<double>()); };
+			auto floatSum = [](float const* first, float const* last, float seed) { return detail::reduce_unrolled(first, last, seed, std::plus<float>()); };
+			auto compensated = [](double const* first, double const* last, kahan_sum<double> seed) { return detail::reduce_compensated_unrolled(first, last, seed); };
+
+			// the kernels of the processor would give other roundings, that depend on the number of lanes of its instruction set.
+			auto expected = deterministic_reference(doubles, 0.0, sum, std::plus<double>(), 1000);
+			auto expectedFloat = deterministic_reference(floats, 0.0f, floatSum, std::plus<float>(), 1000);
+			auto expectedKahan = deterministic_reference(doubles, kahan_sum<double>(), compensated, detail::kahan_operation<double>(), 1000);
+
+			Assert::IsTrue(expected == fold<additive_monoid<double>>(doubles, executor));
+			Assert::IsTrue(expected == (doubles | fold<additive_monoid<double>>(executor)));
+			Assert::IsTrue(expected == fold_async<additive_monoid<double>>(doubles, executor).get());
+			Assert::IsTrue(expectedFloat == fold<additive_monoid<float>>(floats, executor));
+
+			auto kahan = fold<kahan_monoid<double>>(doubles, executor);
+			Assert::IsTrue(expectedKahan.sum == kahan.sum);
+			Assert::IsTrue(expectedKahan.compensation == kahan.compensation);
+		}
+	};
+}
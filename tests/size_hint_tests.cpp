@@ -0,0 +1,86 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/size_hint.h>
+#include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/reducibles/iterator_pair_reducible.h>
+#include <wenda/reducers/reducibles/sequence_reducible.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/take.h>
+#include <wenda/reducers/transformers/take_while.h>
+#include <wenda/reducers/transformers/collect.h>
+
+#include <forward_list>
+#include <list>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace
+	{
+		bool has_hint(size_hint hint, size_hint::kind_t kind, std::size_t count)
+		{
+			return hint.kind == kind && hint.count == count;
+		}
+	}
+
+	TEST_CLASS(SizeHintTests)
+	{
+		TEST_METHOD(Size_Hint_Is_Exact_For_Ranges)
+		{
+			std::vector<int> data(10);
+			std::list<int> list(7);
+			int array[5] = {};
+
+			Assert::IsTrue(has_hint(get_size_hint(data), size_hint::exact, 10));
+			Assert::IsTrue(has_hint(get_size_hint(list), size_hint::exact, 7));
+			Assert::IsTrue(has_hint(get_size_hint(array), size_hint::exact, 5));
+			Assert::IsTrue(has_hint(get_size_hint(make_range_reducible(data)), size_hint::exact, 10));
+		}
+
+		TEST_METHOD(Size_Hint_Is_Unknown_For_Ranges_Without_Size)
+		{
+			std::forward_list<int> list(3);
+
+			Assert::IsTrue(has_hint(get_size_hint(list), size_hint::unknown, 0));
+			Assert::IsTrue(has_hint(get_size_hint(make_iterator_pair_reducible(list.begin(), list.end())), size_hint::unknown, 0));
+		}
+
+		TEST_METHOD(Size_Hint_Is_Exact_For_Sequences_And_Random_Access_Iterator_Pairs)
+		{
+			std::vector<int> data(12);
+
+			Assert::IsTrue(has_hint(get_size_hint(make_sequence_reducible(0, 10, 3)), size_hint::exact, 4));
+			Assert::IsTrue(has_hint(get_size_hint(make_iterator_pair_reducible(data.begin() + 2, data.end())), size_hint::exact, 10));
+		}
+
+		TEST_METHOD(Size_Hint_Is_Propagated_Through_Transformers)
+		{
+			std::vector<int> data(100);
+			auto even = [](int n) { return n % 2 == 0; };
+
+			Assert::IsTrue(has_hint(get_size_hint(data | map([](int n) { return n * 2.0; })), size_hint::exact, 100));
+			Assert::IsTrue(has_hint(get_size_hint(data | filter(even)), size_hint::upper_bound, 100));
+			Assert::IsTrue(has_hint(get_size_hint(data | take_while(even)), size_hint::upper_bound, 100));
+			Assert::IsTrue(has_hint(get_size_hint(data | drop_while(even)), size_hint::upper_bound, 100));
+			Assert::IsTrue(has_hint(get_size_hint(data | take(30)), size_hint::exact, 30));
+			Assert::IsTrue(has_hint(get_size_hint(data | take(300)), size_hint::exact, 100));
+			Assert::IsTrue(has_hint(get_size_hint(data | drop(30)), size_hint::exact, 70));
+			Assert::IsTrue(has_hint(get_size_hint(data | drop(300)), size_hint::exact, 0));
+			Assert::IsTrue(has_hint(get_size_hint(data | filter(even) | take(10) | map([](int n) { return n; })), size_hint::upper_bound, 10));
+		}
+
+		TEST_METHOD(Size_Hint_Is_Unknown_For_Collect)
+		{
+			std::vector<std::vector<int>> data(4, std::vector<int>(3));
+			auto collected = data | collect([](std::vector<int> const& d) { return d; });
+
+			Assert::IsTrue(has_hint(get_size_hint(collected), size_hint::unknown, 0));
+			Assert::IsTrue(has_hint(get_size_hint(collected | take(5)), size_hint::upper_bound, 5));
+		}
+	};
+}
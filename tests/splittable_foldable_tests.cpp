@@ -0,0 +1,171 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/reduce.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/collect.h>
+#include <wenda/reducers/executors/thread_pool.h>
+#include <wenda/reducers/executors/inline_executor.h>
+#include <wenda/reducers/executors/partitioners.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace splittables
+	{
+		/**
+        * A view over a part of a buffer, which is splittable through member functions.
+		*/
+		class buffer_view
+		{
+			int const* first;
+			int const* last;
+
+		public:
+			buffer_view(int const* first, int const* last)
+				: first(first), last(last)
+			{}
+
+			std::size_t size() const
+			{
+				return static_cast<std::size_t>(last - first);
+			}
+
+			std::pair<buffer_view, buffer_view> split() const
+			{
+				int const* middle = first + (last - first) / 2;
+				return std::make_pair(buffer_view(first, middle), buffer_view(middle, last));
+			}
+
+			template<typename Function, typename Seed>
+			Seed reduce(Function&& function, Seed seed) const
+			{
+				for (int const* it = first; it != last; ++it)
+				{
+					seed = function(std::move(seed), *it);
+				}
+
+				return seed;
+			}
+		};
+
+		/**
+        * An interval of integers, which is splittable through free functions.
+		*/
+		struct interval
+		{
+			long long low;
+			long long high;
+		};
+
+		inline std::size_t size(interval const& i)
+		{
+			return static_cast<std::size_t>(i.high - i.low);
+		}
+
+		inline std::pair<interval, interval> split(interval const& i)
+		{
+			long long middle = i.low + (i.high - i.low) / 2;
+			interval left = { i.low, middle };
+			interval right = { middle, i.high };
+			return std::make_pair(left, right);
+		}
+
+		template<typename Function, typename Seed>
+		Seed reduce(interval const& i, Function&& function, Seed seed)
+		{
+			for (long long n = i.low; n < i.high; ++n)
+			{
+				seed = function(std::move(seed), n);
+			}
+
+			return seed;
+		}
+	}
+
+	TEST_CLASS(SplittableFoldableTests)
+	{
+		TEST_METHOD(Splittable_Types_Are_Detected)
+		{
+			Assert::IsTrue(detail::is_splittable<splittables::buffer_view>::value);
+			Assert::IsTrue(detail::is_splittable<splittables::interval>::value);
+			Assert::IsFalse(detail::is_splittable<int>::value);
+		}
+
+		TEST_METHOD(Member_Splittable_Fold_Is_Correct)
+		{
+			thread_pool pool(4);
+			std::vector<int> data(100000, 1);
+			splittables::buffer_view view(data.data(), data.data() + data.size());
+
+			Assert::AreEqual(100000, view | fold<additive_monoid<int>>(pool));
+			Assert::AreEqual(100000, view | fold<additive_monoid<int>>());
+		}
+
+		TEST_METHOD(Free_Function_Splittable_Fold_Is_Correct)
+		{
+			thread_pool pool(3);
+			splittables::interval i = { 0, 100000 };
+
+			Assert::AreEqual(99999LL * 100000LL / 2, i | fold<additive_monoid<long long>>(pool));
+			Assert::AreEqual(99999LL * 100000LL / 2, i | fold<additive_monoid<long long>>(inline_executor()));
+		}
+
+		TEST_METHOD(Splittable_Fold_With_Transformers_Is_Correct)
+		{
+			thread_pool pool(4);
+			splittables::interval i = { 0, 10000 };
+
+			auto result =
+				i
+				| filter([](long long n) { return n % 2 == 0; })
+				| map([](long long n) { return n * 3; })
+				| fold<additive_monoid<long long>>(pool);
+
+			Assert::AreEqual(3 * 2 * (4999LL * 5000LL / 2), result);
+		}
+
+		TEST_METHOD(Splittable_Fold_In_Collect_Is_Correct)
+		{
+			thread_pool pool(4);
+			std::vector<long long> shards{ 0, 1, 2, 3 };
+
+			auto result =
+				shards
+				| collect([](long long shard) { splittables::interval i = { shard * 1000, (shard + 1) * 1000 }; return i; })
+				| fold<additive_monoid<long long>>(pool);
+
+			Assert::AreEqual(3999LL * 4000LL / 2, result);
+		}
+
+		TEST_METHOD(Splittable_Fold_With_Partitioners_Is_Correct)
+		{
+			thread_pool pool(4);
+			splittables::interval i = { 0, 100000 };
+
+			auto lazy = i | fold<additive_monoid<long long>>(with_partitioner(pool, lazy_partitioner(16)));
+			auto fixed = i | fold<additive_monoid<long long>>(with_partitioner(pool, fixed_partitioner(100)));
+			auto deterministic = i | fold<additive_monoid<long long>>(with_partitioner(inline_executor(), deterministic_partitioner(100)));
+
+			Assert::AreEqual(99999LL * 100000LL / 2, lazy);
+			Assert::AreEqual(99999LL * 100000LL / 2, fixed);
+			Assert::AreEqual(99999LL * 100000LL / 2, deterministic);
+		}
+
+		TEST_METHOD(Splittable_Fold_Of_Empty_Reducible_Is_Identity)
+		{
+			splittables::interval i = { 5, 5 };
+
+			Assert::AreEqual(0LL, i | fold<additive_monoid<long long>>());
+		}
+	};
+}
@@ -0,0 +1,189 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/transformers/take.h>
+#include <wenda/reducers/transformers/take_while.h>
+#include <wenda/reducers/transformers/map.h>
+#include <wenda/reducers/transformers/filter.h>
+#include <wenda/reducers/transformers/collect.h>
+#include <wenda/reducers/reducibles/range_reducible.h>
+#include <wenda/reducers/reducibles/sequence_reducible.h>
+#include <wenda/reducers/reduce.h>
+#include <wenda/reducers/fold.h>
+#include <wenda/reducers/monoid/monoid_fold.h>
+#include <wenda/reducers/executors/thread_pool.h>
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace
+	{
+		std::vector<int> push_back(std::vector<int> seed, int n)
+		{
+			seed.push_back(n);
+			return seed;
+		}
+	}
+
+	namespace generators
+	{
+		/**
+        * A reducible of the first integers, which reduces every element without checking whether the seed was reduced.
+		*/
+		struct first_integers
+		{
+			int count;
+		};
+
+		template<typename Function, typename Seed>
+		Seed reduce(first_integers const& reducible, Function&& function, Seed seed)
+		{
+			for (int n = 0; n < reducible.count; ++n)
+			{
+				seed = function(std::move(seed), n);
+			}
+
+			return seed;
+		}
+	}
+
+	TEST_CLASS(TakeReducibleTests)
+	{
+		TEST_METHOD(Take_Reduces_First_Elements)
+		{
+			std::vector<int> data{ 1, 2, 3, 4, 5, 6 };
+
+			auto result = take(make_range_reducible(data), 3) | reduce(std::plus<int>(), 0);
+
+			Assert::AreEqual(1 + 2 + 3, result);
+		}
+
+		TEST_METHOD(Take_Can_Be_Used_In_Pipe_Expression)
+		{
+			std::vector<int> data{ 1, 2, 3, 4, 5, 6 };
+
+			auto reducible = data | take(4);
+			auto result = reducible | reduce(std::plus<int>(), 0);
+			auto tooMany = data | take(100) | reduce(std::plus<int>(), 0);
+			auto none = data | take(0) | reduce(std::plus<int>(), 0);
+
+			Assert::AreEqual(1 + 2 + 3 + 4, result);
+			Assert::AreEqual(1 + 2 + 3 + 4 + 5 + 6, tooMany);
+			Assert::AreEqual(0, none);
+		}
+
+		TEST_METHOD(Take_Stops_The_Source)
+		{
+			int visited = 0;
+
+			auto result =
+				make_sequence_reducible(0, 1000000000, 1)
+				| map([&](int n) { ++visited; return n; })
+				| filter([](int n) { return n % 3 == 0; })
+				| take(5)
+				| reduce(push_back, std::vector<int>());
+
+			Assert::AreEqual(std::size_t(5), result.size());
+			Assert::AreEqual(12, result.back());
+			Assert::AreEqual(13, visited);
+		}
+
+		TEST_METHOD(Drop_Skips_First_Elements)
+		{
+			std::vector<int> data{ 1, 2, 3, 4, 5, 6 };
+
+			auto piped = data | drop(4) | reduce(std::plus<int>(), 0);
+			auto direct = drop(data, 10) | reduce(std::plus<int>(), 0);
+			auto window = data | drop(1) | take(2) | reduce(push_back, std::vector<int>());
+
+			Assert::AreEqual(5 + 6, piped);
+			Assert::AreEqual(0, direct);
+			Assert::IsTrue(std::vector<int>{ 2, 3 } == window);
+		}
+
+		TEST_METHOD(Take_While_Stops_At_First_Failure)
+		{
+			std::vector<int> data{ 1, 2, 3, 10, 4, 5 };
+			int visited = 0;
+
+			auto result =
+				data
+				| map([&](int n) { ++visited; return n; })
+				| take_while([](int n) { return n < 5; })
+				| reduce(std::plus<int>(), 0);
+			auto direct = take_while(data, [](int n) { return n > 5; }) | reduce(std::plus<int>(), 0);
+
+			Assert::AreEqual(1 + 2 + 3, result);
+			Assert::AreEqual(4, visited);
+			Assert::AreEqual(0, direct);
+		}
+
+		TEST_METHOD(Drop_While_Skips_Leading_Elements)
+		{
+			std::vector<int> data{ 1, 2, 3, 10, 4, 5 };
+
+			auto result = data | drop_while([](int n) { return n < 5; }) | reduce(push_back, std::vector<int>());
+			auto direct = drop_while(data, [](int n) { return n > 0; }) | reduce(std::plus<int>(), 0);
+
+			Assert::IsTrue(std::vector<int>{ 10, 4, 5 } == result);
+			Assert::AreEqual(0, direct);
+		}
+
+		TEST_METHOD(Take_Honours_Downstream_Termination)
+		{
+			std::vector<int> data{ 1, 2, 3, 4, 5, 6 };
+			int visited = 0;
+
+			auto result =
+				data
+				| map([&](int n) { ++visited; return n; })
+				| drop(1)
+				| take(4)
+				| reduce([](reduced<int> acc, int n) { return n == 3 ? make_reduced(n) : acc; }, reduced<int>(0));
+
+			Assert::IsTrue(result.is_reduced());
+			Assert::AreEqual(3, unreduced(result));
+			Assert::AreEqual(3, visited);
+		}
+
+		TEST_METHOD(Take_Ignores_Elements_From_Sources_That_Do_Not_Stop)
+		{
+			generators::first_integers source = { 10 };
+
+			auto taken = source | take(3) | reduce(push_back, std::vector<int>());
+			auto taken_while = source | take_while([](int n) { return n % 5 != 3; }) | reduce(push_back, std::vector<int>());
+			auto window = source | drop(2) | take(3) | reduce(push_back, std::vector<int>());
+			auto stopped =
+				source
+				| drop_while([](int n) { return n < 4; })
+				| reduce([](reduced<int> acc, int n) { return n == 6 ? make_reduced(n) : reduced<int>(acc.get() + 1); }, reduced<int>(0));
+
+			Assert::IsTrue(std::vector<int>{ 0, 1, 2 } == taken);
+			Assert::IsTrue(std::vector<int>{ 0, 1, 2 } == taken_while);
+			Assert::IsTrue(std::vector<int>{ 2, 3, 4 } == window);
+			Assert::AreEqual(6, unreduced(stopped));
+		}
+
+		TEST_METHOD(Take_Can_Be_Folded)
+		{
+			thread_pool pool(2);
+			std::vector<int> data{ 1, 2, 3, 4, 5, 6 };
+			std::vector<std::vector<int>> nested{ { 1, 2, 3 }, { 4, 5 } };
+
+			auto taken = data | take(2) | fold<additive_monoid<int>>();
+			auto dropped = data | drop_while([](int n) { return n < 6; }) | fold<additive_monoid<int>>(pool);
+			auto collected =
+				nested
+				| collect([](std::vector<int> const& v) { return v | take(1); })
+				| fold<additive_monoid<int>>(pool);
+
+			Assert::AreEqual(1 + 2, taken);
+			Assert::AreEqual(6, dropped);
+			Assert::AreEqual(1 + 4, collected);
+		}
+	};
+}
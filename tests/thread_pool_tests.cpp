@@ -0,0 +1,138 @@
+#include "stdafx.h"
+#include <CppUnitTest.h>
+
+#include <wenda/reducers/executors/thread_pool.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace WENDA_REDUCERS_NAMESPACE;
+
+namespace tests
+{
+	namespace
+	{
+		int parallel_fibonacci(thread_pool& pool, int n)
+		{
+			if (n < 2)
+			{
+				return n;
+			}
+
+			int left = 0;
+			int right = 0;
+
+			pool.invoke(
+				[&] { left = parallel_fibonacci(pool, n - 1); },
+				[&] { right = parallel_fibonacci(pool, n - 2); });
+
+			return left + right;
+		}
+	}
+
+	TEST_CLASS(ThreadPoolTests)
+	{
+		TEST_METHOD(ThreadPool_Has_Requested_Concurrency)
+		{
+			thread_pool pool(3);
+
+			Assert::AreEqual(std::size_t(3), pool.concurrency());
+		}
+
+		TEST_METHOD(ThreadPool_Run_Executes_On_Worker)
+		{
+			thread_pool pool(2);
+			bool onWorker = false;
+
+			pool.run([&] { onWorker = pool.is_worker(); });
+
+			Assert::IsTrue(onWorker);
+			Assert::IsFalse(pool.is_worker());
+		}
+
+		TEST_METHOD(ThreadPool_Invoke_Runs_Both_Functions)
+		{
+			thread_pool pool(4);
+			std::atomic<int> count(0);
+
+			pool.invoke([&] { ++count; }, [&] { ++count; });
+
+			Assert::AreEqual(2, count.load());
+		}
+
+		TEST_METHOD(ThreadPool_Supports_Nested_Invoke)
+		{
+			thread_pool pool(4);
+
+			auto result = parallel_fibonacci(pool, 20);
+
+			Assert::AreEqual(6765, result);
+		}
+
+		TEST_METHOD(ThreadPool_Join_Does_Not_Run_External_Submissions)
+		{
+			thread_pool pool(2);
+			std::atomic<bool> rightStarted(false);
+			std::atomic<bool> joining(false);
+			std::atomic<bool> otherDone(false);
+			std::thread::id joiner;
+			bool otherRanInJoin = false;
+			std::thread other;
+
+			pool.run([&]
+			{
+				joiner = std::this_thread::get_id();
+
+				pool.invoke(
+					[&]
+					{
+						while (!rightStarted)
+						{
+							std::this_thread::yield();
+						}
+
+						other = std::thread([&]
+						{
+							pool.run([&]
+							{
+								otherRanInJoin = joining && std::this_thread::get_id() == joiner;
+								otherDone = true;
+							});
+						});
+
+						joining = true;
+					},
+					[&]
+					{
+						rightStarted = true;
+
+						// keeps the other worker busy, so that the submission could only be taken by the joining worker.
+						auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+						while (!otherDone && std::chrono::steady_clock::now() < deadline)
+						{
+							std::this_thread::yield();
+						}
+					});
+
+				joining = false;
+			});
+
+			other.join();
+
+			Assert::IsFalse(otherRanInJoin);
+		}
+
+		TEST_METHOD(ThreadPool_Propagates_Exceptions)
+		{
+			thread_pool pool(2);
+
+			Assert::ExpectException<std::runtime_error>([&]
+			{
+				pool.invoke([] {}, [] { throw std::runtime_error("error"); });
+			});
+		}
+	};
+}